@@ -0,0 +1,73 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cmath>
+
+#include "common/bit_util.h"
+#include "common/latency_histogram.h"
+
+namespace Common {
+
+namespace {
+std::size_t BucketIndex(u64 ns) {
+    if (ns == 0) {
+        return 0;
+    }
+    return std::min<std::size_t>(MostSignificantBit64(ns), LatencySnapshot::NumBuckets - 1);
+}
+} // Anonymous namespace
+
+std::chrono::nanoseconds LatencySnapshot::Percentile(double percentile) const {
+    if (count == 0) {
+        return std::chrono::nanoseconds{0};
+    }
+
+    const auto target = std::max<u64>(
+        1, static_cast<u64>(std::ceil(static_cast<double>(count) * percentile / 100.0)));
+    u64 accumulated = 0;
+    for (std::size_t i = 0; i < NumBuckets; ++i) {
+        accumulated += buckets[i];
+        if (accumulated >= target) {
+            const u64 upper_bound = (u64{2} << i) - 1;
+            return std::chrono::nanoseconds{std::min(upper_bound, max_ns)};
+        }
+    }
+    return MaxTime();
+}
+
+void LatencyHistogram::Record(std::chrono::nanoseconds time) {
+    const auto ns = static_cast<u64>(std::max<s64>(time.count(), 0));
+
+    buckets[BucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    total_ns.fetch_add(ns, std::memory_order_relaxed);
+
+    u64 current_max = max_ns.load(std::memory_order_relaxed);
+    while (ns > current_max &&
+           !max_ns.compare_exchange_weak(current_max, ns, std::memory_order_relaxed)) {
+    }
+}
+
+LatencySnapshot LatencyHistogram::GetSnapshot() const {
+    LatencySnapshot snapshot;
+    for (std::size_t i = 0; i < buckets.size(); ++i) {
+        snapshot.buckets[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    snapshot.count = count.load(std::memory_order_relaxed);
+    snapshot.total_ns = total_ns.load(std::memory_order_relaxed);
+    snapshot.max_ns = max_ns.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void LatencyHistogram::Reset() {
+    for (auto& bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    total_ns.store(0, std::memory_order_relaxed);
+    max_ns.store(0, std::memory_order_relaxed);
+}
+
+} // namespace Common
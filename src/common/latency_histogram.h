@@ -0,0 +1,66 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Plain copy of the contents of a LatencyHistogram at one point in time.
+struct LatencySnapshot {
+    /// Bucket i counts samples in [2^i, 2^(i+1)) nanoseconds, bucket 0 also holds zero.
+    static constexpr std::size_t NumBuckets = 40;
+
+    std::array<u64, NumBuckets> buckets{};
+    u64 count = 0;
+    u64 total_ns = 0;
+    u64 max_ns = 0;
+
+    std::chrono::nanoseconds TotalTime() const {
+        return std::chrono::nanoseconds{total_ns};
+    }
+
+    std::chrono::nanoseconds MaxTime() const {
+        return std::chrono::nanoseconds{max_ns};
+    }
+
+    std::chrono::nanoseconds MeanTime() const {
+        return std::chrono::nanoseconds{count == 0 ? 0 : total_ns / count};
+    }
+
+    /**
+     * Estimates a percentile of the recorded samples.
+     * @param percentile Percentile to estimate, in the (0, 100] range.
+     * @returns The upper bound of the bucket holding the percentile, clamped to the maximum.
+     */
+    std::chrono::nanoseconds Percentile(double percentile) const;
+};
+
+/**
+ * Histogram of host latencies with power of two buckets. Recording is lock-free and wait-free, so
+ * it can stay enabled on hot paths and be fed from several host threads at once. Readers get a
+ * snapshot that may be torn between concurrent samples, which is fine for profiling.
+ */
+class LatencyHistogram {
+public:
+    void Record(std::chrono::nanoseconds time);
+
+    LatencySnapshot GetSnapshot() const;
+
+    void Reset();
+
+private:
+    std::array<std::atomic<u64>, LatencySnapshot::NumBuckets> buckets{};
+    std::atomic<u64> count{0};
+    std::atomic<u64> total_ns{0};
+    std::atomic<u64> max_ns{0};
+};
+
+} // namespace Common
@@ -54,4 +54,17 @@ std::vector<u8> CompressDataLZ4HCMax(const u8* source, std::size_t source_size);
  */
 std::vector<u8> DecompressDataLZ4(const std::vector<u8>& compressed, std::size_t uncompressed_size);
 
+/**
+ * Decompresses a source memory region with LZ4 directly into a caller-provided buffer.
+ *
+ * @param compressed the compressed source memory region.
+ * @param compressed_size the size in bytes of the compressed source memory region.
+ * @param destination the buffer to decompress into. Must hold at least uncompressed_size bytes.
+ * @param uncompressed_size the size in bytes of the uncompressed data.
+ *
+ * @return true if exactly uncompressed_size bytes were decompressed, false otherwise.
+ */
+bool DecompressDataLZ4(const u8* compressed, std::size_t compressed_size, u8* destination,
+                       std::size_t uncompressed_size);
+
 } // namespace Common::Compression
\ No newline at end of file
@@ -0,0 +1,76 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+
+#include "common/assert.h"
+#include "common/multi_level_page_table.h"
+
+namespace Common {
+
+MultiLevelPageTable::MultiLevelPageTable(std::size_t address_space_bits, std::size_t page_bits,
+                                         std::size_t second_level_bits)
+    : page_bits{page_bits}, second_level_bits{second_level_bits},
+      second_level_size{std::size_t{1} << second_level_bits},
+      second_level_mask{second_level_size - 1},
+      num_pages{std::size_t{1} << (address_space_bits - page_bits)} {
+    ASSERT(second_level_bits <= address_space_bits - page_bits);
+    const std::size_t first_level_size = num_pages >> second_level_bits;
+    first_level = std::make_unique<std::atomic<Entry*>[]>(first_level_size);
+    second_levels.resize(first_level_size);
+}
+
+MultiLevelPageTable::~MultiLevelPageTable() = default;
+
+void MultiLevelPageTable::Map(std::size_t first_page, std::size_t num_pages_to_map,
+                              u64 address) {
+    ASSERT(first_page + num_pages_to_map <= num_pages);
+
+    std::size_t page = first_page;
+    const std::size_t end = first_page + num_pages_to_map;
+    while (page != end) {
+        const std::size_t offset = page & second_level_mask;
+        const std::size_t count = std::min(end - page, second_level_size - offset);
+
+        Entry* const entries = GetOrAllocate(page >> second_level_bits) + offset;
+        for (std::size_t i = 0; i < count; ++i) {
+            entries[i].store(address + (static_cast<u64>(i) << page_bits),
+                             std::memory_order_relaxed);
+        }
+
+        page += count;
+        address += static_cast<u64>(count) << page_bits;
+    }
+}
+
+void MultiLevelPageTable::Unmap(std::size_t first_page, std::size_t num_pages_to_unmap) {
+    ASSERT(first_page + num_pages_to_unmap <= num_pages);
+
+    std::size_t page = first_page;
+    const std::size_t end = first_page + num_pages_to_unmap;
+    while (page != end) {
+        const std::size_t offset = page & second_level_mask;
+        const std::size_t count = std::min(end - page, second_level_size - offset);
+
+        // Pages without a second level table were never mapped
+        if (Entry* const entries = second_levels[page >> second_level_bits].get()) {
+            for (std::size_t i = offset; i < offset + count; ++i) {
+                entries[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        page += count;
+    }
+}
+
+MultiLevelPageTable::Entry* MultiLevelPageTable::GetOrAllocate(std::size_t index) {
+    auto& second_level = second_levels[index];
+    if (!second_level) {
+        second_level = std::make_unique<Entry[]>(second_level_size);
+        first_level[index].store(second_level.get(), std::memory_order_release);
+    }
+    return second_level.get();
+}
+
+} // namespace Common
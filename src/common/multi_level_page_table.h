@@ -0,0 +1,86 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Page table for sparsely used address spaces, split in two levels. The first level is an array
+ * of pointers to second level tables that each cover a fixed number of pages, which are only
+ * allocated once a page they cover gets mapped. This keeps the reserved memory proportional to
+ * the used part of the address space instead of its width.
+ *
+ * Every entry holds the address a page maps to, or zero when it is not mapped. Second level tables
+ * are never freed before the table itself is destroyed, which makes lookups lock-free: they may
+ * run on one thread while another one maps or unmaps pages. Map and Unmap have to be serialized
+ * by the caller.
+ */
+class MultiLevelPageTable final {
+public:
+    /**
+     * @param address_space_bits Width of the address space in bits.
+     * @param page_bits          Size of a page in bits.
+     * @param second_level_bits  Number of pages covered by each second level table, in bits.
+     */
+    explicit MultiLevelPageTable(std::size_t address_space_bits, std::size_t page_bits,
+                                 std::size_t second_level_bits);
+    ~MultiLevelPageTable();
+
+    MultiLevelPageTable(const MultiLevelPageTable&) = delete;
+    MultiLevelPageTable& operator=(const MultiLevelPageTable&) = delete;
+
+    /// Gets the address the given page maps to, or zero if it is not mapped.
+    u64 Get(std::size_t page) const {
+        const std::size_t index = page >> second_level_bits;
+        const Entry* const entries = first_level[index].load(std::memory_order_acquire);
+        if (entries == nullptr) {
+            return 0;
+        }
+        return entries[page & second_level_mask].load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Maps a range of pages to a contiguous range of addresses.
+     *
+     * @param first_page The index of the first page to map.
+     * @param num_pages  The number of pages to map.
+     * @param address    The address the first page maps to, following pages map to the next ones.
+     */
+    void Map(std::size_t first_page, std::size_t num_pages, u64 address);
+
+    /// Unmaps a range of pages.
+    void Unmap(std::size_t first_page, std::size_t num_pages);
+
+    /// Gets the number of pages in the address space.
+    std::size_t GetNumPages() const {
+        return num_pages;
+    }
+
+private:
+    using Entry = std::atomic<u64>;
+
+    /// Gets the second level table at the given index, allocating it when it does not exist yet.
+    Entry* GetOrAllocate(std::size_t index);
+
+    std::size_t page_bits;
+    std::size_t second_level_bits;
+    std::size_t second_level_size;
+    std::size_t second_level_mask;
+    std::size_t num_pages;
+
+    std::unique_ptr<std::atomic<Entry*>[]> first_level;
+
+    /// Owners of the allocated second level tables, only touched when mapping pages.
+    std::vector<std::unique_ptr<Entry[]>> second_levels;
+};
+
+} // namespace Common
@@ -7,6 +7,7 @@
 #include <array>
 #include <iterator>
 #include <list>
+#include <tuple>
 #include <utility>
 
 #include "common/bit_util.h"
@@ -70,7 +71,12 @@ public:
 
             if (it == GetEndItForPrio()) {
                 u64 prios = mlq.used_priorities;
-                prios &= ~((1ULL << (current_priority + 1)) - 1);
+                // Shifting by 64 is undefined, there is no priority after the last one anyway
+                if (current_priority + 1 >= 64) {
+                    prios = 0;
+                } else {
+                    prios &= ~((1ULL << (current_priority + 1)) - 1);
+                }
                 if (prios == 0) {
                     current_priority = static_cast<u32>(mlq.depth());
                 } else {
@@ -189,34 +195,46 @@ public:
         adjust(*it, old_priority, new_priority, adjust_front);
     }
 
-    void transfer_to_front(const T& element, u32 priority, MultiLevelQueue& other) {
-        ListSplice(other.levels[priority], other.levels[priority].begin(), levels[priority],
-                   ListIterateTo(levels[priority], element));
+    /// Moves an element into another queue without reallocating it.
+    /// @returns false if the element was not present in this queue.
+    bool transfer_to_front(const T& element, u32 priority, MultiLevelQueue& other) {
+        const auto it = ListIterateTo(levels[priority], element);
+        if (it == levels[priority].end()) {
+            return false;
+        }
+        ListSplice(other.levels[priority], other.levels[priority].begin(), levels[priority], it);
 
         other.used_priorities |= 1ULL << priority;
 
         if (levels[priority].empty()) {
             used_priorities &= ~(1ULL << priority);
         }
+        return true;
     }
 
-    void transfer_to_front(const_iterator it, u32 priority, MultiLevelQueue& other) {
-        transfer_to_front(*it, priority, other);
+    bool transfer_to_front(const_iterator it, u32 priority, MultiLevelQueue& other) {
+        return transfer_to_front(*it, priority, other);
     }
 
-    void transfer_to_back(const T& element, u32 priority, MultiLevelQueue& other) {
-        ListSplice(other.levels[priority], other.levels[priority].end(), levels[priority],
-                   ListIterateTo(levels[priority], element));
+    /// Moves an element into another queue without reallocating it.
+    /// @returns false if the element was not present in this queue.
+    bool transfer_to_back(const T& element, u32 priority, MultiLevelQueue& other) {
+        const auto it = ListIterateTo(levels[priority], element);
+        if (it == levels[priority].end()) {
+            return false;
+        }
+        ListSplice(other.levels[priority], other.levels[priority].end(), levels[priority], it);
 
         other.used_priorities |= 1ULL << priority;
 
         if (levels[priority].empty()) {
             used_priorities &= ~(1ULL << priority);
         }
+        return true;
     }
 
-    void transfer_to_back(const_iterator it, u32 priority, MultiLevelQueue& other) {
-        transfer_to_back(*it, priority, other);
+    bool transfer_to_back(const_iterator it, u32 priority, MultiLevelQueue& other) {
+        return transfer_to_back(*it, priority, other);
     }
 
     void yield(u32 priority, std::size_t n = 1) {
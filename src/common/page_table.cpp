@@ -22,4 +22,14 @@ void PageTable::Resize(std::size_t address_space_width_in_bits, std::size_t page
     }
 }
 
+void PageTable::FillRange(std::size_t first_page, std::size_t num_pages, u8* pointer,
+                          u64 backing, PageType type) {
+    pointers.Fill(first_page, num_pages, pointer);
+    backing_addr.Fill(first_page, num_pages, backing);
+
+    if (attributes.size() != 0) {
+        attributes.Fill(first_page, num_pages, type);
+    }
+}
+
 } // namespace Common
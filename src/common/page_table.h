@@ -62,6 +62,20 @@ struct PageTable {
     void Resize(std::size_t address_space_width_in_bits, std::size_t page_size_in_bits,
                 bool has_attribute);
 
+    /**
+     * Sets the entries of a range of pages to the same values. As every array is stored
+     * separately, this boils down to one contiguous fill per array instead of a strided store per
+     * page.
+     *
+     * @param first_page The index of the first page to update.
+     * @param num_pages  The number of pages to update.
+     * @param pointer    The value to store in `pointers`.
+     * @param backing    The value to store in `backing_addr`.
+     * @param type       The value to store in `attributes`, if the table has attributes.
+     */
+    void FillRange(std::size_t first_page, std::size_t num_pages, u8* pointer, u64 backing,
+                   PageType type);
+
     /**
      * Vector of memory pointers backing each page. An entry can only be non-null if the
      * corresponding entry in the `attributes` vector is of type `Memory`.
@@ -0,0 +1,86 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace Common {
+
+/**
+ * Non-owning view over a contiguous sequence of objects, a subset of C++20's std::span.
+ * Used to hand buffers around without copying them into a container first.
+ */
+template <typename T>
+class Span {
+public:
+    using element_type = T;
+    using value_type = std::remove_cv_t<T>;
+    using size_type = std::size_t;
+    using pointer = T*;
+    using reference = T&;
+    using iterator = T*;
+
+    constexpr Span() noexcept = default;
+
+    constexpr Span(T* data, std::size_t size) noexcept : ptr{data}, count{size} {}
+
+    /// Views any container that exposes contiguous storage through data() and size().
+    template <typename Container,
+              typename = std::enable_if_t<!std::is_same_v<std::decay_t<Container>, Span> &&
+                                          std::is_convertible_v<
+                                              decltype(std::declval<Container&>().data()), T*>>>
+    constexpr Span(Container& container) noexcept
+        : ptr{container.data()}, count{container.size()} {}
+
+    /// Allows converting a view over mutable objects into a view over const objects.
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept : ptr{other.data()}, count{other.size()} {}
+
+    constexpr T* data() const noexcept {
+        return ptr;
+    }
+
+    constexpr std::size_t size() const noexcept {
+        return count;
+    }
+
+    constexpr std::size_t size_bytes() const noexcept {
+        return count * sizeof(T);
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return count == 0;
+    }
+
+    constexpr T& operator[](std::size_t index) const noexcept {
+        return ptr[index];
+    }
+
+    constexpr iterator begin() const noexcept {
+        return ptr;
+    }
+
+    constexpr iterator end() const noexcept {
+        return ptr + count;
+    }
+
+    /// Returns a view over the count objects starting at offset.
+    constexpr Span subspan(std::size_t offset, std::size_t sub_count) const noexcept {
+        return Span(ptr + offset, sub_count);
+    }
+
+    /// Returns a view over the objects from offset to the end.
+    constexpr Span subspan(std::size_t offset) const noexcept {
+        return Span(ptr + offset, count - offset);
+    }
+
+private:
+    T* ptr{};
+    std::size_t count{};
+};
+
+} // namespace Common
@@ -0,0 +1,77 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <thread>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define SPIN_LOCK_HAS_PAUSE
+#include <immintrin.h>
+#endif
+
+#include "common/assert.h"
+#include "common/spin_lock.h"
+
+namespace {
+
+/// Number of busy-wait iterations before a waiter starts giving up its time slice.
+constexpr u32 SpinsBeforeYield = 128;
+
+void ThreadPause() {
+#if defined(SPIN_LOCK_HAS_PAUSE)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+} // Anonymous namespace
+
+namespace Common {
+
+void SpinLock::lock() {
+    const u32 ticket = next_ticket.fetch_add(1, std::memory_order_relaxed);
+    u32 spins = 0;
+    while (now_serving.load(std::memory_order_acquire) != ticket) {
+        if (++spins < SpinsBeforeYield) {
+            ThreadPause();
+        } else {
+            // There are more contenders than host cores, let the owner run.
+            std::this_thread::yield();
+        }
+    }
+}
+
+void SpinLock::unlock() {
+    now_serving.store(now_serving.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+bool SpinLock::try_lock() {
+    u32 ticket = now_serving.load(std::memory_order_acquire);
+    return next_ticket.compare_exchange_strong(ticket, ticket + 1, std::memory_order_acquire,
+                                               std::memory_order_relaxed);
+}
+
+void RecursiveSpinLock::lock(u64 owner) {
+    ASSERT(owner != NoOwner);
+    // Only the owner itself can have stored its id, so a relaxed load is enough to detect
+    // recursion: any other value observed means the lock is not ours.
+    if (IsLockedBy(owner)) {
+        ++depth;
+        return;
+    }
+    inner_lock.lock();
+    current_owner.store(owner, std::memory_order_relaxed);
+    depth = 1;
+}
+
+void RecursiveSpinLock::unlock() {
+    ASSERT(depth > 0);
+    if (--depth != 0) {
+        return;
+    }
+    current_owner.store(NoOwner, std::memory_order_relaxed);
+    inner_lock.unlock();
+}
+
+} // namespace Common
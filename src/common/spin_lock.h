@@ -0,0 +1,57 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * Ticket based spin lock. Waiters are served in the order they arrived, so a core hammering the
+ * lock can not starve the others, which a plain test-and-set lock does not guarantee.
+ * Satisfies Lockable, so it can be used with std::scoped_lock and friends.
+ */
+class SpinLock {
+public:
+    void lock();
+    void unlock();
+    [[nodiscard]] bool try_lock();
+
+private:
+    std::atomic<u32> next_ticket{0};
+    std::atomic<u32> now_serving{0};
+};
+
+/**
+ * Recursive variant of SpinLock, owned by an opaque owner id supplied by the caller (for instance
+ * a host thread id combined with the running guest thread handle).
+ */
+class RecursiveSpinLock {
+public:
+    /// Value that no owner may use, represents an unlocked lock.
+    static constexpr u64 NoOwner = ~u64{0};
+
+    void lock(u64 owner);
+    void unlock();
+
+    /// Returns true if the lock is currently held by the given owner.
+    bool IsLockedBy(u64 owner) const {
+        return current_owner.load(std::memory_order_relaxed) == owner;
+    }
+
+    /// Returns the recursion depth of the lock, only meaningful to the current owner.
+    u32 GetDepth() const {
+        return depth;
+    }
+
+private:
+    SpinLock inner_lock;
+    std::atomic<u64> current_owner{NoOwner};
+    u32 depth = 0;
+};
+
+} // namespace Common
@@ -0,0 +1,201 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <deque>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/thread.h"
+#include "common/thread_pool.h"
+
+// Worker utilization shows up as the time spent in this scope on each worker thread. The bundled
+// microprofile has no counter or gauge API, so the ratio itself is only reported by GetStats().
+MICROPROFILE_DEFINE(ThreadPool_Task, "ThreadPool", "Task", MP_RGB(96, 160, 224));
+
+namespace Common {
+
+struct ThreadPool::Worker {
+    std::mutex mutex;
+    std::array<std::deque<std::function<void()>>, NumPriorities> queues;
+    std::thread thread;
+};
+
+double ThreadPoolStats::Utilization() const {
+    const auto available = elapsed_time * num_workers;
+    if (available.count() <= 0) {
+        return 0.0;
+    }
+    return std::min(1.0, static_cast<double>(busy_time.count()) /
+                             static_cast<double>(available.count()));
+}
+
+ThreadPool::ThreadPool(std::string name_, std::size_t num_workers)
+    : name{std::move(name_)}, start_time{std::chrono::steady_clock::now()} {
+    num_workers = std::max<std::size_t>(num_workers, 1);
+    workers.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        workers.push_back(std::make_unique<Worker>());
+    }
+    // Workers steal from each other, so all of them have to exist before the first one starts
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        workers[i]->thread = std::thread(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::scoped_lock lock{sleep_mutex};
+        stop_requested = true;
+    }
+    work_available.notify_all();
+    for (auto& worker : workers) {
+        worker->thread.join();
+    }
+
+    const ThreadPoolStats stats = GetStats();
+    LOG_DEBUG(Common, "{}: {} tasks ({} stolen) on {} workers, {:.1f}% utilization", name,
+              stats.tasks_executed, stats.tasks_stolen, stats.num_workers,
+              stats.Utilization() * 100.0);
+}
+
+void ThreadPool::Submit(std::function<void()> task, TaskPriority priority,
+                        std::size_t preferred_worker) {
+    if (preferred_worker == AnyWorker) {
+        preferred_worker = next_worker.fetch_add(1, std::memory_order_relaxed);
+    }
+    Worker& worker = *workers[preferred_worker % workers.size()];
+    {
+        std::scoped_lock lock{worker.mutex};
+        worker.queues[static_cast<std::size_t>(priority)].push_back(std::move(task));
+    }
+    {
+        // Incremented with the lock held, so a worker can't miss it between checking the counter
+        // and going to sleep
+        std::scoped_lock lock{sleep_mutex};
+        ++num_pending;
+    }
+    work_available.notify_one();
+}
+
+void ThreadPool::ParallelFor(std::size_t count, std::size_t grain_size,
+                             const std::function<void(std::size_t, std::size_t)>& func,
+                             TaskPriority priority) {
+    if (count == 0) {
+        return;
+    }
+    grain_size = std::max<std::size_t>(grain_size, 1);
+    const std::size_t num_chunks = (count + grain_size - 1) / grain_size;
+    if (num_chunks == 1) {
+        func(0, count);
+        return;
+    }
+
+    // Shared with the helper tasks, as they may only start after this call has returned. By then
+    // all chunks have been taken and they return without touching func.
+    struct State {
+        std::atomic<std::size_t> next_chunk{0};
+        std::atomic<std::size_t> num_done{0};
+        std::mutex mutex;
+        std::condition_variable done;
+    };
+    const auto state = std::make_shared<State>();
+    const auto run_chunks = [state, &func, count, grain_size, num_chunks] {
+        std::size_t num_completed = 0;
+        for (std::size_t chunk = state->next_chunk++; chunk < num_chunks;
+             chunk = state->next_chunk++) {
+            const std::size_t begin = chunk * grain_size;
+            func(begin, std::min(begin + grain_size, count));
+            ++num_completed;
+        }
+        if (num_completed != 0 && state->num_done.fetch_add(num_completed) + num_completed ==
+                                      num_chunks) {
+            std::scoped_lock lock{state->mutex};
+            state->done.notify_all();
+        }
+    };
+
+    const std::size_t num_helpers = std::min(workers.size(), num_chunks - 1);
+    for (std::size_t i = 0; i < num_helpers; ++i) {
+        Submit(run_chunks, priority);
+    }
+    run_chunks();
+
+    std::unique_lock lock{state->mutex};
+    state->done.wait(lock, [&] { return state->num_done == num_chunks; });
+}
+
+ThreadPoolStats ThreadPool::GetStats() const {
+    ThreadPoolStats stats;
+    stats.num_workers = workers.size();
+    stats.tasks_executed = tasks_executed.load(std::memory_order_relaxed);
+    stats.tasks_stolen = tasks_stolen.load(std::memory_order_relaxed);
+    stats.busy_time = std::chrono::nanoseconds{busy_ns.load(std::memory_order_relaxed)};
+    stats.elapsed_time = std::chrono::steady_clock::now() - start_time;
+    return stats;
+}
+
+void ThreadPool::WorkerLoop(std::size_t index) {
+    const std::string thread_name = fmt::format("yuzu:{}:{}", name, index);
+    MicroProfileOnThreadCreate(thread_name.c_str());
+    SetCurrentThreadName(thread_name.c_str());
+
+    std::function<void()> task;
+    while (true) {
+        if (TryPop(index, task)) {
+            RunTask(task);
+            task = nullptr;
+            continue;
+        }
+        std::unique_lock lock{sleep_mutex};
+        work_available.wait(lock, [this] { return stop_requested || num_pending != 0; });
+        // Queued tasks are still run on shutdown, someone may be waiting on their result
+        if (num_pending == 0) {
+            break;
+        }
+    }
+    MicroProfileOnThreadExit();
+}
+
+bool ThreadPool::TryPop(std::size_t index, std::function<void()>& task) {
+    const std::size_t num_workers = workers.size();
+    for (std::size_t priority = 0; priority < NumPriorities; ++priority) {
+        for (std::size_t offset = 0; offset < num_workers; ++offset) {
+            Worker& worker = *workers[(index + offset) % num_workers];
+            std::scoped_lock lock{worker.mutex};
+            auto& queue = worker.queues[priority];
+            if (queue.empty()) {
+                continue;
+            }
+            // Steal from the back, so the owner keeps running its tasks in submission order
+            if (offset != 0) {
+                task = std::move(queue.back());
+                queue.pop_back();
+                tasks_stolen.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                task = std::move(queue.front());
+                queue.pop_front();
+            }
+            --num_pending;
+            return true;
+        }
+    }
+    return false;
+}
+
+void ThreadPool::RunTask(const std::function<void()>& task) {
+    MICROPROFILE_SCOPE(ThreadPool_Task);
+    const auto start = std::chrono::steady_clock::now();
+    task();
+    const auto time = std::chrono::steady_clock::now() - start;
+
+    busy_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(time).count(),
+                      std::memory_order_relaxed);
+    tasks_executed.fetch_add(1, std::memory_order_relaxed);
+}
+
+} // namespace Common
@@ -0,0 +1,143 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "common/common_types.h"
+
+namespace Common {
+
+/// Order in which queued tasks are picked up, tasks of the same priority run in submission order.
+enum class TaskPriority : u32 {
+    High,   ///< Work another thread is waiting on
+    Normal, ///< Work whose result is needed soon
+    Low,    ///< Background work
+};
+
+/// Counters of a ThreadPool since it was created.
+struct ThreadPoolStats {
+    std::size_t num_workers = 0;
+    u64 tasks_executed = 0;
+    /// Tasks that ran on a different worker than the one they were queued on.
+    u64 tasks_stolen = 0;
+    /// Time spent by all workers running tasks.
+    std::chrono::nanoseconds busy_time{};
+    /// Time since the pool was created.
+    std::chrono::nanoseconds elapsed_time{};
+
+    /// Returns the fraction of the available worker time spent running tasks, in [0, 1].
+    double Utilization() const;
+};
+
+/**
+ * Pool of worker threads shared by subsystems that have parallel work, so that they don't
+ * oversubscribe the host with threads of their own. Each worker has its own queue, and idle
+ * workers steal from the queues of the others.
+ */
+class ThreadPool {
+public:
+    /// Affinity hint for tasks that can be picked up by any worker first.
+    static constexpr std::size_t AnyWorker = std::numeric_limits<std::size_t>::max();
+
+    /**
+     * Starts the worker threads.
+     * @param name        Name given to the worker threads, shown in debuggers and microprofile.
+     * @param num_workers Number of worker threads, at least one is always created.
+     */
+    explicit ThreadPool(std::string name, std::size_t num_workers);
+
+    /// Runs the tasks that are still queued and joins the worker threads.
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Returns the number of worker threads.
+    std::size_t NumWorkers() const {
+        return workers.size();
+    }
+
+    /**
+     * Queues a task.
+     * @param task             Task to run on a worker thread.
+     * @param priority         Priority of the task among the queued ones.
+     * @param preferred_worker Worker the task is queued on, wrapped around the number of workers.
+     *                         Tasks sharing a hint tend to run on the same thread, but they can
+     *                         still be stolen by idle workers.
+     */
+    void Submit(std::function<void()> task, TaskPriority priority = TaskPriority::Normal,
+                std::size_t preferred_worker = AnyWorker);
+
+    /**
+     * Queues a task and returns a future holding its result.
+     * @note Waiting on the future from a worker thread can deadlock when all workers are waiting.
+     */
+    template <typename Func>
+    std::future<std::invoke_result_t<Func>> Async(Func&& func,
+                                                  TaskPriority priority = TaskPriority::Normal,
+                                                  std::size_t preferred_worker = AnyWorker) {
+        using Result = std::invoke_result_t<Func>;
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        auto future = task->get_future();
+        Submit([task = std::move(task)] { (*task)(); }, priority, preferred_worker);
+        return future;
+    }
+
+    /**
+     * Splits [0, count) into chunks of grain_size elements and runs func(begin, end) on each of
+     * them. The calling thread runs chunks too, so it is safe to call this from a worker thread.
+     * Blocks until all chunks have run.
+     */
+    void ParallelFor(std::size_t count, std::size_t grain_size,
+                     const std::function<void(std::size_t, std::size_t)>& func,
+                     TaskPriority priority = TaskPriority::High);
+
+    /// Returns the counters of the pool, the values may be torn between concurrent tasks.
+    ThreadPoolStats GetStats() const;
+
+private:
+    static constexpr std::size_t NumPriorities = 3;
+
+    struct Worker;
+
+    void WorkerLoop(std::size_t index);
+
+    /// Pops the next task for the given worker, from its own queue or from another worker.
+    bool TryPop(std::size_t index, std::function<void()>& task);
+
+    void RunTask(const std::function<void()>& task);
+
+    const std::string name;
+    const std::chrono::steady_clock::time_point start_time;
+
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<std::size_t> next_worker{0};
+
+    std::mutex sleep_mutex;
+    std::condition_variable work_available;
+    /// Number of queued tasks, only incremented with sleep_mutex held.
+    std::atomic<std::size_t> num_pending{0};
+    bool stop_requested = false;
+
+    std::atomic<u64> tasks_executed{0};
+    std::atomic<u64> tasks_stolen{0};
+    std::atomic<u64> busy_ns{0};
+};
+
+} // namespace Common
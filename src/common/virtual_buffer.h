@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "common/common_funcs.h"
 
 namespace Common {
@@ -38,6 +40,11 @@ public:
         return base_ptr[index];
     }
 
+    /// Sets `count` consecutive elements starting at `index` to the given value.
+    void Fill(std::size_t index, std::size_t count, const T& value) {
+        std::fill_n(base_ptr + index, count, value);
+    }
+
     constexpr T* data() {
         return base_ptr;
     }
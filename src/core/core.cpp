@@ -40,6 +40,7 @@
 #include "core/hle/service/lm/manager.h"
 #include "core/hle/service/service.h"
 #include "core/hle/service/sm/sm.h"
+#include "core/hle_profiler.h"
 #include "core/loader/loader.h"
 #include "core/memory.h"
 #include "core/memory/cheat_engine.h"
@@ -167,6 +168,9 @@ struct System::Impl {
         telemetry_session = std::make_unique<Core::TelemetrySession>();
         service_manager = std::make_shared<Service::SM::ServiceManager>();
 
+        // Start profiling the new session from scratch
+        hle_profiler.Reset();
+
         Service::Init(service_manager, system);
         GDBStub::DeferStart();
 
@@ -382,6 +386,10 @@ struct System::Impl {
 
     std::unique_ptr<Core::PerfStats> perf_stats;
     Core::FrameLimiter frame_limiter;
+
+    /// Latencies of SVCs and HLE service commands, kept across sessions so they can be dumped
+    /// after shutdown
+    Core::HLEProfiler hle_profiler;
 };
 
 System::System() : impl{std::make_unique<Impl>(*this)} {}
@@ -570,6 +578,14 @@ const Core::PerfStats& System::GetPerfStats() const {
     return *impl->perf_stats;
 }
 
+Core::HLEProfiler& System::GetHLEProfiler() {
+    return impl->hle_profiler;
+}
+
+const Core::HLEProfiler& System::GetHLEProfiler() const {
+    return impl->hle_profiler;
+}
+
 Core::FrameLimiter& System::FrameLimiter() {
     return impl->frame_limiter;
 }
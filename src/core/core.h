@@ -94,6 +94,7 @@ class CoreManager;
 class DeviceMemory;
 class ExclusiveMonitor;
 class FrameLimiter;
+class HLEProfiler;
 class PerfStats;
 class Reporter;
 class TelemetrySession;
@@ -293,6 +294,12 @@ public:
     /// Provides a constant reference to the internal PerfStats instance.
     const Core::PerfStats& GetPerfStats() const;
 
+    /// Provides a reference to the SVC and HLE service command profiler.
+    Core::HLEProfiler& GetHLEProfiler();
+
+    /// Provides a constant reference to the SVC and HLE service command profiler.
+    const Core::HLEProfiler& GetHLEProfiler() const;
+
     /// Provides a reference to the frame limiter;
     Core::FrameLimiter& FrameLimiter();
 
@@ -5,6 +5,7 @@
 #include "core/core_timing.h"
 
 #include <algorithm>
+#include <limits>
 #include <mutex>
 #include <string>
 #include <tuple>
@@ -13,11 +14,20 @@
 #include "common/thread.h"
 #include "core/core_timing_util.h"
 #include "core/hardware_properties.h"
+#include "core/hle/lock.h"
 
 namespace Core::Timing {
 
 constexpr int MAX_SLICE_LENGTH = 10000;
 
+namespace {
+/// Context of host threads that don't emulate a core, like service threads and the GPU thread.
+constexpr u64 NoContext = std::numeric_limits<u64>::max();
+
+/// The core the calling host thread is currently emulating.
+thread_local u64 current_context = NoContext;
+} // Anonymous namespace
+
 std::shared_ptr<EventType> CreateEvent(std::string name, TimedCallback&& callback) {
     return std::make_shared<EventType>(std::move(callback), std::move(name));
 }
@@ -48,13 +58,14 @@ void CoreTiming::Initialize() {
     slice_length = MAX_SLICE_LENGTH;
     global_timer = 0;
     idled_cycles = 0;
-    current_context = 0;
+    accumulated_ticks.fill(0);
+    current_context = NoContext;
 
     // The time between CoreTiming being initialized and the first call to Advance() is considered
     // the slice boundary between slice -1 and slice 0. Dispatcher loops must call Advance() before
     // executing the first cycle of each slice to prepare the slice length and downcount for
     // that slice.
-    is_global_timer_sane = true;
+    is_global_timer_sane.fill(true);
 
     event_fifo_id = 0;
 
@@ -72,7 +83,7 @@ void CoreTiming::ScheduleEvent(s64 cycles_into_future, const std::shared_ptr<Eve
     const s64 timeout = GetTicks() + cycles_into_future;
 
     // If this event needs to be scheduled before the next advance(), force one early
-    if (!is_global_timer_sane) {
+    if (current_context != NoContext && !is_global_timer_sane[current_context]) {
         ForceExceptionCheck(cycles_into_future);
     }
 
@@ -96,19 +107,21 @@ void CoreTiming::UnscheduleEvent(const std::shared_ptr<EventType>& event_type, u
 }
 
 u64 CoreTiming::GetTicks() const {
-    u64 ticks = static_cast<u64>(global_timer);
-    if (!is_global_timer_sane) {
-        ticks += accumulated_ticks;
+    u64 ticks = static_cast<u64>(global_timer.load());
+    // The ticks of the running slice belong to the core's own thread, they are only added up in
+    // global_timer once the core advances.
+    if (current_context != NoContext && !is_global_timer_sane[current_context]) {
+        ticks += accumulated_ticks[current_context];
     }
     return ticks;
 }
 
 u64 CoreTiming::GetIdleTicks() const {
-    return static_cast<u64>(idled_cycles);
+    return static_cast<u64>(idled_cycles.load());
 }
 
 void CoreTiming::AddTicks(u64 ticks) {
-    accumulated_ticks += ticks;
+    accumulated_ticks[current_context] += ticks;
     downcounts[current_context] -= static_cast<s64>(ticks);
 }
 
@@ -132,7 +145,7 @@ void CoreTiming::RemoveEvent(const std::shared_ptr<EventType>& event_type) {
 
 void CoreTiming::ForceExceptionCheck(s64 cycles) {
     cycles = std::max<s64>(0, cycles);
-    if (downcounts[current_context] <= cycles) {
+    if (current_context == NoContext || downcounts[current_context] <= cycles) {
         return;
     }
 
@@ -156,13 +169,15 @@ std::optional<u64> CoreTiming::NextAvailableCore(const s64 needed_ticks) const {
 }
 
 void CoreTiming::Advance() {
+    const u64 context = current_context;
+    std::scoped_lock event_guard{event_mutex};
     std::unique_lock<std::mutex> guard(inner_mutex);
 
-    const u64 cycles_executed = accumulated_ticks;
-    time_slice[current_context] = std::max<s64>(0, time_slice[current_context] - accumulated_ticks);
+    const u64 cycles_executed = accumulated_ticks[context];
+    time_slice[context] = std::max<s64>(0, time_slice[context] - cycles_executed);
     global_timer += cycles_executed;
 
-    is_global_timer_sane = true;
+    is_global_timer_sane[context] = true;
 
     while (!event_queue.empty() && event_queue.front().time <= global_timer) {
         Event evt = std::move(event_queue.front());
@@ -171,46 +186,54 @@ void CoreTiming::Advance() {
         inner_mutex.unlock();
 
         if (auto event_type{evt.type.lock()}) {
+            // Callbacks modify kernel and service state, which the other cores only touch from
+            // SVCs while holding the HLE lock.
+            std::lock_guard hle_guard{HLE::g_hle_lock};
             event_type->callback(evt.userdata, global_timer - evt.time);
         }
 
         inner_mutex.lock();
     }
 
-    is_global_timer_sane = false;
+    is_global_timer_sane[context] = false;
+
+    accumulated_ticks[context] = 0;
+    downcounts[context] = time_slice[context];
 
     // Still events left (scheduled in the future)
     if (!event_queue.empty()) {
         const s64 needed_ticks =
             std::min<s64>(event_queue.front().time - global_timer, MAX_SLICE_LENGTH);
-        const auto next_core = NextAvailableCore(needed_ticks);
-        if (next_core) {
+        if (is_multicore) {
+            // All cores run at once, so each one stops at the next event on its own.
+            downcounts[context] = std::min(downcounts[context], needed_ticks);
+        } else if (const auto next_core = NextAvailableCore(needed_ticks)) {
             downcounts[*next_core] = needed_ticks;
         }
     }
-
-    accumulated_ticks = 0;
-
-    downcounts[current_context] = time_slice[current_context];
 }
 
 void CoreTiming::ResetRun() {
     downcounts.fill(MAX_SLICE_LENGTH);
     time_slice.fill(MAX_SLICE_LENGTH);
-    current_context = 0;
     // Still events left (scheduled in the future)
     if (!event_queue.empty()) {
         const s64 needed_ticks =
             std::min<s64>(event_queue.front().time - global_timer, MAX_SLICE_LENGTH);
-        downcounts[current_context] = needed_ticks;
+        if (is_multicore) {
+            downcounts.fill(needed_ticks);
+        } else {
+            // The round-robin run starts with the first core.
+            downcounts[0] = needed_ticks;
+        }
     }
 
-    is_global_timer_sane = false;
-    accumulated_ticks = 0;
+    is_global_timer_sane.fill(false);
+    accumulated_ticks.fill(0);
 }
 
 void CoreTiming::Idle() {
-    accumulated_ticks += downcounts[current_context];
+    accumulated_ticks[current_context] += downcounts[current_context];
     idled_cycles += downcounts[current_context];
     downcounts[current_context] = 0;
 }
@@ -223,4 +246,16 @@ s64 CoreTiming::GetDowncount() const {
     return downcounts[current_context];
 }
 
+void CoreTiming::SwitchContext(u64 new_context) {
+    current_context = new_context;
+}
+
+bool CoreTiming::CanCurrentContextRun() const {
+    return time_slice[current_context] > 0;
+}
+
+void CoreTiming::SetMulticore(bool enabled) {
+    is_multicore = enabled;
+}
+
 } // namespace Core::Timing
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <functional>
 #include <memory>
@@ -75,8 +77,8 @@ public:
 
     void ForceExceptionCheck(s64 cycles);
 
-    /// This should only be called from the emu thread, if you are calling it any other thread,
-    /// you are doing something evil
+    /// Returns the emulated time in ticks. On a CPU core thread this includes the ticks of its
+    /// running slice, other host threads get the time at which the cores last advanced.
     u64 GetTicks() const;
 
     u64 GetIdleTicks() const;
@@ -99,12 +101,21 @@ public:
 
     s64 GetDowncount() const;
 
-    void SwitchContext(u64 new_context) {
-        current_context = new_context;
-    }
+    /// Selects the core whose downcount and slice the calling host thread operates on. The
+    /// context is tracked per host thread, so in multicore mode each CPU thread sets it once.
+    /// Host threads that never select a core don't touch the per-core state, so only threads that
+    /// did may run slices with AddTicks, Advance and Idle.
+    void SwitchContext(u64 new_context);
+
+    bool CanCurrentContextRun() const;
 
-    bool CanCurrentContextRun() const {
-        return time_slice[current_context] > 0;
+    /// Enables multicore mode, where every core runs concurrently on its own host thread. Each
+    /// core then bounds its own downcount by the next pending event, instead of the next event
+    /// being handed to a single core as in the deterministic round-robin mode.
+    void SetMulticore(bool enabled);
+
+    bool IsMulticore() const {
+        return is_multicore;
     }
 
     std::optional<u64> NextAvailableCore(const s64 needed_ticks) const;
@@ -117,19 +128,21 @@ private:
 
     static constexpr u64 num_cpu_cores = 4;
 
-    s64 global_timer = 0;
-    s64 idled_cycles = 0;
+    std::atomic<s64> global_timer = 0;
+    std::atomic<s64> idled_cycles = 0;
     s64 slice_length = 0;
-    u64 accumulated_ticks = 0;
+    // Each core only touches its own entry of the per-core arrays, so these need no locking.
+    std::array<u64, num_cpu_cores> accumulated_ticks{};
     std::array<s64, num_cpu_cores> downcounts{};
     // Slice of time assigned to each core per run.
     std::array<s64, num_cpu_cores> time_slice{};
-    u64 current_context = 0;
 
     // Are we in a function that has been called from Advance()
     // If events are scheduled from a function that gets called from Advance(),
     // don't change slice_length and downcount.
-    bool is_global_timer_sane = false;
+    std::array<bool, num_cpu_cores> is_global_timer_sane{};
+
+    bool is_multicore = false;
 
     // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
     // We don't use std::priority_queue because we need to be able to serialize, unserialize and
@@ -141,6 +154,8 @@ private:
     std::shared_ptr<EventType> ev_lost;
 
     std::mutex inner_mutex;
+    // Serializes event callbacks when several cores call Advance() concurrently.
+    std::mutex event_mutex;
 };
 
 /// Creates a core timing event with the given name and callback.
@@ -2,15 +2,26 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <fmt/format.h>
+
+#include "common/logging/log.h"
+#include "common/microprofile.h"
+#include "common/thread.h"
 #include "core/arm/exclusive_monitor.h"
 #include "core/core.h"
 #include "core/core_manager.h"
 #include "core/core_timing.h"
 #include "core/cpu_manager.h"
 #include "core/gdbstub/gdbstub.h"
+#include "core/settings.h"
 
 namespace Core {
 
+namespace {
+/// Index of the core owned by the calling host thread, only used in multicore mode.
+thread_local std::size_t host_thread_core = 0;
+} // Anonymous namespace
+
 CpuManager::CpuManager(System& system) : system{system} {}
 CpuManager::~CpuManager() = default;
 
@@ -18,9 +29,39 @@ void CpuManager::Initialize() {
     for (std::size_t index = 0; index < core_managers.size(); ++index) {
         core_managers[index] = std::make_unique<CoreManager>(system, index);
     }
+
+    is_multicore = Settings::values.use_multi_core;
+#ifndef ARCHITECTURE_x86_64
+    if (is_multicore) {
+        // The Unicorn fallback has no exclusive monitor shared between cores.
+        LOG_WARNING(Core, "Multicore requires Dynarmic, falling back to a single host thread");
+        is_multicore = false;
+    }
+#endif
+    if (is_multicore && !Settings::values.use_asynchronous_gpu_emulation) {
+        // Core timing events may end up running GPU work on any core thread, which only works
+        // when the GPU has its own thread and rendering context.
+        LOG_WARNING(Core, "Multicore requires asynchronous GPU emulation, falling back to a single "
+                          "host thread");
+        is_multicore = false;
+    }
+    if (is_multicore && Settings::values.use_gdbstub) {
+        LOG_WARNING(Core, "Multicore is not supported with the GDB stub, falling back to a "
+                          "single host thread");
+        is_multicore = false;
+    }
+
+    system.CoreTiming().SetMulticore(is_multicore);
+    if (is_multicore) {
+        StartCoreThreads();
+    }
 }
 
 void CpuManager::Shutdown() {
+    if (is_multicore) {
+        StopCoreThreads();
+    }
+
     for (auto& cpu_core : core_managers) {
         cpu_core.reset();
     }
@@ -35,16 +76,30 @@ const CoreManager& CpuManager::GetCoreManager(std::size_t index) const {
 }
 
 CoreManager& CpuManager::GetCurrentCoreManager() {
-    // Otherwise, use single-threaded mode active_core variable
-    return *core_managers[active_core];
+    return *core_managers[GetActiveCoreIndex()];
 }
 
 const CoreManager& CpuManager::GetCurrentCoreManager() const {
+    return *core_managers[GetActiveCoreIndex()];
+}
+
+std::size_t CpuManager::GetActiveCoreIndex() const {
+    if (is_multicore) {
+        return host_thread_core;
+    }
     // Otherwise, use single-threaded mode active_core variable
-    return *core_managers[active_core];
+    return active_core;
 }
 
 void CpuManager::RunLoop(bool tight_loop) {
+    if (is_multicore) {
+        RunLoopMulticore(tight_loop);
+    } else {
+        RunLoopSingleThread(tight_loop);
+    }
+}
+
+void CpuManager::RunLoopSingleThread(bool tight_loop) {
     if (GDBStub::IsServerEnabled()) {
         GDBStub::HandlePacket();
 
@@ -78,4 +133,92 @@ void CpuManager::RunLoop(bool tight_loop) {
     }
 }
 
+void CpuManager::RunLoopMulticore(bool tight_loop) {
+    // The core threads are all parked at this point, so the slices can be reset safely.
+    system.CoreTiming().ResetRun();
+
+    {
+        std::scoped_lock lock{slice_mutex};
+        slice_tight_loop = tight_loop;
+        cores_finished = 0;
+        ++slice_generation;
+    }
+    slice_started.notify_all();
+
+    std::unique_lock lock{slice_mutex};
+    slice_finished.wait(lock, [this] { return cores_finished == core_threads.size(); });
+}
+
+void CpuManager::RunCoreThread(std::size_t core_index) {
+    const std::string name = fmt::format("yuzu:CPUCore_{}", core_index);
+    MicroProfileOnThreadCreate(name.c_str());
+    Common::SetCurrentThreadName(name.c_str());
+
+    host_thread_core = core_index;
+    system.RegisterCoreThread(core_index);
+
+    auto& core_timing = system.CoreTiming();
+    core_timing.SwitchContext(core_index);
+
+    {
+        std::scoped_lock lock{slice_mutex};
+        ++cores_finished;
+    }
+    slice_finished.notify_one();
+
+    u64 last_generation = 0;
+    while (true) {
+        bool tight_loop{};
+        {
+            std::unique_lock lock{slice_mutex};
+            slice_started.wait(lock, [this, last_generation] {
+                return stop_core_threads || slice_generation != last_generation;
+            });
+            if (stop_core_threads) {
+                return;
+            }
+            last_generation = slice_generation;
+            tight_loop = slice_tight_loop;
+        }
+
+        while (core_timing.CanCurrentContextRun()) {
+            core_managers[core_index]->RunLoop(tight_loop);
+        }
+
+        {
+            std::scoped_lock lock{slice_mutex};
+            ++cores_finished;
+        }
+        slice_finished.notify_one();
+    }
+}
+
+void CpuManager::StartCoreThreads() {
+    stop_core_threads = false;
+    slice_generation = 0;
+    cores_finished = 0;
+    for (std::size_t index = 0; index < core_threads.size(); ++index) {
+        core_threads[index] = std::thread(&CpuManager::RunCoreThread, this, index);
+    }
+
+    // Wait for every thread to register itself with the kernel before any guest code runs, as
+    // the kernel looks up host thread ids without locking.
+    std::unique_lock lock{slice_mutex};
+    slice_finished.wait(lock, [this] { return cores_finished == core_threads.size(); });
+}
+
+void CpuManager::StopCoreThreads() {
+    {
+        std::scoped_lock lock{slice_mutex};
+        stop_core_threads = true;
+    }
+    slice_started.notify_all();
+
+    for (auto& thread : core_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+}
+
 } // namespace Core
@@ -5,7 +5,11 @@
 #pragma once
 
 #include <array>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
+#include "common/common_types.h"
 #include "core/hardware_properties.h"
 
 namespace Core {
@@ -33,16 +37,42 @@ public:
     CoreManager& GetCurrentCoreManager();
     const CoreManager& GetCurrentCoreManager() const;
 
-    std::size_t GetActiveCoreIndex() const {
-        return active_core;
+    /// Returns the core emulated by the calling thread. In multicore mode this is the core owned
+    /// by the calling host thread, otherwise it is the core currently being round-robined.
+    std::size_t GetActiveCoreIndex() const;
+
+    bool IsMulticore() const {
+        return is_multicore;
     }
 
     void RunLoop(bool tight_loop);
 
 private:
+    void RunLoopSingleThread(bool tight_loop);
+    void RunLoopMulticore(bool tight_loop);
+
+    /// Entry point of the host thread that runs a single core in multicore mode.
+    void RunCoreThread(std::size_t core_index);
+
+    void StartCoreThreads();
+    void StopCoreThreads();
+
     std::array<std::unique_ptr<CoreManager>, Hardware::NUM_CPU_CORES> core_managers;
     std::size_t active_core{}; ///< Active core, only used in single thread mode
 
+    bool is_multicore{};
+    std::array<std::thread, Hardware::NUM_CPU_CORES> core_threads;
+
+    // Each RunLoop call in multicore mode runs one timing slice on every core thread at once and
+    // waits for all of them to finish it before returning.
+    std::mutex slice_mutex;
+    std::condition_variable slice_started;
+    std::condition_variable slice_finished;
+    u64 slice_generation{};
+    std::size_t cores_finished{};
+    bool slice_tight_loop{};
+    bool stop_core_threads{};
+
     System& system;
 };
 
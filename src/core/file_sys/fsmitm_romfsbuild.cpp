@@ -22,13 +22,20 @@
  * Refer to the license.txt file included.
  */
 
+#include <algorithm>
 #include <cstring>
+#include <numeric>
 #include <string_view>
+#include <type_traits>
+#include <fmt/format.h>
 #include "common/alignment.h"
 #include "common/assert.h"
+#include "common/cityhash.h"
+#include "common/logging/log.h"
 #include "core/file_sys/fsmitm_romfsbuild.h"
 #include "core/file_sys/ips_layer.h"
 #include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_offset.h"
 #include "core/file_sys/vfs_vector.h"
 
 namespace FileSys {
@@ -38,6 +45,13 @@ constexpr u64 FS_MAX_PATH = 0x301;
 constexpr u32 ROMFS_ENTRY_EMPTY = 0xFFFFFFFF;
 constexpr u32 ROMFS_FILEPARTITION_OFS = 0x200;
 
+// Bump whenever the layout of the generated metadata changes to invalidate stale cache entries.
+constexpr u64 ROMFS_CACHE_VERSION = 1;
+// Least recently used cache entries are deleted once all of them together exceed this size.
+constexpr u64 ROMFS_CACHE_MAX_SIZE = 0x8000000;
+// Lists the names of the cache entries, most recently used first.
+constexpr std::string_view ROMFS_CACHE_INDEX = "index";
+
 // Types for building a RomFS.
 struct RomFSHeader {
     u64 header_size;
@@ -73,28 +87,27 @@ struct RomFSFileEntry {
 };
 static_assert(sizeof(RomFSFileEntry) == 0x20, "RomFSFileEntry has incorrect size.");
 
-struct RomFSBuildFileContext;
-
+// Links between contexts are indices into the flat directory/file arrays of the build context.
 struct RomFSBuildDirectoryContext {
-    std::string path;
+    u32 path_ofs = 0;
     u32 cur_path_ofs = 0;
     u32 path_len = 0;
     u32 entry_offset = 0;
-    std::shared_ptr<RomFSBuildDirectoryContext> parent;
-    std::shared_ptr<RomFSBuildDirectoryContext> child;
-    std::shared_ptr<RomFSBuildDirectoryContext> sibling;
-    std::shared_ptr<RomFSBuildFileContext> file;
+    u32 parent = 0;
+    u32 child = ROMFS_ENTRY_EMPTY;
+    u32 sibling = ROMFS_ENTRY_EMPTY;
+    u32 file = ROMFS_ENTRY_EMPTY;
 };
 
 struct RomFSBuildFileContext {
-    std::string path;
+    u32 path_ofs = 0;
     u32 cur_path_ofs = 0;
     u32 path_len = 0;
     u32 entry_offset = 0;
+    u32 parent = 0;
+    u32 sibling = ROMFS_ENTRY_EMPTY;
     u64 offset = 0;
     u64 size = 0;
-    std::shared_ptr<RomFSBuildDirectoryContext> parent;
-    std::shared_ptr<RomFSBuildFileContext> sibling;
     VirtualFile source;
 };
 
@@ -126,232 +139,352 @@ static u64 romfs_get_hash_table_count(u64 num_entries) {
     return count;
 }
 
-void RomFSBuildContext::VisitDirectory(VirtualDir root_romfs, VirtualDir ext,
-                                       std::shared_ptr<RomFSBuildDirectoryContext> parent) {
-    std::vector<std::shared_ptr<RomFSBuildDirectoryContext>> child_dirs;
+template <typename Context>
+static u64 romfs_get_entry_size(const Context& ctx) {
+    using Entry = std::conditional_t<std::is_same_v<Context, RomFSBuildFileContext>,
+                                     RomFSFileEntry, RomFSDirectoryEntry>;
+    return sizeof(Entry) + Common::AlignUp(ctx.path_len - ctx.cur_path_ofs, 4);
+}
 
-    VirtualDir dir;
+std::string_view RomFSBuildContext::GetPath(u32 offset, u32 length) const {
+    return std::string_view(path_pool).substr(offset, length);
+}
 
-    if (parent->path_len == 0)
-        dir = root_romfs;
-    else
-        dir = root_romfs->GetDirectoryRelative(parent->path);
+void RomFSBuildContext::VisitDirectory(const VirtualDir& dir, const VirtualDir& ext_dir,
+                                       u32 parent) {
+    const auto dir_files = dir->GetFiles();
+
+    // Only the first subdirectory of a given name is visited.
+    std::vector<std::pair<std::string, VirtualDir>> subdirs;
+    for (auto& subdir : dir->GetSubdirectories()) {
+        auto name = subdir->GetName();
+        if (std::find_if(subdirs.begin(), subdirs.end(), [&name](const auto& entry) {
+                return entry.first == name;
+            }) == subdirs.end()) {
+            subdirs.emplace_back(std::move(name), std::move(subdir));
+        }
+    }
 
-    const auto entries = dir->GetEntries();
+    // A file sharing its name with a directory is shadowed by the directory.
+    std::vector<std::string_view> subdir_names;
+    subdir_names.reserve(subdirs.size());
+    for (const auto& entry : subdirs) {
+        subdir_names.push_back(entry.first);
+    }
+    std::sort(subdir_names.begin(), subdir_names.end());
 
-    for (const auto& kv : entries) {
-        if (kv.second == VfsEntryType::Directory) {
-            const auto child = std::make_shared<RomFSBuildDirectoryContext>();
-            // Set child's path.
-            child->cur_path_ofs = parent->path_len + 1;
-            child->path_len = child->cur_path_ofs + static_cast<u32>(kv.first.size());
-            child->path = parent->path + "/" + kv.first;
+    for (const auto& file : dir_files) {
+        const auto name = file->GetName();
+        if (std::binary_search(subdir_names.begin(), subdir_names.end(), name))
+            continue;
 
-            if (ext != nullptr && ext->GetFileRelative(child->path + ".stub") != nullptr)
-                continue;
+        if (ext_dir != nullptr && ext_dir->GetFile(name + ".stub") != nullptr)
+            continue;
 
-            // Sanity check on path_len
-            ASSERT(child->path_len < FS_MAX_PATH);
+        VirtualFile source = file;
+        if (ext_dir != nullptr) {
+            const auto ips = ext_dir->GetFile(name + ".ips");
 
-            if (AddDirectory(parent, child)) {
-                child_dirs.push_back(child);
+            if (ips != nullptr) {
+                auto patched = PatchIPS(source, ips);
+                if (patched != nullptr)
+                    source = std::move(patched);
             }
-        } else {
-            const auto child = std::make_shared<RomFSBuildFileContext>();
-            // Set child's path.
-            child->cur_path_ofs = parent->path_len + 1;
-            child->path_len = child->cur_path_ofs + static_cast<u32>(kv.first.size());
-            child->path = parent->path + "/" + kv.first;
+        }
 
-            if (ext != nullptr && ext->GetFileRelative(child->path + ".stub") != nullptr)
-                continue;
+        AddFile(parent, name, std::move(source));
+    }
 
-            // Sanity check on path_len
-            ASSERT(child->path_len < FS_MAX_PATH);
+    for (const auto& [name, subdir] : subdirs) {
+        if (ext_dir != nullptr && ext_dir->GetFile(name + ".stub") != nullptr)
+            continue;
 
-            child->source = root_romfs->GetFileRelative(child->path);
+        const auto child = AddDirectory(parent, name);
+        const auto child_ext = ext_dir == nullptr ? nullptr : ext_dir->GetSubdirectory(name);
+        VisitDirectory(subdir, child_ext, child);
+    }
+}
 
-            if (ext != nullptr) {
-                const auto ips = ext->GetFileRelative(child->path + ".ips");
+template <typename Context>
+static Context MakeChildContext(std::string& path_pool, const RomFSBuildDirectoryContext& parent,
+                                u32 parent_index, std::string_view name) {
+    Context child{};
+    child.path_ofs = static_cast<u32>(path_pool.size());
+    child.cur_path_ofs = parent.path_len + 1;
+    child.path_len = child.cur_path_ofs + static_cast<u32>(name.size());
+    child.parent = parent_index;
+
+    // Sanity check on path_len
+    ASSERT(child.path_len < FS_MAX_PATH);
+
+    // Set child's path, which is the parent's path followed by a separator and the name.
+    path_pool.resize(path_pool.size() + child.path_len);
+    char* const dest = path_pool.data() + child.path_ofs;
+    std::memcpy(dest, path_pool.data() + parent.path_ofs, parent.path_len);
+    dest[parent.path_len] = '/';
+    std::memcpy(dest + child.cur_path_ofs, name.data(), name.size());
+
+    return child;
+}
 
-                if (ips != nullptr) {
-                    auto patched = PatchIPS(child->source, ips);
-                    if (patched != nullptr)
-                        child->source = std::move(patched);
-                }
-            }
+u32 RomFSBuildContext::AddDirectory(u32 parent, std::string_view name) {
+    const auto index = static_cast<u32>(directories.size());
+    directories.push_back(MakeChildContext<RomFSBuildDirectoryContext>(
+        path_pool, directories[parent], parent, name));
+    return index;
+}
 
-            child->size = child->source->GetSize();
+u32 RomFSBuildContext::AddFile(u32 parent, std::string_view name, VirtualFile source) {
+    const auto index = static_cast<u32>(files.size());
+    auto& file = files.emplace_back(
+        MakeChildContext<RomFSBuildFileContext>(path_pool, directories[parent], parent, name));
+    file.size = source->GetSize();
+    file.source = std::move(source);
+    return index;
+}
 
-            AddFile(parent, child);
+template <typename Context>
+static std::vector<u32> SortAndDeduplicate(std::vector<Context>& entries,
+                                           const std::string& path_pool) {
+    const auto get_path = [&path_pool](const Context& ctx) {
+        return std::string_view(path_pool).substr(ctx.path_ofs, ctx.path_len);
+    };
+
+    std::vector<u32> order(entries.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](u32 lhs, u32 rhs) {
+        return get_path(entries[lhs]) < get_path(entries[rhs]);
+    });
+
+    // The first entry added for a given path wins, matching the layer priority.
+    std::vector<u32> remap(entries.size());
+    std::vector<Context> sorted;
+    sorted.reserve(entries.size());
+    for (const auto index : order) {
+        if (!sorted.empty() && get_path(sorted.back()) == get_path(entries[index])) {
+            remap[index] = static_cast<u32>(sorted.size() - 1);
+            continue;
         }
-    }
 
-    for (auto& child : child_dirs) {
-        this->VisitDirectory(root_romfs, ext, child);
+        remap[index] = static_cast<u32>(sorted.size());
+        sorted.push_back(std::move(entries[index]));
     }
+
+    entries = std::move(sorted);
+    return remap;
 }
 
-bool RomFSBuildContext::AddDirectory(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                                     std::shared_ptr<RomFSBuildDirectoryContext> dir_ctx) {
-    // Check whether it's already in the known directories.
-    const auto existing = directories.find(dir_ctx->path);
-    if (existing != directories.end())
-        return false;
-
-    // Add a new directory.
-    num_dirs++;
-    dir_table_size +=
-        sizeof(RomFSDirectoryEntry) + Common::AlignUp(dir_ctx->path_len - dir_ctx->cur_path_ofs, 4);
-    dir_ctx->parent = parent_dir_ctx;
-    directories.emplace(dir_ctx->path, dir_ctx);
-
-    return true;
+void RomFSBuildContext::SortEntries() {
+    // The root has the empty path and thus always remains at index zero.
+    const auto dir_remap = SortAndDeduplicate(directories, path_pool);
+    for (auto& dir : directories) {
+        dir.parent = dir_remap[dir.parent];
+    }
+
+    SortAndDeduplicate(files, path_pool);
+    for (auto& file : files) {
+        file.parent = dir_remap[file.parent];
+    }
 }
 
-bool RomFSBuildContext::AddFile(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                                std::shared_ptr<RomFSBuildFileContext> file_ctx) {
-    // Check whether it's already in the known files.
-    const auto existing = files.find(file_ctx->path);
-    if (existing != files.end()) {
-        return false;
+// Moves the given entry to the front of the cache index and deletes the least recently used
+// entries that don't fit in the size limit anymore. The most recent entry is always kept.
+static void UpdateCacheIndex(const VirtualDir& cache, std::string_view used_name) {
+    std::vector<std::string> names{std::string(used_name)};
+    if (const auto index = cache->GetFile(ROMFS_CACHE_INDEX); index != nullptr) {
+        const auto data = index->ReadAllBytes();
+        std::string_view remaining{reinterpret_cast<const char*>(data.data()), data.size()};
+        while (!remaining.empty()) {
+            const auto end = std::min(remaining.find('\n'), remaining.size());
+            const auto name = remaining.substr(0, end);
+            if (!name.empty() && name != used_name) {
+                names.emplace_back(name);
+            }
+            remaining.remove_prefix(std::min(end + 1, remaining.size()));
+        }
+    }
+    // Entries missing from the index are treated as the oldest ones.
+    for (const auto& file : cache->GetFiles()) {
+        const auto name = file->GetName();
+        if (name != ROMFS_CACHE_INDEX &&
+            std::find(names.begin(), names.end(), name) == names.end()) {
+            names.push_back(name);
+        }
+    }
+
+    std::string contents;
+    u64 total_size = 0;
+    for (const auto& name : names) {
+        const auto file = cache->GetFile(name);
+        if (file == nullptr) {
+            continue;
+        }
+        total_size += file->GetSize();
+        if (total_size > ROMFS_CACHE_MAX_SIZE && name != used_name && cache->DeleteFile(name)) {
+            LOG_DEBUG(Service_FS, "Evicted RomFS metadata cache {}", name);
+            continue;
+        }
+        contents += name;
+        contents += '\n';
     }
 
-    // Add a new file.
-    num_files++;
-    file_table_size +=
-        sizeof(RomFSFileEntry) + Common::AlignUp(file_ctx->path_len - file_ctx->cur_path_ofs, 4);
-    file_ctx->parent = parent_dir_ctx;
-    files.emplace(file_ctx->path, file_ctx);
+    const auto index = cache->CreateFile(ROMFS_CACHE_INDEX);
+    if (index == nullptr || !index->Resize(contents.size()) ||
+        index->WriteBytes(contents.data(), contents.size()) != contents.size()) {
+        LOG_WARNING(Service_FS, "Failed to write RomFS metadata cache index");
+    }
+}
 
-    return true;
+u64 RomFSBuildContext::CalculateCacheKey() const {
+    // The metadata tables only depend on the entry paths and file sizes.
+    u64 key = ROMFS_CACHE_VERSION;
+    for (const auto& dir : directories) {
+        key = Common::CityHash64WithSeed(path_pool.data() + dir.path_ofs, dir.path_len, key);
+    }
+    key = Common::CityHash64WithSeed("", 0, key ^ num_dirs);
+    for (const auto& file : files) {
+        key = Common::CityHash64WithSeed(path_pool.data() + file.path_ofs, file.path_len,
+                                         key ^ file.size);
+    }
+    return key;
 }
 
-RomFSBuildContext::RomFSBuildContext(VirtualDir base_, VirtualDir ext_)
-    : base(std::move(base_)), ext(std::move(ext_)) {
-    root = std::make_shared<RomFSBuildDirectoryContext>();
-    root->path = "\0";
-    directories.emplace(root->path, root);
-    num_dirs = 1;
-    dir_table_size = 0x18;
+RomFSBuildContext::RomFSBuildContext(VirtualDir base_, VirtualDir ext_, VirtualDir cache_)
+    : base(std::move(base_)), ext(std::move(ext_)), cache(std::move(cache_)) {
+    directories.emplace_back();
+
+    VisitDirectory(base, ext, 0);
+    SortEntries();
 
-    VisitDirectory(base, ext, root);
+    num_dirs = directories.size();
+    num_files = files.size();
+    for (const auto& dir : directories) {
+        dir_table_size += romfs_get_entry_size(dir);
+    }
+    for (const auto& file : files) {
+        file_table_size += romfs_get_entry_size(file);
+    }
 }
 
 RomFSBuildContext::~RomFSBuildContext() = default;
 
-std::map<u64, VirtualFile> RomFSBuildContext::Build() {
-    const u64 dir_hash_table_entry_count = romfs_get_hash_table_count(num_dirs);
-    const u64 file_hash_table_entry_count = romfs_get_hash_table_count(num_files);
-    dir_hash_table_size = 4 * dir_hash_table_entry_count;
-    file_hash_table_size = 4 * file_hash_table_entry_count;
-
-    // Assign metadata pointers
-    RomFSHeader header{};
+std::vector<u8> RomFSBuildContext::BuildMetadata() {
+    const u64 dir_hash_table_entry_count = dir_hash_table_size / sizeof(u32);
+    const u64 file_hash_table_entry_count = file_hash_table_size / sizeof(u32);
 
     std::vector<u32> dir_hash_table(dir_hash_table_entry_count, ROMFS_ENTRY_EMPTY);
     std::vector<u32> file_hash_table(file_hash_table_entry_count, ROMFS_ENTRY_EMPTY);
 
-    std::vector<u8> dir_table(dir_table_size);
-    std::vector<u8> file_table(file_table_size);
-
-    std::shared_ptr<RomFSBuildFileContext> cur_file;
-
-    // Determine file offsets.
-    u32 entry_offset = 0;
-    std::shared_ptr<RomFSBuildFileContext> prev_file = nullptr;
-    for (const auto& it : files) {
-        cur_file = it.second;
-        file_partition_size = Common::AlignUp(file_partition_size, 16);
-        cur_file->offset = file_partition_size;
-        file_partition_size += cur_file->size;
-        cur_file->entry_offset = entry_offset;
-        entry_offset += sizeof(RomFSFileEntry) +
-                        Common::AlignUp(cur_file->path_len - cur_file->cur_path_ofs, 4);
-        prev_file = cur_file;
-    }
-    // Assign deferred parent/sibling ownership.
-    for (auto it = files.rbegin(); it != files.rend(); ++it) {
-        cur_file = it->second;
-        cur_file->sibling = cur_file->parent->file;
-        cur_file->parent->file = cur_file;
-    }
-
-    std::shared_ptr<RomFSBuildDirectoryContext> cur_dir;
-
-    // Determine directory offsets.
-    entry_offset = 0;
-    for (const auto& it : directories) {
-        cur_dir = it.second;
-        cur_dir->entry_offset = entry_offset;
-        entry_offset += sizeof(RomFSDirectoryEntry) +
-                        Common::AlignUp(cur_dir->path_len - cur_dir->cur_path_ofs, 4);
+    // The tables are laid out back to back, starting with the directory hash table.
+    const u64 dir_table_ofs = dir_hash_table_size;
+    const u64 file_hash_table_ofs = dir_table_ofs + dir_table_size;
+    const u64 file_table_ofs = file_hash_table_ofs + file_hash_table_size;
+    std::vector<u8> metadata(file_table_ofs + file_table_size);
+    u8* const dir_table = metadata.data() + dir_table_ofs;
+    u8* const file_table = metadata.data() + file_table_ofs;
+
+    // Assign deferred parent/sibling links.
+    for (std::size_t i = files.size(); i-- > 0;) {
+        auto& cur_file = files[i];
+        cur_file.sibling = directories[cur_file.parent].file;
+        directories[cur_file.parent].file = static_cast<u32>(i);
     }
-    // Assign deferred parent/sibling ownership.
-    for (auto it = directories.rbegin(); it->second != root; ++it) {
-        cur_dir = it->second;
-        cur_dir->sibling = cur_dir->parent->child;
-        cur_dir->parent->child = cur_dir;
+    for (std::size_t i = directories.size(); i-- > 1;) {
+        auto& cur_dir = directories[i];
+        cur_dir.sibling = directories[cur_dir.parent].child;
+        directories[cur_dir.parent].child = static_cast<u32>(i);
     }
 
-    std::map<u64, VirtualFile> out;
-
     // Populate file tables.
-    for (const auto& it : files) {
-        cur_file = it.second;
+    for (const auto& cur_file : files) {
+        const auto& parent = directories[cur_file.parent];
         RomFSFileEntry cur_entry{};
 
-        cur_entry.parent = cur_file->parent->entry_offset;
-        cur_entry.sibling =
-            cur_file->sibling == nullptr ? ROMFS_ENTRY_EMPTY : cur_file->sibling->entry_offset;
-        cur_entry.offset = cur_file->offset;
-        cur_entry.size = cur_file->size;
-
-        const auto name_size = cur_file->path_len - cur_file->cur_path_ofs;
-        const auto hash = romfs_calc_path_hash(cur_file->parent->entry_offset, cur_file->path,
-                                               cur_file->cur_path_ofs, name_size);
+        cur_entry.parent = parent.entry_offset;
+        cur_entry.sibling = cur_file.sibling == ROMFS_ENTRY_EMPTY
+                                ? ROMFS_ENTRY_EMPTY
+                                : files[cur_file.sibling].entry_offset;
+        cur_entry.offset = cur_file.offset;
+        cur_entry.size = cur_file.size;
+
+        const auto path = GetPath(cur_file.path_ofs, cur_file.path_len);
+        const auto name_size = cur_file.path_len - cur_file.cur_path_ofs;
+        const auto hash =
+            romfs_calc_path_hash(parent.entry_offset, path, cur_file.cur_path_ofs, name_size);
         cur_entry.hash = file_hash_table[hash % file_hash_table_entry_count];
-        file_hash_table[hash % file_hash_table_entry_count] = cur_file->entry_offset;
+        file_hash_table[hash % file_hash_table_entry_count] = cur_file.entry_offset;
 
         cur_entry.name_size = name_size;
 
-        out.emplace(cur_file->offset + ROMFS_FILEPARTITION_OFS, cur_file->source);
-        std::memcpy(file_table.data() + cur_file->entry_offset, &cur_entry, sizeof(RomFSFileEntry));
-        std::memset(file_table.data() + cur_file->entry_offset + sizeof(RomFSFileEntry), 0,
-                    Common::AlignUp(cur_entry.name_size, 4));
-        std::memcpy(file_table.data() + cur_file->entry_offset + sizeof(RomFSFileEntry),
-                    cur_file->path.data() + cur_file->cur_path_ofs, name_size);
+        std::memcpy(file_table + cur_file.entry_offset, &cur_entry, sizeof(RomFSFileEntry));
+        std::memcpy(file_table + cur_file.entry_offset + sizeof(RomFSFileEntry),
+                    path.data() + cur_file.cur_path_ofs, name_size);
     }
 
     // Populate dir tables.
-    for (const auto& it : directories) {
-        cur_dir = it.second;
+    for (std::size_t i = 0; i < directories.size(); ++i) {
+        const auto& cur_dir = directories[i];
+        const bool is_root = i == 0;
         RomFSDirectoryEntry cur_entry{};
 
-        cur_entry.parent = cur_dir == root ? 0 : cur_dir->parent->entry_offset;
-        cur_entry.sibling =
-            cur_dir->sibling == nullptr ? ROMFS_ENTRY_EMPTY : cur_dir->sibling->entry_offset;
-        cur_entry.child =
-            cur_dir->child == nullptr ? ROMFS_ENTRY_EMPTY : cur_dir->child->entry_offset;
-        cur_entry.file = cur_dir->file == nullptr ? ROMFS_ENTRY_EMPTY : cur_dir->file->entry_offset;
-
-        const auto name_size = cur_dir->path_len - cur_dir->cur_path_ofs;
-        const auto hash = romfs_calc_path_hash(cur_dir == root ? 0 : cur_dir->parent->entry_offset,
-                                               cur_dir->path, cur_dir->cur_path_ofs, name_size);
+        cur_entry.parent = is_root ? 0 : directories[cur_dir.parent].entry_offset;
+        cur_entry.sibling = cur_dir.sibling == ROMFS_ENTRY_EMPTY
+                                ? ROMFS_ENTRY_EMPTY
+                                : directories[cur_dir.sibling].entry_offset;
+        cur_entry.child = cur_dir.child == ROMFS_ENTRY_EMPTY
+                              ? ROMFS_ENTRY_EMPTY
+                              : directories[cur_dir.child].entry_offset;
+        cur_entry.file = cur_dir.file == ROMFS_ENTRY_EMPTY ? ROMFS_ENTRY_EMPTY
+                                                           : files[cur_dir.file].entry_offset;
+
+        const auto path = GetPath(cur_dir.path_ofs, cur_dir.path_len);
+        const auto name_size = cur_dir.path_len - cur_dir.cur_path_ofs;
+        const auto hash =
+            romfs_calc_path_hash(cur_entry.parent, path, cur_dir.cur_path_ofs, name_size);
         cur_entry.hash = dir_hash_table[hash % dir_hash_table_entry_count];
-        dir_hash_table[hash % dir_hash_table_entry_count] = cur_dir->entry_offset;
+        dir_hash_table[hash % dir_hash_table_entry_count] = cur_dir.entry_offset;
 
         cur_entry.name_size = name_size;
 
-        std::memcpy(dir_table.data() + cur_dir->entry_offset, &cur_entry,
-                    sizeof(RomFSDirectoryEntry));
-        std::memset(dir_table.data() + cur_dir->entry_offset + sizeof(RomFSDirectoryEntry), 0,
-                    Common::AlignUp(cur_entry.name_size, 4));
-        std::memcpy(dir_table.data() + cur_dir->entry_offset + sizeof(RomFSDirectoryEntry),
-                    cur_dir->path.data() + cur_dir->cur_path_ofs, name_size);
+        std::memcpy(dir_table + cur_dir.entry_offset, &cur_entry, sizeof(RomFSDirectoryEntry));
+        std::memcpy(dir_table + cur_dir.entry_offset + sizeof(RomFSDirectoryEntry),
+                    path.data() + cur_dir.cur_path_ofs, name_size);
+    }
+
+    std::memcpy(metadata.data(), dir_hash_table.data(), dir_hash_table_size);
+    std::memcpy(metadata.data() + file_hash_table_ofs, file_hash_table.data(),
+                file_hash_table_size);
+
+    return metadata;
+}
+
+std::map<u64, VirtualFile> RomFSBuildContext::Build() {
+    dir_hash_table_size = 4 * romfs_get_hash_table_count(num_dirs);
+    file_hash_table_size = 4 * romfs_get_hash_table_count(num_files);
+
+    std::map<u64, VirtualFile> out;
+
+    // Determine file offsets.
+    u32 entry_offset = 0;
+    for (auto& cur_file : files) {
+        file_partition_size = Common::AlignUp(file_partition_size, 16);
+        cur_file.offset = file_partition_size;
+        file_partition_size += cur_file.size;
+        cur_file.entry_offset = entry_offset;
+        entry_offset += static_cast<u32>(romfs_get_entry_size(cur_file));
+
+        out.emplace(cur_file.offset + ROMFS_FILEPARTITION_OFS, cur_file.source);
+    }
+
+    // Determine directory offsets.
+    entry_offset = 0;
+    for (auto& cur_dir : directories) {
+        cur_dir.entry_offset = entry_offset;
+        entry_offset += static_cast<u32>(romfs_get_entry_size(cur_dir));
     }
 
     // Set header fields.
+    RomFSHeader header{};
     header.header_size = sizeof(RomFSHeader);
     header.file_hash_table_size = file_hash_table_size;
     header.file_table_size = file_table_size;
@@ -363,21 +496,45 @@ std::map<u64, VirtualFile> RomFSBuildContext::Build() {
     header.file_hash_table_ofs = header.dir_table_ofs + header.dir_table_size;
     header.file_table_ofs = header.file_hash_table_ofs + header.file_hash_table_size;
 
+    const u64 metadata_size =
+        file_hash_table_size + file_table_size + dir_hash_table_size + dir_table_size;
+
+    // The cache file holds the header immediately followed by the metadata tables.
+    std::string cache_name;
+    if (cache != nullptr) {
+        cache_name = fmt::format("{:016X}.bin", CalculateCacheKey());
+
+        const auto cached = cache->GetFile(cache_name);
+        RomFSHeader cached_header{};
+        if (cached != nullptr && cached->GetSize() == sizeof(RomFSHeader) + metadata_size &&
+            cached->ReadObject(&cached_header) == sizeof(RomFSHeader) &&
+            std::memcmp(&cached_header, &header, sizeof(RomFSHeader)) == 0) {
+            LOG_DEBUG(Service_FS, "Using cached RomFS metadata {}", cache_name);
+            out.emplace(0, std::make_shared<OffsetVfsFile>(cached, sizeof(RomFSHeader), 0));
+            out.emplace(header.dir_hash_table_ofs, std::make_shared<OffsetVfsFile>(
+                                                       cached, metadata_size, sizeof(RomFSHeader)));
+            UpdateCacheIndex(cache, cache_name);
+            return out;
+        }
+    }
+
+    auto metadata = BuildMetadata();
+
+    if (cache != nullptr) {
+        const auto cached = cache->CreateFile(cache_name);
+        if (cached == nullptr || !cached->Resize(sizeof(RomFSHeader) + metadata_size) ||
+            cached->WriteObject(header) != sizeof(RomFSHeader) ||
+            cached->Write(metadata.data(), metadata.size(), sizeof(RomFSHeader)) !=
+                metadata.size()) {
+            LOG_WARNING(Service_FS, "Failed to write RomFS metadata cache {}", cache_name);
+            cache->DeleteFile(cache_name);
+        }
+        UpdateCacheIndex(cache, cache_name);
+    }
+
     std::vector<u8> header_data(sizeof(RomFSHeader));
     std::memcpy(header_data.data(), &header, header_data.size());
     out.emplace(0, std::make_shared<VectorVfsFile>(std::move(header_data)));
-
-    std::vector<u8> metadata(file_hash_table_size + file_table_size + dir_hash_table_size +
-                             dir_table_size);
-    std::size_t index = 0;
-    std::memcpy(metadata.data(), dir_hash_table.data(), dir_hash_table.size() * sizeof(u32));
-    index += dir_hash_table.size() * sizeof(u32);
-    std::memcpy(metadata.data() + index, dir_table.data(), dir_table.size());
-    index += dir_table.size();
-    std::memcpy(metadata.data() + index, file_hash_table.data(),
-                file_hash_table.size() * sizeof(u32));
-    index += file_hash_table.size() * sizeof(u32);
-    std::memcpy(metadata.data() + index, file_table.data(), file_table.size());
     out.emplace(header.dir_hash_table_ofs, std::make_shared<VectorVfsFile>(std::move(metadata)));
 
     return out;
@@ -27,6 +27,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "common/common_types.h"
 #include "core/file_sys/vfs.h"
 
@@ -39,7 +41,12 @@ struct RomFSFileEntry;
 
 class RomFSBuildContext {
 public:
-    explicit RomFSBuildContext(VirtualDir base, VirtualDir ext = nullptr);
+    /// Walks base (and the optional ext override directory) to gather the RomFS tree. If cache is
+    /// non-null, the generated header and metadata tables are persisted there and reused by later
+    /// builds of an identical tree. Only building the tables is skipped, the tree is still walked
+    /// to look the entry up. The least recently used entries are evicted past a size limit.
+    explicit RomFSBuildContext(VirtualDir base, VirtualDir ext = nullptr,
+                               VirtualDir cache = nullptr);
     ~RomFSBuildContext();
 
     // This finalizes the context.
@@ -48,9 +55,13 @@ public:
 private:
     VirtualDir base;
     VirtualDir ext;
-    std::shared_ptr<RomFSBuildDirectoryContext> root;
-    std::map<std::string, std::shared_ptr<RomFSBuildDirectoryContext>, std::less<>> directories;
-    std::map<std::string, std::shared_ptr<RomFSBuildFileContext>, std::less<>> files;
+    VirtualDir cache;
+
+    // All entry paths live in this pool, contexts refer to them by offset.
+    std::string path_pool;
+    std::vector<RomFSBuildDirectoryContext> directories;
+    std::vector<RomFSBuildFileContext> files;
+
     u64 num_dirs = 0;
     u64 num_files = 0;
     u64 dir_table_size = 0;
@@ -59,13 +70,17 @@ private:
     u64 file_hash_table_size = 0;
     u64 file_partition_size = 0;
 
-    void VisitDirectory(VirtualDir filesys, VirtualDir ext,
-                        std::shared_ptr<RomFSBuildDirectoryContext> parent);
+    void VisitDirectory(const VirtualDir& dir, const VirtualDir& ext_dir, u32 parent);
 
-    bool AddDirectory(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                      std::shared_ptr<RomFSBuildDirectoryContext> dir_ctx);
-    bool AddFile(std::shared_ptr<RomFSBuildDirectoryContext> parent_dir_ctx,
-                 std::shared_ptr<RomFSBuildFileContext> file_ctx);
-};
+    u32 AddDirectory(u32 parent, std::string_view name);
+    u32 AddFile(u32 parent, std::string_view name, VirtualFile source);
 
+    /// Sorts the gathered entries by path and drops duplicates, fixing up parent indices.
+    void SortEntries();
+
+    std::string_view GetPath(u32 offset, u32 length) const;
+
+    u64 CalculateCacheKey() const;
+    std::vector<u8> BuildMetadata();
+};
 } // namespace FileSys
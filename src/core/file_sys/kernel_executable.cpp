@@ -2,6 +2,11 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <thread>
+
 #include "common/string_util.h"
 #include "core/file_sys/kernel_executable.h"
 #include "core/file_sys/vfs_offset.h"
@@ -95,23 +100,41 @@ KIP::KIP(const VirtualFile& file) : status(Loader::ResultStatus::Success) {
         return;
     }
 
+    // Sections are read serially and then decompressed in place, each on its own thread.
     u64 offset = sizeof(KIPHeader);
+    std::array<bool, 6> needs_decompression{};
     for (std::size_t i = 0; i < header.sections.size(); ++i) {
         auto compressed = file->ReadBytes(header.sections[i].compressed_size, offset);
         offset += header.sections[i].compressed_size;
 
         if (header.sections[i].compressed_size == 0 && header.sections[i].decompressed_size != 0) {
             decompressed_sections[i] = std::vector<u8>(header.sections[i].decompressed_size);
-        } else if (header.sections[i].compressed_size == header.sections[i].decompressed_size) {
-            decompressed_sections[i] = std::move(compressed);
         } else {
-            decompressed_sections[i] = compressed;
-            if (!DecompressBLZ(decompressed_sections[i])) {
-                status = Loader::ResultStatus::ErrorBLZDecompressionFailed;
-                return;
-            }
+            decompressed_sections[i] = std::move(compressed);
+            needs_decompression[i] =
+                header.sections[i].compressed_size != header.sections[i].decompressed_size;
         }
     }
+
+    std::array<bool, 6> decompression_ok{};
+    std::vector<std::thread> workers;
+    for (std::size_t i = 0; i < header.sections.size(); ++i) {
+        if (!needs_decompression[i]) {
+            decompression_ok[i] = true;
+            continue;
+        }
+        workers.emplace_back([this, &decompression_ok, i] {
+            decompression_ok[i] = DecompressBLZ(decompressed_sections[i]);
+        });
+    }
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (std::find(decompression_ok.begin(), decompression_ok.end(), false) !=
+        decompression_ok.end()) {
+        status = Loader::ResultStatus::ErrorBLZDecompressionFailed;
+    }
 }
 
 Loader::ResultStatus KIP::GetStatus() const {
@@ -15,6 +15,7 @@
 #include "core/file_sys/content_archive.h"
 #include "core/file_sys/control_metadata.h"
 #include "core/file_sys/ips_layer.h"
+#include "core/file_sys/mode.h"
 #include "core/file_sys/patch_manager.h"
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/romfs.h"
@@ -381,7 +382,11 @@ static void ApplyLayeredFS(VirtualFile& romfs, u64 title_id, ContentRecordType t
 
     auto layered_ext = LayeredVfsDirectory::MakeLayeredDirectory(std::move(layers_ext));
 
-    auto packed = CreateRomFS(std::move(layered), std::move(layered_ext));
+    // Rebuilding the metadata of large titles is expensive, keep it around for the next boot.
+    auto cache_dir = Core::System::GetInstance().GetFilesystem()->CreateDirectory(
+        FileUtil::GetUserPath(FileUtil::UserPath::CacheDir) + "romfs", Mode::ReadWrite);
+
+    auto packed = CreateRomFS(std::move(layered), std::move(layered_ext), std::move(cache_dir));
     if (packed == nullptr) {
         return;
     }
@@ -3,10 +3,14 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <random>
 #include <regex>
+#include <thread>
 #include <mbedtls/sha256.h>
 #include "common/assert.h"
+#include "common/common_funcs.h"
 #include "common/file_util.h"
 #include "common/hex_util.h"
 #include "common/logging/log.h"
@@ -17,6 +21,7 @@
 #include "core/file_sys/registered_cache.h"
 #include "core/file_sys/submission_package.h"
 #include "core/file_sys/vfs_concat.h"
+#include "core/file_sys/vfs_vector.h"
 #include "core/loader/loader.h"
 
 namespace FileSys {
@@ -24,6 +29,43 @@ namespace FileSys {
 // The size of blocks to use when vfs raw copying into nand.
 constexpr size_t VFS_RC_LARGE_COPY_BLOCK = 0x400000;
 
+// The content index caches the result of parsing each NCA in the cache, so that unchanged content
+// does not need to be decrypted and parsed again on every refresh. It lives next to the yuzu_meta
+// CNMTs and is keyed by NcaID, which is derived from the hash of the content itself.
+constexpr std::string_view CONTENT_INDEX_DIR = "yuzu_meta";
+constexpr std::string_view CONTENT_INDEX_NAME = "content_index.bin";
+constexpr u32 CONTENT_INDEX_MAGIC = Common::MakeMagic('Y', 'C', 'I', 'X');
+constexpr u32 CONTENT_INDEX_VERSION = 1;
+
+struct ContentIndexHeader {
+    u32_le magic;
+    u32_le version;
+    u32_le num_entries;
+    INSERT_PADDING_WORDS(1);
+};
+static_assert(sizeof(ContentIndexHeader) == 0x10, "ContentIndexHeader has incorrect size.");
+
+struct ContentIndexEntryHeader {
+    NcaID nca_id;
+    u64_le size;
+    u64_le title_id;
+    NCAContentType type;
+    INSERT_PADDING_BYTES(3);
+    u32_le cnmt_size;
+};
+static_assert(sizeof(ContentIndexEntryHeader) == 0x28,
+              "ContentIndexEntryHeader has incorrect size.");
+
+struct ContentIndexEntry {
+    u64 size;
+    u64 title_id;
+    NCAContentType type;
+    // Raw CNMT contained within the NCA, only present for Meta-type NCAs.
+    std::vector<u8> cnmt;
+};
+
+using ContentIndex = std::map<NcaID, ContentIndexEntry>;
+
 std::string ContentProviderEntry::DebugInfo() const {
     return fmt::format("title_id={:016X}, content_type={:02X}", title_id, static_cast<u8>(type));
 }
@@ -402,28 +444,172 @@ std::vector<NcaID> RegisteredCache::AccumulateFiles() const {
     return ids;
 }
 
+static ContentIndex LoadContentIndex(const VirtualDir& dir) {
+    ContentIndex out;
+
+    const auto index_dir = dir->GetSubdirectory(CONTENT_INDEX_DIR);
+    const auto file = index_dir == nullptr ? nullptr : index_dir->GetFile(CONTENT_INDEX_NAME);
+    if (file == nullptr)
+        return out;
+
+    ContentIndexHeader header{};
+    if (file->ReadObject(&header) != sizeof(ContentIndexHeader) ||
+        header.magic != CONTENT_INDEX_MAGIC || header.version != CONTENT_INDEX_VERSION) {
+        return out;
+    }
+
+    std::size_t offset = sizeof(ContentIndexHeader);
+    for (u32 i = 0; i < header.num_entries; ++i) {
+        ContentIndexEntryHeader entry_header{};
+        if (file->ReadObject(&entry_header, offset) != sizeof(ContentIndexEntryHeader)) {
+            LOG_WARNING(Loader, "Content index is truncated, discarding it.");
+            return {};
+        }
+        offset += sizeof(ContentIndexEntryHeader);
+
+        auto cnmt = file->ReadBytes(entry_header.cnmt_size, offset);
+        if (cnmt.size() != entry_header.cnmt_size) {
+            LOG_WARNING(Loader, "Content index is truncated, discarding it.");
+            return {};
+        }
+        offset += entry_header.cnmt_size;
+
+        out.insert_or_assign(entry_header.nca_id,
+                             ContentIndexEntry{entry_header.size, entry_header.title_id,
+                                               entry_header.type, std::move(cnmt)});
+    }
+
+    return out;
+}
+
+static void SaveContentIndex(const VirtualDir& dir, const ContentIndex& index) {
+    std::vector<u8> buffer(sizeof(ContentIndexHeader));
+
+    const ContentIndexHeader header{CONTENT_INDEX_MAGIC, CONTENT_INDEX_VERSION,
+                                    static_cast<u32>(index.size())};
+    std::memcpy(buffer.data(), &header, sizeof(ContentIndexHeader));
+
+    for (const auto& [id, entry] : index) {
+        ContentIndexEntryHeader entry_header{};
+        entry_header.nca_id = id;
+        entry_header.size = entry.size;
+        entry_header.title_id = entry.title_id;
+        entry_header.type = entry.type;
+        entry_header.cnmt_size = static_cast<u32>(entry.cnmt.size());
+
+        const auto offset = buffer.size();
+        buffer.resize(offset + sizeof(ContentIndexEntryHeader) + entry.cnmt.size());
+        std::memcpy(buffer.data() + offset, &entry_header, sizeof(ContentIndexEntryHeader));
+        std::memcpy(buffer.data() + offset + sizeof(ContentIndexEntryHeader), entry.cnmt.data(),
+                    entry.cnmt.size());
+    }
+
+    const auto index_dir = GetOrCreateDirectoryRelative(dir, CONTENT_INDEX_DIR);
+    if (index_dir == nullptr)
+        return;
+
+    auto file = index_dir->GetFile(CONTENT_INDEX_NAME);
+    if (file == nullptr)
+        file = index_dir->CreateFile(CONTENT_INDEX_NAME);
+
+    if (file == nullptr || !file->Resize(buffer.size()) ||
+        file->WriteBytes(buffer) != buffer.size()) {
+        LOG_WARNING(Loader, "Failed to write content index.");
+    }
+}
+
+std::optional<ContentIndexEntry> RegisteredCache::ParseContent(const VirtualFile& file,
+                                                               const NcaID& id) const {
+    const NCA nca{parser(file, id), nullptr, 0, keys};
+
+    // Failures are not cached, as they may be resolved by e.g. adding keys.
+    if (nca.GetStatus() != Loader::ResultStatus::Success)
+        return std::nullopt;
+
+    ContentIndexEntry entry{file->GetSize(), nca.GetTitleId(), nca.GetType(), {}};
+    if (entry.type != NCAContentType::Meta)
+        return entry;
+
+    const auto section0 = nca.GetSubdirectories()[0];
+
+    for (const auto& section0_file : section0->GetFiles()) {
+        if (section0_file->GetExtension() != "cnmt")
+            continue;
+
+        entry.cnmt = section0_file->ReadAllBytes();
+        break;
+    }
+
+    return entry;
+}
+
 void RegisteredCache::ProcessFiles(const std::vector<NcaID>& ids) {
-    for (const auto& id : ids) {
-        const auto file = GetFileAtID(id);
+    const auto old_index = LoadContentIndex(dir);
 
+    // Opening files goes through the (single-threaded) filesystem, so that is done up front.
+    std::vector<std::optional<ContentIndexEntry>> entries(ids.size());
+    std::vector<std::pair<std::size_t, VirtualFile>> pending;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        auto file = GetFileAtID(ids[i]);
         if (file == nullptr)
             continue;
-        const auto nca = std::make_shared<NCA>(parser(file, id), nullptr, 0, keys);
-        if (nca->GetStatus() != Loader::ResultStatus::Success ||
-            nca->GetType() != NCAContentType::Meta) {
+
+        const auto iter = old_index.find(ids[i]);
+        if (iter != old_index.end() && iter->second.size == file->GetSize()) {
+            entries[i] = iter->second;
             continue;
         }
 
-        const auto section0 = nca->GetSubdirectories()[0];
+        pending.emplace_back(i, std::move(file));
+    }
 
-        for (const auto& section0_file : section0->GetFiles()) {
-            if (section0_file->GetExtension() != "cnmt")
-                continue;
+    // Decrypting and parsing the NCAs themselves is the expensive part, spread it across the
+    // available host threads. The first one is parsed on this thread, so that any lazily derived
+    // keys get written out before multiple parsers race for them.
+    std::size_t next_pending = 0;
+    if (!pending.empty()) {
+        const auto& [index, file] = pending[next_pending++];
+        entries[index] = ParseContent(file, ids[index]);
+    }
 
-            meta.insert_or_assign(nca->GetTitleId(), CNMT(section0_file));
-            meta_id.insert_or_assign(nca->GetTitleId(), id);
-            break;
+    std::atomic_size_t shared_next{next_pending};
+    const auto worker = [&] {
+        for (std::size_t i = shared_next++; i < pending.size(); i = shared_next++) {
+            const auto& [index, file] = pending[i];
+            entries[index] = ParseContent(file, ids[index]);
         }
+    };
+
+    const auto num_workers = std::min<std::size_t>(
+        std::max(std::thread::hardware_concurrency(), 1U), pending.size() - next_pending);
+    std::vector<std::thread> threads(num_workers);
+    for (auto& thread : threads) {
+        thread = std::thread(worker);
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    ContentIndex new_index;
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        if (!entries[i].has_value())
+            continue;
+
+        const auto& entry = *entries[i];
+        if (entry.type == NCAContentType::Meta && !entry.cnmt.empty()) {
+            meta.insert_or_assign(entry.title_id,
+                                  CNMT(std::make_shared<VectorVfsFile>(entry.cnmt)));
+            meta_id.insert_or_assign(entry.title_id, ids[i]);
+        }
+
+        new_index.insert_or_assign(ids[i], std::move(*entries[i]));
+    }
+
+    last_refresh_stats.num_contents = new_index.size();
+    last_refresh_stats.num_parsed = pending.size();
+
+    if (!pending.empty() || new_index.size() != old_index.size()) {
+        SaveContentIndex(dir, new_index);
     }
 }
 
@@ -444,9 +630,22 @@ void RegisteredCache::AccumulateYuzuMeta() {
 void RegisteredCache::Refresh() {
     if (dir == nullptr)
         return;
+
+    const auto start_time = std::chrono::steady_clock::now();
+
     const auto ids = AccumulateFiles();
     ProcessFiles(ids);
     AccumulateYuzuMeta();
+
+    last_refresh_stats.duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start_time);
+    LOG_INFO(Loader, "Refreshed registered cache {} in {} ms ({} contents, {} parsed)",
+             dir->GetFullPath(), last_refresh_stats.duration.count() / 1000.0,
+             last_refresh_stats.num_contents, last_refresh_stats.num_parsed);
+}
+
+const RegisteredCacheRefreshStats& RegisteredCache::GetLastRefreshStats() const {
+    return last_refresh_stats;
 }
 
 RegisteredCache::RegisteredCache(VirtualDir dir_, ContentProviderParsingFunction parsing_function)
@@ -542,13 +741,16 @@ static std::shared_ptr<NCA> GetNCAFromNSPForID(const NSP& nsp, const NcaID& id)
     return std::make_shared<NCA>(std::move(file));
 }
 
-InstallResult RegisteredCache::InstallEntry(const XCI& xci, bool overwrite_if_exists,
-                                            const VfsCopyFunction& copy) {
-    return InstallEntry(*xci.GetSecurePartitionNSP(), overwrite_if_exists, copy);
-}
+namespace {
+struct NSPContent {
+    std::shared_ptr<NCA> nca;
+    NcaID id;
+    // The meta NCA is not listed in its own CNMT, so there is nothing to verify it against.
+    std::optional<Core::Crypto::SHA256Hash> hash;
+};
 
-InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_exists,
-                                            const VfsCopyFunction& copy) {
+// Gathers the meta NCA followed by every NCA its CNMT references, in install order.
+InstallResult CollectNSPContents(const NSP& nsp, std::vector<NSPContent>& out) {
     const auto ncas = nsp.GetNCAsCollapsed();
     const auto meta_iter = std::find_if(ncas.begin(), ncas.end(), [](const auto& nca) {
         return nca->GetType() == NCAContentType::Meta;
@@ -560,15 +762,9 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
         return InstallResult::ErrorMetaFailed;
     }
 
-    // Install Metadata File
     const auto meta_id_raw = (*meta_iter)->GetName().substr(0, 32);
-    const auto meta_id = Common::HexStringToArray<16>(meta_id_raw);
-
-    const auto res = RawInstallNCA(**meta_iter, copy, overwrite_if_exists, meta_id);
-    if (res != InstallResult::Success)
-        return res;
+    out.push_back({*meta_iter, Common::HexStringToArray<16>(meta_id_raw), std::nullopt});
 
-    // Install all the other NCAs
     const auto section0 = (*meta_iter)->GetSubdirectories()[0];
     const auto cnmt_file = section0->GetFiles()[0];
     const CNMT cnmt(cnmt_file);
@@ -576,12 +772,97 @@ InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_ex
         // Ignore DeltaFragments, they are not useful to us
         if (record.type == ContentRecordType::DeltaFragment)
             continue;
-        const auto nca = GetNCAFromNSPForID(nsp, record.nca_id);
+        auto nca = GetNCAFromNSPForID(nsp, record.nca_id);
         if (nca == nullptr)
             return InstallResult::ErrorCopyFailed;
-        const auto res2 = RawInstallNCA(*nca, copy, overwrite_if_exists, record.nca_id);
-        if (res2 != InstallResult::Success)
-            return res2;
+        out.push_back({std::move(nca), record.nca_id, record.hash});
+    }
+
+    return InstallResult::Success;
+}
+} // Anonymous namespace
+
+InstallResult RegisteredCache::InstallEntry(const XCI& xci, bool overwrite_if_exists,
+                                            const VfsCopyFunction& copy) {
+    return InstallEntry(*xci.GetSecurePartitionNSP(), overwrite_if_exists, copy);
+}
+
+InstallResult RegisteredCache::InstallEntry(const NSP& nsp, bool overwrite_if_exists,
+                                            const VfsCopyFunction& copy) {
+    std::vector<NSPContent> contents;
+    const auto collect_res = CollectNSPContents(nsp, contents);
+    if (collect_res != InstallResult::Success)
+        return collect_res;
+
+    for (const auto& content : contents) {
+        const auto res = RawInstallNCA(*content.nca, copy, overwrite_if_exists, content.id);
+        if (res != InstallResult::Success)
+            return res;
+    }
+
+    Refresh();
+    return InstallResult::Success;
+}
+
+InstallResult RegisteredCache::InstallEntry(const XCI& xci, const InstallOptions& options) {
+    return InstallEntry(*xci.GetSecurePartitionNSP(), options);
+}
+
+InstallResult RegisteredCache::InstallEntry(const NSP& nsp, const InstallOptions& options) {
+    std::vector<NSPContent> contents;
+    const auto collect_res = CollectNSPContents(nsp, contents);
+    if (collect_res != InstallResult::Success)
+        return collect_res;
+
+    u64 total_bytes = 0;
+    for (const auto& content : contents) {
+        total_bytes += content.nca->GetBaseFile()->GetSize();
+    }
+
+    const auto start_time = std::chrono::steady_clock::now();
+    const auto report_progress = [&](u64 bytes_installed) {
+        if (!options.progress)
+            return true;
+        const std::chrono::duration<double> elapsed =
+            std::chrono::steady_clock::now() - start_time;
+        const double rate = elapsed.count() > 0 ? bytes_installed / elapsed.count() : 0.0;
+        return options.progress({bytes_installed, total_bytes, rate});
+    };
+
+    // NCAs of a failed entry are removed again, a partially installed title can't be launched
+    std::vector<NcaID> installed_ids;
+    const auto roll_back = [this, &installed_ids] {
+        for (const auto& id : installed_ids) {
+            RemoveNCA(id);
+        }
+    };
+
+    u64 completed_bytes = 0;
+    for (const auto& content : contents) {
+        const bool verify = options.verify_hashes && content.hash.has_value();
+        Core::Crypto::SHA256Hash hash{};
+        const auto copy = [&](const VirtualFile& src, const VirtualFile& dest, std::size_t) {
+            return VfsPipelinedCopy(src, dest, options.block_size, verify ? &hash : nullptr,
+                                    [&](std::size_t written) {
+                                        return report_progress(completed_bytes + written);
+                                    });
+        };
+
+        const auto res = RawInstallNCA(*content.nca, copy, options.overwrite_if_exists, content.id);
+        if (res != InstallResult::Success) {
+            roll_back();
+            return res;
+        }
+        installed_ids.push_back(content.id);
+
+        if (verify && hash != *content.hash) {
+            LOG_ERROR(Loader, "NCA {} does not match the hash in its CNMT, removing the entry.",
+                      Common::HexToString(content.id, false));
+            roll_back();
+            return InstallResult::ErrorHashMismatch;
+        }
+
+        completed_bytes += content.nca->GetBaseFile()->GetSize();
     }
 
     Refresh();
@@ -651,8 +932,20 @@ InstallResult RegisteredCache::RawInstallNCA(const NCA& nca, const VfsCopyFuncti
     auto out = dir->CreateFileRelative(path);
     if (out == nullptr)
         return InstallResult::ErrorCopyFailed;
-    return copy(in, out, VFS_RC_LARGE_COPY_BLOCK) ? InstallResult::Success
-                                                  : InstallResult::ErrorCopyFailed;
+    if (!copy(in, out, VFS_RC_LARGE_COPY_BLOCK)) {
+        // Don't leave a partially written NCA behind, it would be picked up on the next refresh
+        out = nullptr;
+        RemoveNCA(id);
+        return InstallResult::ErrorCopyFailed;
+    }
+    return InstallResult::Success;
+}
+
+void RegisteredCache::RemoveNCA(const NcaID& id) {
+    const auto path = GetRelativePathFromNcaID(id, false, true, false);
+    const auto file = dir->GetFileRelative(path);
+    if (file != nullptr)
+        file->GetContainingDirectory()->DeleteFile(FileUtil::GetFilename(path));
 }
 
 bool RegisteredCache::RawInstallYuzuMeta(const CNMT& cnmt) {
@@ -831,6 +1124,11 @@ void ManualContentProvider::AddEntry(TitleType title_type, ContentRecordType con
     entries.insert_or_assign({title_type, content_type, title_id}, file);
 }
 
+void ManualContentProvider::RemoveEntry(TitleType title_type, ContentRecordType content_type,
+                                        u64 title_id) {
+    entries.erase({title_type, content_type, title_id});
+}
+
 void ManualContentProvider::ClearAllEntries() {
     entries.clear();
 }
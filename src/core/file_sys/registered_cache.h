@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <string>
@@ -24,6 +25,7 @@ enum class ContentRecordType : u8;
 enum class NCAContentType : u8;
 enum class TitleType : u8;
 
+struct ContentIndexEntry;
 struct ContentRecord;
 struct MetaRecord;
 class RegisteredCache;
@@ -37,6 +39,25 @@ enum class InstallResult {
     ErrorAlreadyExists,
     ErrorCopyFailed,
     ErrorMetaFailed,
+    ErrorHashMismatch,
+};
+
+struct InstallProgress {
+    u64 bytes_installed;
+    u64 total_bytes;
+    double bytes_per_second;
+};
+
+// Returning false from the callback cancels the installation.
+using InstallProgressCallback = std::function<bool(const InstallProgress&)>;
+
+// Options for the pipelined InstallEntry overloads.
+struct InstallOptions {
+    bool overwrite_if_exists = false;
+    // Check each installed NCA against the SHA-256 in its CNMT content record while copying.
+    bool verify_hashes = true;
+    std::size_t block_size = 0x400000;
+    InstallProgressCallback progress;
 };
 
 struct ContentProviderEntry {
@@ -112,6 +133,15 @@ private:
     VirtualDir dir;
 };
 
+struct RegisteredCacheRefreshStats {
+    /// Time spent scanning and parsing the contents during the last refresh.
+    std::chrono::microseconds duration{};
+    /// Number of valid contents found in the cache.
+    std::size_t num_contents = 0;
+    /// Number of contents that were not present in the content index and had to be parsed.
+    std::size_t num_parsed = 0;
+};
+
 /*
  * A class that catalogues NCAs in the registered directory structure.
  * Nintendo's registered format follows this structure:
@@ -139,6 +169,8 @@ public:
 
     void Refresh() override;
 
+    const RegisteredCacheRefreshStats& GetLastRefreshStats() const;
+
     bool HasEntry(u64 title_id, ContentRecordType type) const override;
 
     std::optional<u32> GetEntryVersion(u64 title_id) const override;
@@ -161,6 +193,11 @@ public:
     InstallResult InstallEntry(const NSP& nsp, bool overwrite_if_exists = false,
                                const VfsCopyFunction& copy = &VfsRawCopy);
 
+    // Same as above, but reads, verifies and writes each NCA in an overlapped pipeline and reports
+    // progress for the whole package through options.progress.
+    InstallResult InstallEntry(const XCI& xci, const InstallOptions& options);
+    InstallResult InstallEntry(const NSP& nsp, const InstallOptions& options);
+
     // Due to the fact that we must use Meta-type NCAs to determine the existance of files, this
     // poses quite a challenge. Instead of creating a new meta NCA for this file, yuzu will create a
     // dir inside the NAND called 'yuzu_meta' and store the raw CNMT there.
@@ -174,6 +211,7 @@ private:
                             std::function<T(const CNMT&, const ContentRecord&)> proc,
                             std::function<bool(const CNMT&, const ContentRecord&)> filter) const;
     std::vector<NcaID> AccumulateFiles() const;
+    std::optional<ContentIndexEntry> ParseContent(const VirtualFile& file, const NcaID& id) const;
     void ProcessFiles(const std::vector<NcaID>& ids);
     void AccumulateYuzuMeta();
     std::optional<NcaID> GetNcaIDFromMetadata(u64 title_id, ContentRecordType type) const;
@@ -181,6 +219,8 @@ private:
     VirtualFile OpenFileOrDirectoryConcat(const VirtualDir& dir, std::string_view path) const;
     InstallResult RawInstallNCA(const NCA& nca, const VfsCopyFunction& copy,
                                 bool overwrite_if_exists, std::optional<NcaID> override_id = {});
+    /// Deletes the NCA with the given ID from the cache directory, if it exists.
+    void RemoveNCA(const NcaID& id);
     bool RawInstallYuzuMeta(const CNMT& cnmt);
 
     VirtualDir dir;
@@ -192,6 +232,8 @@ private:
     std::map<u64, CNMT> meta;
     // maps tid -> meta for CNMT in yuzu_meta
     std::map<u64, CNMT> yuzu_meta;
+
+    RegisteredCacheRefreshStats last_refresh_stats;
 };
 
 enum class ContentProviderUnionSlot {
@@ -237,6 +279,7 @@ public:
 
     void AddEntry(TitleType title_type, ContentRecordType content_type, u64 title_id,
                   VirtualFile file);
+    void RemoveEntry(TitleType title_type, ContentRecordType content_type, u64 title_id);
     void ClearAllEntries();
 
     void Refresh() override;
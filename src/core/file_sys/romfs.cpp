@@ -136,11 +136,11 @@ VirtualDir ExtractRomFS(VirtualFile file, RomFSExtractionType type) {
     return out;
 }
 
-VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext) {
+VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext, VirtualDir cache) {
     if (dir == nullptr)
         return nullptr;
 
-    RomFSBuildContext ctx{dir, ext};
+    RomFSBuildContext ctx{dir, std::move(ext), std::move(cache)};
     return ConcatenatedVfsFile::MakeConcatenatedFile(0, ctx.Build(), dir->GetName());
 }
 
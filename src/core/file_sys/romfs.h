@@ -21,7 +21,8 @@ VirtualDir ExtractRomFS(VirtualFile file,
                         RomFSExtractionType type = RomFSExtractionType::Truncated);
 
 // Converts a VFS filesystem into a RomFS binary
+// If cache is provided, the generated metadata is persisted to and reused from it
 // Returns nullptr on failure
-VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext = nullptr);
+VirtualFile CreateRomFS(VirtualDir dir, VirtualDir ext = nullptr, VirtualDir cache = nullptr);
 
 } // namespace FileSys
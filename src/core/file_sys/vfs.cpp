@@ -3,8 +3,12 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
 #include <numeric>
 #include <string>
+#include <thread>
+#include <mbedtls/sha256.h>
 #include "common/common_paths.h"
 #include "common/file_util.h"
 #include "common/logging/backend.h"
@@ -531,6 +535,136 @@ bool VfsRawCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t blo
     return true;
 }
 
+bool VfsPipelinedCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size,
+                      std::array<u8, 0x20>* sha256, const VfsCopyProgressCallback& progress) {
+    if (src == nullptr || dest == nullptr || !src->IsReadable() || !dest->IsWritable())
+        return false;
+    if (block_size == 0)
+        return false;
+
+    const std::size_t size = src->GetSize();
+    if (!dest->Resize(size))
+        return false;
+
+    // Block i lives in buffers[i % NUM_BUFFERS]. The reader may only refill a buffer once both the
+    // hasher and the writer are done with the block previously stored in it.
+    constexpr std::size_t NUM_BUFFERS = 4;
+    std::array<std::vector<u8>, NUM_BUFFERS> buffers;
+    for (auto& buffer : buffers) {
+        buffer.reserve(std::min(block_size, size));
+    }
+
+    const std::size_t num_blocks = (size + block_size - 1) / block_size;
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::size_t blocks_read = 0;
+    std::size_t blocks_hashed = sha256 == nullptr ? num_blocks : 0;
+    std::size_t blocks_written = 0;
+    bool failed = false;
+
+    const auto fail = [&] {
+        {
+            std::scoped_lock lock{mutex};
+            failed = true;
+        }
+        cv.notify_all();
+    };
+
+    std::thread reader([&] {
+        for (std::size_t i = 0; i < num_blocks; ++i) {
+            {
+                std::unique_lock lock{mutex};
+                cv.wait(lock, [&] {
+                    return failed || i - std::min(blocks_hashed, blocks_written) < NUM_BUFFERS;
+                });
+                if (failed)
+                    return;
+            }
+
+            auto& buffer = buffers[i % NUM_BUFFERS];
+            const std::size_t offset = i * block_size;
+            buffer.resize(std::min(block_size, size - offset));
+            if (src->Read(buffer.data(), buffer.size(), offset) != buffer.size()) {
+                fail();
+                return;
+            }
+
+            {
+                std::scoped_lock lock{mutex};
+                ++blocks_read;
+            }
+            cv.notify_all();
+        }
+    });
+
+    mbedtls_sha256_context context;
+    mbedtls_sha256_init(&context);
+    std::thread hasher;
+    if (sha256 != nullptr) {
+        mbedtls_sha256_starts_ret(&context, 0);
+        hasher = std::thread([&] {
+            for (std::size_t i = 0; i < num_blocks; ++i) {
+                {
+                    std::unique_lock lock{mutex};
+                    cv.wait(lock, [&] { return failed || blocks_read > i; });
+                    if (failed)
+                        return;
+                }
+
+                const auto& buffer = buffers[i % NUM_BUFFERS];
+                mbedtls_sha256_update_ret(&context, buffer.data(), buffer.size());
+
+                {
+                    std::scoped_lock lock{mutex};
+                    ++blocks_hashed;
+                }
+                cv.notify_all();
+            }
+        });
+    }
+
+    // The writer runs on the calling thread, so the progress callback is invoked from there.
+    std::size_t bytes_written = 0;
+    for (std::size_t i = 0; i < num_blocks; ++i) {
+        {
+            std::unique_lock lock{mutex};
+            cv.wait(lock, [&] { return failed || blocks_read > i; });
+            if (failed)
+                break;
+        }
+
+        const auto& buffer = buffers[i % NUM_BUFFERS];
+        if (dest->Write(buffer.data(), buffer.size(), i * block_size) != buffer.size()) {
+            fail();
+            break;
+        }
+        bytes_written += buffer.size();
+
+        {
+            std::scoped_lock lock{mutex};
+            ++blocks_written;
+        }
+        cv.notify_all();
+
+        if (progress && !progress(bytes_written)) {
+            fail();
+            break;
+        }
+    }
+
+    reader.join();
+    if (hasher.joinable()) {
+        hasher.join();
+    }
+
+    if (!failed && sha256 != nullptr) {
+        mbedtls_sha256_finish_ret(&context, sha256->data());
+    }
+    mbedtls_sha256_free(&context);
+
+    return !failed;
+}
+
 bool VfsRawCopyD(const VirtualDir& src, const VirtualDir& dest, std::size_t block_size) {
     if (src == nullptr || dest == nullptr || !src->IsReadable() || !dest->IsWritable())
         return false;
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <map>
 #include <memory>
@@ -302,6 +303,17 @@ bool DeepEquals(const VirtualFile& file1, const VirtualFile& file2,
 // directory of src/dest.
 bool VfsRawCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size = 0x1000);
 
+// Called by VfsPipelinedCopy after each block is written with the total number of bytes written.
+// Returning false cancels the copy.
+using VfsCopyProgressCallback = std::function<bool(std::size_t)>;
+
+// A variant of VfsRawCopy intended for large files. Reading from src, hashing and writing to dest
+// run on separate threads and overlap, using a small ring of block_size buffers. If sha256 is not
+// null, it receives the SHA-256 of the copied data on success.
+bool VfsPipelinedCopy(const VirtualFile& src, const VirtualFile& dest, std::size_t block_size,
+                      std::array<u8, 0x20>* sha256 = nullptr,
+                      const VfsCopyProgressCallback& progress = {});
+
 // A method that performs a similar function to VfsRawCopy above, but instead copies entire
 // directories. It suffers the same performance penalties as above and an implementation-specific
 // Copy should always be preferred.
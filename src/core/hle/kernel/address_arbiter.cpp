@@ -2,9 +2,6 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <algorithm>
-#include <vector>
-
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "core/core.h"
@@ -17,25 +14,36 @@
 
 namespace Kernel {
 
-// Wake up num_to_wake (or all) threads in a vector.
-void AddressArbiter::WakeThreads(const std::vector<std::shared_ptr<Thread>>& waiting_threads,
-                                 s32 num_to_wake) {
+// Wake up num_to_wake (or all) threads waiting on an address, in priority order.
+void AddressArbiter::WakeThreads(VAddr address, s32 num_to_wake) {
     // Only process up to 'target' threads, unless 'target' is <= 0, in which case process
     // them all.
-    std::size_t last = waiting_threads.size();
-    if (num_to_wake > 0) {
-        last = std::min(last, static_cast<std::size_t>(num_to_wake));
+    s32 num_woken = 0;
+    auto it = arb_threads.lower_bound(address, AddressCompare{});
+    while (it != arb_threads.end() && it->GetArbiterWaitAddress() == address &&
+           (num_to_wake <= 0 || num_woken < num_to_wake)) {
+        Thread& thread = *it;
+        it = arb_threads.erase(it);
+        ++num_woken;
+
+        // Signal the waiting thread.
+        ASSERT(thread.GetStatus() == ThreadStatus::WaitArb);
+        thread.SetWaitSynchronizationResult(RESULT_SUCCESS);
+        thread.SetArbiterWaitAddress(0);
+        thread.ResumeFromWait();
+        system.PrepareReschedule(thread.GetProcessorID());
     }
+}
 
-    // Signal the waiting threads.
-    for (std::size_t i = 0; i < last; i++) {
-        ASSERT(waiting_threads[i]->GetStatus() == ThreadStatus::WaitArb);
-        waiting_threads[i]->SetWaitSynchronizationResult(RESULT_SUCCESS);
-        RemoveThread(waiting_threads[i]);
-        waiting_threads[i]->SetArbiterWaitAddress(0);
-        waiting_threads[i]->ResumeFromWait();
-        system.PrepareReschedule(waiting_threads[i]->GetProcessorID());
+std::size_t AddressArbiter::CountThreadsWaitingOnAddress(VAddr address,
+                                                         std::size_t max_count) const {
+    std::size_t count = 0;
+    for (auto it = arb_threads.lower_bound(address, AddressCompare{});
+         it != arb_threads.end() && it->GetArbiterWaitAddress() == address && count < max_count;
+         ++it) {
+        ++count;
     }
+    return count;
 }
 
 AddressArbiter::AddressArbiter(Core::System& system) : system{system} {}
@@ -56,9 +64,7 @@ ResultCode AddressArbiter::SignalToAddress(VAddr address, SignalType type, s32 v
 }
 
 ResultCode AddressArbiter::SignalToAddressOnly(VAddr address, s32 num_to_wake) {
-    const std::vector<std::shared_ptr<Thread>> waiting_threads =
-        GetThreadsWaitingOnAddress(address);
-    WakeThreads(waiting_threads, num_to_wake);
+    WakeThreads(address, num_to_wake);
     return RESULT_SUCCESS;
 }
 
@@ -88,22 +94,22 @@ ResultCode AddressArbiter::ModifyByWaitingCountAndSignalToAddressIfEqual(VAddr a
         return ERR_INVALID_ADDRESS_STATE;
     }
 
-    // Get threads waiting on the address.
-    const std::vector<std::shared_ptr<Thread>> waiting_threads =
-        GetThreadsWaitingOnAddress(address);
+    // Only whether there are no waiters, at most num_to_wake waiters or more matters here.
+    const std::size_t num_waiting = CountThreadsWaitingOnAddress(
+        address, num_to_wake <= 0 ? 1 : static_cast<std::size_t>(num_to_wake) + 1);
 
     // Determine the modified value depending on the waiting count.
     s32 updated_value;
     if (num_to_wake <= 0) {
-        if (waiting_threads.empty()) {
+        if (num_waiting == 0) {
             updated_value = value + 1;
         } else {
             updated_value = value - 1;
         }
     } else {
-        if (waiting_threads.empty()) {
+        if (num_waiting == 0) {
             updated_value = value + 1;
-        } else if (waiting_threads.size() <= static_cast<u32>(num_to_wake)) {
+        } else if (num_waiting <= static_cast<u32>(num_to_wake)) {
             updated_value = value - 1;
         } else {
             updated_value = value;
@@ -115,7 +121,7 @@ ResultCode AddressArbiter::ModifyByWaitingCountAndSignalToAddressIfEqual(VAddr a
     }
 
     memory.Write32(address, static_cast<u32>(updated_value));
-    WakeThreads(waiting_threads, num_to_wake);
+    WakeThreads(address, num_to_wake);
     return RESULT_SUCCESS;
 }
 
@@ -183,7 +189,7 @@ ResultCode AddressArbiter::WaitForAddressIfEqual(VAddr address, s32 value, s64 t
 ResultCode AddressArbiter::WaitForAddressImpl(VAddr address, s64 timeout) {
     Thread* current_thread = system.CurrentScheduler().GetCurrentThread();
     current_thread->SetArbiterWaitAddress(address);
-    InsertThread(SharedFrom(current_thread));
+    InsertThread(*current_thread);
     current_thread->SetStatus(ThreadStatus::WaitArb);
     current_thread->InvalidateWakeupCallback();
     current_thread->WakeAfterDelay(timeout);
@@ -192,48 +198,20 @@ ResultCode AddressArbiter::WaitForAddressImpl(VAddr address, s64 timeout) {
     return RESULT_TIMEOUT;
 }
 
-void AddressArbiter::HandleWakeupThread(std::shared_ptr<Thread> thread) {
-    ASSERT(thread->GetStatus() == ThreadStatus::WaitArb);
+void AddressArbiter::HandleWakeupThread(Thread& thread) {
+    ASSERT(thread.GetStatus() == ThreadStatus::WaitArb);
     RemoveThread(thread);
-    thread->SetArbiterWaitAddress(0);
+    thread.SetArbiterWaitAddress(0);
 }
 
-void AddressArbiter::InsertThread(std::shared_ptr<Thread> thread) {
-    const VAddr arb_addr = thread->GetArbiterWaitAddress();
-    std::list<std::shared_ptr<Thread>>& thread_list = arb_threads[arb_addr];
-
-    const auto iter =
-        std::find_if(thread_list.cbegin(), thread_list.cend(), [&thread](const auto& entry) {
-            return entry->GetPriority() >= thread->GetPriority();
-        });
-
-    if (iter == thread_list.cend()) {
-        thread_list.push_back(std::move(thread));
-    } else {
-        thread_list.insert(iter, std::move(thread));
-    }
+void AddressArbiter::InsertThread(Thread& thread) {
+    ASSERT(!thread.arbiter_hook.is_linked());
+    arb_threads.insert(thread);
 }
 
-void AddressArbiter::RemoveThread(std::shared_ptr<Thread> thread) {
-    const VAddr arb_addr = thread->GetArbiterWaitAddress();
-    std::list<std::shared_ptr<Thread>>& thread_list = arb_threads[arb_addr];
-
-    const auto iter = std::find_if(thread_list.cbegin(), thread_list.cend(),
-                                   [&thread](const auto& entry) { return thread == entry; });
-
-    ASSERT(iter != thread_list.cend());
-
-    thread_list.erase(iter);
+void AddressArbiter::RemoveThread(Thread& thread) {
+    ASSERT(thread.arbiter_hook.is_linked());
+    arb_threads.erase(arb_threads.iterator_to(thread));
 }
 
-std::vector<std::shared_ptr<Thread>> AddressArbiter::GetThreadsWaitingOnAddress(
-    VAddr address) const {
-    const auto iter = arb_threads.find(address);
-    if (iter == arb_threads.cend()) {
-        return {};
-    }
-
-    const std::list<std::shared_ptr<Thread>>& thread_list = iter->second;
-    return {thread_list.cbegin(), thread_list.cend()};
-}
 } // namespace Kernel
@@ -4,12 +4,12 @@
 
 #pragma once
 
-#include <list>
-#include <memory>
-#include <unordered_map>
-#include <vector>
+#include <cstddef>
+
+#include <boost/intrusive/set.hpp>
 
 #include "common/common_types.h"
+#include "core/hle/kernel/thread.h"
 
 union ResultCode;
 
@@ -19,8 +19,6 @@ class System;
 
 namespace Kernel {
 
-class Thread;
-
 class AddressArbiter {
 public:
     enum class ArbitrationType {
@@ -51,9 +49,42 @@ public:
     ResultCode WaitForAddress(VAddr address, ArbitrationType type, s32 value, s64 timeout_ns);
 
     /// Removes a thread from the container and resets its address arbiter adress to 0
-    void HandleWakeupThread(std::shared_ptr<Thread> thread);
+    void HandleWakeupThread(Thread& thread);
+
+    /// Insert a thread into the address arbiter container
+    void InsertThread(Thread& thread);
+
+    /// Removes a thread from the address arbiter container
+    void RemoveThread(Thread& thread);
 
 private:
+    /// Orders waiting threads by address, then by priority. Threads with the same address and
+    /// priority are kept in the order they started waiting.
+    struct ThreadCompare {
+        bool operator()(const Thread& lhs, const Thread& rhs) const {
+            if (lhs.GetArbiterWaitAddress() != rhs.GetArbiterWaitAddress()) {
+                return lhs.GetArbiterWaitAddress() < rhs.GetArbiterWaitAddress();
+            }
+            return lhs.GetPriority() < rhs.GetPriority();
+        }
+    };
+
+    /// Compares threads against a bare address, used to find the waiters of an address.
+    struct AddressCompare {
+        bool operator()(VAddr address, const Thread& thread) const {
+            return address < thread.GetArbiterWaitAddress();
+        }
+        bool operator()(const Thread& thread, VAddr address) const {
+            return thread.GetArbiterWaitAddress() < address;
+        }
+    };
+
+    using ThreadTree = boost::intrusive::multiset<
+        Thread,
+        boost::intrusive::member_hook<Thread, decltype(Thread::arbiter_hook),
+                                      &Thread::arbiter_hook>,
+        boost::intrusive::compare<ThreadCompare>, boost::intrusive::constant_time_size<false>>;
+
     /// Signals an address being waited on.
     ResultCode SignalToAddressOnly(VAddr address, s32 num_to_wake);
 
@@ -76,20 +107,14 @@ private:
     // Waits on the given address with a timeout in nanoseconds
     ResultCode WaitForAddressImpl(VAddr address, s64 timeout);
 
-    /// Wake up num_to_wake (or all) threads in a vector.
-    void WakeThreads(const std::vector<std::shared_ptr<Thread>>& waiting_threads, s32 num_to_wake);
-
-    /// Insert a thread into the address arbiter container
-    void InsertThread(std::shared_ptr<Thread> thread);
-
-    /// Removes a thread from the address arbiter container
-    void RemoveThread(std::shared_ptr<Thread> thread);
+    /// Wake up num_to_wake (or all) threads waiting on an address, in priority order.
+    void WakeThreads(VAddr address, s32 num_to_wake);
 
-    // Gets the threads waiting on an address.
-    std::vector<std::shared_ptr<Thread>> GetThreadsWaitingOnAddress(VAddr address) const;
+    /// Counts the threads waiting on an address, stopping once max_count is reached.
+    std::size_t CountThreadsWaitingOnAddress(VAddr address, std::size_t max_count) const;
 
-    /// List of threads waiting for a address arbiter
-    std::unordered_map<VAddr, std::list<std::shared_ptr<Thread>>> arb_threads;
+    /// Threads waiting on an address, linked through their own arbiter hook
+    ThreadTree arb_threads;
 
     Core::System& system;
 };
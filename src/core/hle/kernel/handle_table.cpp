@@ -12,15 +12,6 @@
 #include "core/hle/kernel/thread.h"
 
 namespace Kernel {
-namespace {
-constexpr u16 GetSlot(Handle handle) {
-    return static_cast<u16>(handle >> 15);
-}
-
-constexpr u16 GetGeneration(Handle handle) {
-    return static_cast<u16>(handle & 0x7FFF);
-}
-} // Anonymous namespace
 
 HandleTable::HandleTable() {
     Clear();
@@ -114,6 +105,15 @@ std::shared_ptr<Object> HandleTable::GetGeneric(Handle handle) const {
     return objects[GetSlot(handle)];
 }
 
+Object* HandleTable::GetPseudoHandlePointer(Handle handle) {
+    if (handle == CurrentThread) {
+        return GetCurrentThread();
+    } else if (handle == CurrentProcess) {
+        return Core::System::GetInstance().CurrentProcess();
+    }
+    return nullptr;
+}
+
 void HandleTable::Clear() {
     for (u16 i = 0; i < table_size; ++i) {
         generations[i] = i + 1;
@@ -42,6 +42,13 @@ enum KernelHandle : Handle {
  * is destroyed, it is again pushed onto the list to be re-used by the next allocation. It is
  * likely that this allocation strategy differs from the one used in CTR-OS, but this hasn't been
  * verified and isn't likely to cause any problems.
+ *
+ * Handles can either be resolved into a new reference to the object (Get) or into a borrowed
+ * pointer (GetPointer). The latter avoids touching the object's reference count, which matters as
+ * nearly every SVC and IPC message resolves at least one handle. A borrowed pointer is kept alive
+ * by the reference held in the table, and handles can only be closed while holding the HLE lock,
+ * so it remains valid for as long as the caller holds that lock (e.g. for the duration of an SVC)
+ * and does not close the handle itself.
  */
 class HandleTable final : NonCopyable {
 public:
@@ -106,10 +113,45 @@ public:
         return DynamicObjectCast<T>(GetGeneric(handle));
     }
 
+    /**
+     * Looks up a handle without taking a new reference to the object.
+     * @return Borrowed pointer to the looked-up object, or `nullptr` if the handle is not valid.
+     *         The pointer is only valid while the HLE lock is held and the handle is not closed.
+     */
+    Object* GetGenericPointer(Handle handle) const {
+        const u16 slot = GetSlot(handle);
+        if (slot < table_size && generations[slot] == GetGeneration(handle)) {
+            // Free slots hold a null object, so a stale free list index can not match here.
+            return objects[slot].get();
+        }
+        return GetPseudoHandlePointer(handle);
+    }
+
+    /**
+     * Looks up a handle while verifying its type, without taking a new reference to the object.
+     * @return Borrowed pointer to the looked-up object, or `nullptr` if the handle is not valid or
+     *         its type differs from the requested one.
+     */
+    template <class T>
+    T* GetPointer(Handle handle) const {
+        return DynamicObjectCast<T>(GetGenericPointer(handle));
+    }
+
     /// Closes all handles held in this table.
     void Clear();
 
 private:
+    static constexpr u16 GetSlot(Handle handle) {
+        return static_cast<u16>(handle >> 15);
+    }
+
+    static constexpr u16 GetGeneration(Handle handle) {
+        return static_cast<u16>(handle & 0x7FFF);
+    }
+
+    /// Resolves the CurrentThread and CurrentProcess pseudo-handles, or returns `nullptr`.
+    static Object* GetPseudoHandlePointer(Handle handle);
+
     /// Stores the Object referenced by the handle or null if the slot is empty.
     std::array<std::shared_ptr<Object>, MAX_COUNT> objects;
 
@@ -66,7 +66,6 @@ std::shared_ptr<WritableEvent> HLERequestContext::SleepClientThread(
     writable_event->Clear();
     thread->SetStatus(ThreadStatus::WaitHLEEvent);
     thread->SetSynchronizationObjects({readable_event});
-    readable_event->AddWaitingThread(thread);
 
     if (timeout > 0) {
         thread->WakeAfterDelay(timeout);
@@ -301,6 +300,34 @@ std::vector<u8> HLERequestContext::ReadBuffer(std::size_t buffer_index) const {
     return buffer;
 }
 
+Common::Span<const u8> HLERequestContext::ReadBufferSpan(ScratchBuffer& scratch,
+                                                        std::size_t buffer_index) const {
+    const bool is_buffer_a{BufferDescriptorA().size() > buffer_index &&
+                           BufferDescriptorA()[buffer_index].Size()};
+
+    VAddr address;
+    std::size_t size;
+    if (is_buffer_a) {
+        address = BufferDescriptorA()[buffer_index].Address();
+        size = BufferDescriptorA()[buffer_index].Size();
+    } else {
+        ASSERT_MSG(BufferDescriptorX().size() > buffer_index,
+                   "BufferDescriptorX invalid buffer_index {}", buffer_index);
+        address = BufferDescriptorX()[buffer_index].Address();
+        size = BufferDescriptorX()[buffer_index].Size();
+    }
+
+    if (size == 0) {
+        return {};
+    }
+    if (const u8* const pointer = memory.GetContiguousPointer(address, size)) {
+        return {pointer, size};
+    }
+    scratch.resize(size);
+    memory.ReadBlock(address, scratch.data(), size);
+    return scratch;
+}
+
 std::size_t HLERequestContext::WriteBuffer(const void* buffer, std::size_t size,
                                            std::size_t buffer_index) const {
     if (size == 0) {
@@ -13,6 +13,7 @@
 #include <vector>
 #include <boost/container/small_vector.hpp>
 #include "common/common_types.h"
+#include "common/span.h"
 #include "common/swap.h"
 #include "core/hle/ipc.h"
 #include "core/hle/kernel/object.h"
@@ -35,12 +36,17 @@ class HLERequestContext;
 class KernelCore;
 class Process;
 class ServerSession;
+class ServiceThread;
 class Thread;
 class ReadableEvent;
 class WritableEvent;
 
 enum class ThreadWakeupReason;
 
+/// Storage for request buffers that have to be copied, large enough to hold the parameter
+/// structures of most requests without allocating.
+using ScratchBuffer = boost::container::small_vector<u8, 0x100>;
+
 /**
  * Interface implemented by HLE Session handlers.
  * This can be provided to a ServerSession in order to hook into several relevant events
@@ -75,11 +81,22 @@ public:
      */
     void ClientDisconnected(const std::shared_ptr<ServerSession>& server_session);
 
+    /**
+     * Gets the host thread that requests to this handler are executed on, or nullptr if they are
+     * executed inline on the emulated CPU core that issued them.
+     */
+    ServiceThread* GetServiceThread() const {
+        return service_thread.get();
+    }
+
 protected:
     /// List of sessions that are connected to this handler.
     /// A ServerSession whose server endpoint is an HLE implementation is kept alive by this list
     /// for the duration of the connection.
     std::vector<std::shared_ptr<ServerSession>> connected_sessions;
+
+    /// Host thread that requests are executed on, if the handler opted into one.
+    std::shared_ptr<ServiceThread> service_thread;
 };
 
 /**
@@ -187,6 +204,14 @@ public:
     /// Helper function to read a buffer using the appropriate buffer descriptor
     std::vector<u8> ReadBuffer(std::size_t buffer_index = 0) const;
 
+    /**
+     * Helper function to read a buffer in place using the appropriate buffer descriptor. Buffers
+     * that are not contiguous in host memory are copied into the given scratch buffer instead.
+     * The returned span is only valid until guest memory or the scratch buffer are modified.
+     */
+    Common::Span<const u8> ReadBufferSpan(ScratchBuffer& scratch,
+                                          std::size_t buffer_index = 0) const;
+
     /// Helper function to write a buffer using the appropriate buffer descriptor
     std::size_t WriteBuffer(const void* buffer, std::size_t size,
                             std::size_t buffer_index = 0) const;
@@ -26,11 +26,13 @@
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/memory/memory_layout.h"
 #include "core/hle/kernel/memory/memory_manager.h"
+#include "core/hle/kernel/memory/page_table.h"
 #include "core/hle/kernel/memory/slab_heap.h"
 #include "core/hle/kernel/physical_core.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/resource_limit.h"
 #include "core/hle/kernel/scheduler.h"
+#include "core/hle/kernel/service_thread.h"
 #include "core/hle/kernel/shared_memory.h"
 #include "core/hle/kernel/synchronization.h"
 #include "core/hle/kernel/thread.h"
@@ -65,9 +67,6 @@ static void ThreadWakeupCallback(u64 thread_handle, [[maybe_unused]] s64 cycles_
     if (thread->GetStatus() == ThreadStatus::WaitSynch ||
         thread->GetStatus() == ThreadStatus::WaitHLEEvent) {
         // Remove the thread from each of its waiting objects' waitlists
-        for (const auto& object : thread->GetSynchronizationObjects()) {
-            object->RemoveWaitingThread(thread);
-        }
         thread->ClearSynchronizationObjects();
 
         // Invoke the wakeup callback before clearing the wait objects
@@ -94,7 +93,7 @@ static void ThreadWakeupCallback(u64 thread_handle, [[maybe_unused]] s64 cycles_
 
     if (thread->GetStatus() == ThreadStatus::WaitArb) {
         auto& address_arbiter = thread->GetOwnerProcess()->GetAddressArbiter();
-        address_arbiter.HandleWakeupThread(thread);
+        address_arbiter.HandleWakeupThread(*thread);
     }
 
     if (resume) {
@@ -145,6 +144,18 @@ struct KernelCore::Impl {
         cores.clear();
 
         exclusive_monitor.reset();
+
+        {
+            std::unique_lock lock{register_thread_mutex};
+            host_thread_ids.clear();
+            registered_core_threads.reset();
+            registered_thread_ids = Core::Hardware::NUM_CPU_CORES;
+        }
+
+        {
+            std::scoped_lock lock{service_threads_mutex};
+            service_threads.clear();
+        }
     }
 
     void InitializePhysicalCores() {
@@ -197,11 +208,14 @@ struct KernelCore::Impl {
             return;
         }
 
+        system.Memory().SetCurrentPageTable(*process);
+
+        auto& page_table = process->PageTable();
         for (auto& core : cores) {
             core.SetIs64Bit(process->Is64BitProcess());
+            core.ArmInterface().PageTableChanged(page_table.PageTableImpl(),
+                                                 page_table.GetAddressSpaceWidth());
         }
-
-        system.Memory().SetCurrentPageTable(*process);
     }
 
     void RegisterCoreThread(std::size_t core_id) {
@@ -333,6 +347,10 @@ struct KernelCore::Impl {
     std::bitset<Core::Hardware::NUM_CPU_CORES> registered_core_threads;
     std::mutex register_thread_mutex;
 
+    // Host threads running HLE service requests, owned by the handlers that use them
+    std::unordered_map<std::string, std::weak_ptr<Kernel::ServiceThread>> service_threads;
+    std::mutex service_threads_mutex;
+
     // Kernel memory management
     std::unique_ptr<Memory::MemoryManager> memory_manager;
     std::unique_ptr<Memory::SlabHeap<Memory::Page>> user_slab_heap_pages;
@@ -443,7 +461,8 @@ void KernelCore::InvalidateAllInstructionCaches() {
 }
 
 void KernelCore::PrepareReschedule(std::size_t id) {
-    if (id < impl->global_scheduler.CpuCoresCount()) {
+    // The cores only exist once the kernel has been initialized
+    if (id < impl->cores.size()) {
         impl->cores[id].Stop();
     }
 }
@@ -557,4 +576,16 @@ const Kernel::SharedMemory& KernelCore::GetTimeSharedMem() const {
     return *impl->time_shared_mem;
 }
 
+std::shared_ptr<ServiceThread> KernelCore::GetServiceThread(const std::string& name) {
+    std::scoped_lock lock{impl->service_threads_mutex};
+    auto& entry = impl->service_threads[name];
+    if (auto service_thread = entry.lock()) {
+        return service_thread;
+    }
+
+    auto service_thread = std::make_shared<ServiceThread>(name);
+    entry = service_thread;
+    return service_thread;
+}
+
 } // namespace Kernel
@@ -38,6 +38,7 @@ class PhysicalCore;
 class Process;
 class ResourceLimit;
 class Scheduler;
+class ServiceThread;
 class SharedMemory;
 class Synchronization;
 class Thread;
@@ -191,6 +192,10 @@ public:
     /// Gets the shared memory object for Time services.
     const Kernel::SharedMemory& GetTimeSharedMem() const;
 
+    /// Gets the host service thread with the given name, creating it if it does not exist yet.
+    /// The thread is destroyed once every handler using it has been released.
+    std::shared_ptr<ServiceThread> GetServiceThread(const std::string& name);
+
 private:
     friend class Object;
     friend class Process;
@@ -196,7 +196,7 @@ struct MemoryInfo {
     }
 };
 
-class MemoryBlock final {
+class MemoryBlock {
     friend class MemoryBlockManager;
 
 private:
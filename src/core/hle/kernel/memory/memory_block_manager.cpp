@@ -10,18 +10,19 @@ namespace Kernel::Memory {
 MemoryBlockManager::MemoryBlockManager(VAddr start_addr, VAddr end_addr)
     : start_addr{start_addr}, end_addr{end_addr} {
     const u64 num_pages{(end_addr - start_addr) / PageSize};
-    memory_block_tree.emplace_back(start_addr, num_pages, MemoryState::Free, MemoryPermission::None,
-                                   MemoryAttribute::None);
+    memory_block_tree.insert(*new MemoryBlockNode{{start_addr, num_pages, MemoryState::Free,
+                                                   MemoryPermission::None, MemoryAttribute::None}});
+}
+
+MemoryBlockManager::~MemoryBlockManager() {
+    memory_block_tree.clear_and_dispose([](MemoryBlockNode* node) { delete node; });
 }
 
 MemoryBlockManager::iterator MemoryBlockManager::FindIterator(VAddr addr) {
-    auto node{memory_block_tree.begin()};
-    while (node != end()) {
-        const VAddr end_addr{node->GetNumPages() * PageSize + node->GetAddress()};
-        if (node->GetAddress() <= addr && end_addr - 1 >= addr) {
-            return node;
-        }
-        node = std::next(node);
+    // The first block ending at or after the address is the one containing it, if any.
+    const auto node{memory_block_tree.lower_bound(addr, MemoryBlockCompare{})};
+    if (node != end() && node->GetAddress() <= addr) {
+        return node;
     }
     return end();
 }
@@ -35,7 +36,7 @@ VAddr MemoryBlockManager::FindFreeArea(VAddr region_start, std::size_t region_nu
 
     const VAddr region_end{region_start + region_num_pages * PageSize};
     const VAddr region_last{region_end - 1};
-    for (auto it{FindIterator(region_start)}; it != memory_block_tree.cend(); it++) {
+    for (auto it{FindIterator(region_start)}; it != end(); it++) {
         const auto info{it->GetMemoryInfo()};
         if (region_last < info.GetAddress()) {
             break;
@@ -68,7 +69,7 @@ void MemoryBlockManager::Update(VAddr addr, std::size_t num_pages, MemoryState p
                                 MemoryState state, MemoryPermission perm,
                                 MemoryAttribute attribute) {
     const VAddr end_addr{addr + num_pages * PageSize};
-    iterator node{memory_block_tree.begin()};
+    iterator node{FindIterator(addr)};
 
     prev_attribute |= MemoryAttribute::IpcAndDeviceMapped;
 
@@ -86,11 +87,11 @@ void MemoryBlockManager::Update(VAddr addr, std::size_t num_pages, MemoryState p
 
             iterator new_node{node};
             if (addr > cur_addr) {
-                memory_block_tree.insert(node, block->Split(addr));
+                InsertBefore(node, block->Split(addr));
             }
 
             if (end_addr < cur_end_addr) {
-                new_node = memory_block_tree.insert(node, block->Split(end_addr));
+                new_node = InsertBefore(node, block->Split(end_addr));
             }
 
             new_node->Update(state, perm, attribute);
@@ -109,7 +110,7 @@ void MemoryBlockManager::Update(VAddr addr, std::size_t num_pages, MemoryState p
 void MemoryBlockManager::Update(VAddr addr, std::size_t num_pages, MemoryState state,
                                 MemoryPermission perm, MemoryAttribute attribute) {
     const VAddr end_addr{addr + num_pages * PageSize};
-    iterator node{memory_block_tree.begin()};
+    iterator node{FindIterator(addr)};
 
     while (node != memory_block_tree.end()) {
         MemoryBlock* block{&(*node)};
@@ -121,11 +122,11 @@ void MemoryBlockManager::Update(VAddr addr, std::size_t num_pages, MemoryState s
             iterator new_node{node};
 
             if (addr > cur_addr) {
-                memory_block_tree.insert(node, block->Split(addr));
+                InsertBefore(node, block->Split(addr));
             }
 
             if (end_addr < cur_end_addr) {
-                new_node = memory_block_tree.insert(node, block->Split(end_addr));
+                new_node = InsertBefore(node, block->Split(end_addr));
             }
 
             new_node->Update(state, perm, attribute);
@@ -144,7 +145,7 @@ void MemoryBlockManager::Update(VAddr addr, std::size_t num_pages, MemoryState s
 void MemoryBlockManager::UpdateLock(VAddr addr, std::size_t num_pages, LockFunc&& lock_func,
                                     MemoryPermission perm) {
     const VAddr end_addr{addr + num_pages * PageSize};
-    iterator node{memory_block_tree.begin()};
+    iterator node{FindIterator(addr)};
 
     while (node != memory_block_tree.end()) {
         MemoryBlock* block{&(*node)};
@@ -156,11 +157,11 @@ void MemoryBlockManager::UpdateLock(VAddr addr, std::size_t num_pages, LockFunc&
             iterator new_node{node};
 
             if (addr > cur_addr) {
-                memory_block_tree.insert(node, block->Split(addr));
+                InsertBefore(node, block->Split(addr));
             }
 
             if (end_addr < cur_end_addr) {
-                new_node = memory_block_tree.insert(node, block->Split(end_addr));
+                new_node = InsertBefore(node, block->Split(end_addr));
             }
 
             lock_func(new_node, perm);
@@ -186,6 +187,15 @@ void MemoryBlockManager::IterateForRange(VAddr start, VAddr end, IterateFunc&& f
     } while (info.addr + info.size - 1 < end - 1 && it != cend());
 }
 
+MemoryBlockManager::iterator MemoryBlockManager::InsertBefore(iterator pos,
+                                                             const MemoryBlock& block) {
+    return memory_block_tree.insert_before(pos, *new MemoryBlockNode{block});
+}
+
+void MemoryBlockManager::Erase(iterator it) {
+    memory_block_tree.erase_and_dispose(it, [](MemoryBlockNode* node) { delete node; });
+}
+
 void MemoryBlockManager::MergeAdjacent(iterator it, iterator& next_it) {
     MemoryBlock* block{&(*it)};
 
@@ -193,7 +203,7 @@ void MemoryBlockManager::MergeAdjacent(iterator it, iterator& next_it) {
         if (next_it == it_to_erase) {
             next_it = std::next(next_it);
         }
-        memory_block_tree.erase(it_to_erase);
+        Erase(it_to_erase);
     };
 
     if (it != memory_block_tree.begin()) {
@@ -210,7 +220,7 @@ void MemoryBlockManager::MergeAdjacent(iterator it, iterator& next_it) {
         }
     }
 
-    if (it != cend()) {
+    if (std::next(it) != end()) {
         const MemoryBlock* const next{&(*std::next(it))};
 
         if (block->HasSameProperties(*next)) {
@@ -5,21 +5,48 @@
 #pragma once
 
 #include <functional>
-#include <list>
+
+#include <boost/intrusive/set.hpp>
 
 #include "common/common_types.h"
 #include "core/hle/kernel/memory/memory_block.h"
 
 namespace Kernel::Memory {
 
-class MemoryBlockManager final {
+/**
+ * Tracks the state of every page in an address space as a set of contiguous, non-overlapping
+ * blocks. Like the KMemoryBlockTree in the real kernel, the blocks are kept in a red-black tree
+ * ordered by address, so looking up, splitting and merging blocks is logarithmic in the number of
+ * blocks rather than linear, no matter how fragmented the address space gets.
+ */
+class MemoryBlockManager final : NonCopyable {
+private:
+    /// Tree node holding a MemoryBlock, which keeps MemoryBlock itself trivially destructible.
+    struct MemoryBlockNode final
+        : MemoryBlock,
+          boost::intrusive::set_base_hook<boost::intrusive::optimize_size<true>> {
+        explicit MemoryBlockNode(const MemoryBlock& block) : MemoryBlock{block} {}
+    };
+
+    struct MemoryBlockCompare {
+        bool operator()(const MemoryBlock& lhs, const MemoryBlock& rhs) const {
+            return lhs.GetAddress() < rhs.GetAddress();
+        }
+        bool operator()(const MemoryBlock& lhs, VAddr rhs) const {
+            return lhs.GetLastAddress() < rhs;
+        }
+    };
+
 public:
-    using MemoryBlockTree = std::list<MemoryBlock>;
+    using MemoryBlockTree =
+        boost::intrusive::set<MemoryBlockNode, boost::intrusive::compare<MemoryBlockCompare>,
+                              boost::intrusive::constant_time_size<false>>;
     using iterator = MemoryBlockTree::iterator;
     using const_iterator = MemoryBlockTree::const_iterator;
 
 public:
     MemoryBlockManager(VAddr start_addr, VAddr end_addr);
+    ~MemoryBlockManager();
 
     iterator end() {
         return memory_block_tree.end();
@@ -55,6 +82,12 @@ public:
     }
 
 private:
+    /// Inserts a copy of the given block in front of pos, which it must directly precede.
+    iterator InsertBefore(iterator pos, const MemoryBlock& block);
+
+    /// Removes the given block from the tree and frees it.
+    void Erase(iterator it);
+
     void MergeAdjacent(iterator it, iterator& next_it);
 
     const VAddr start_addr;
@@ -83,4 +83,16 @@ inline std::shared_ptr<T> DynamicObjectCast(std::shared_ptr<Object> object) {
     return nullptr;
 }
 
+/**
+ * Attempts to downcast the given borrowed Object pointer to a pointer to T.
+ * @return Derived pointer to the object, or `nullptr` if `object` isn't of type T.
+ */
+template <typename T>
+inline T* DynamicObjectCast(Object* object) {
+    if (object != nullptr && object->GetHandleType() == T::HANDLE_TYPE) {
+        return static_cast<T*>(object);
+    }
+    return nullptr;
+}
+
 } // namespace Kernel
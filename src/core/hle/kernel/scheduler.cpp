@@ -6,6 +6,7 @@
 // licensed under GPLv2 or later under exception provided by the author.
 
 #include <algorithm>
+#include <mutex>
 #include <set>
 #include <unordered_set>
 #include <utility>
@@ -54,25 +55,29 @@ void GlobalScheduler::SelectThread(std::size_t core) {
     Scheduler& sched = kernel.Scheduler(core);
     Thread* current_thread = nullptr;
     // Step 1: Get top thread in schedule queue.
-    current_thread = scheduled_queue[core].empty() ? nullptr : scheduled_queue[core].front();
+    current_thread = GetFrontThread(core);
     if (current_thread) {
         update_thread(current_thread, sched);
         return;
     }
     // Step 2: Try selecting a suggested thread.
+    const auto current_threads = GetFrontThreads();
     Thread* winner = nullptr;
     std::set<s32> sug_cores;
-    for (auto thread : suggested_queue[core]) {
-        s32 this_core = thread->GetProcessorID();
-        Thread* thread_on_core = nullptr;
-        if (this_core >= 0) {
-            thread_on_core = scheduled_queue[this_core].front();
-        }
-        if (this_core < 0 || thread != thread_on_core) {
-            winner = thread;
-            break;
+    {
+        std::scoped_lock lock{queue_locks[core]};
+        for (auto thread : suggested_queue[core]) {
+            s32 this_core = thread->GetProcessorID();
+            Thread* thread_on_core = nullptr;
+            if (this_core >= 0) {
+                thread_on_core = current_threads[this_core];
+            }
+            if (this_core < 0 || thread != thread_on_core) {
+                winner = thread;
+                break;
+            }
+            sug_cores.insert(this_core);
         }
-        sug_cores.insert(this_core);
     }
     // if we got a suggested thread, select it, else do a second pass.
     if (winner && winner->GetPriority() > 2) {
@@ -85,11 +90,18 @@ void GlobalScheduler::SelectThread(std::size_t core) {
     }
     // Step 3: Select a suggested thread from another core
     for (auto& src_core : sug_cores) {
-        auto it = scheduled_queue[src_core].begin();
-        it++;
-        if (it != scheduled_queue[src_core].end()) {
-            Thread* thread_on_core = scheduled_queue[src_core].front();
-            Thread* to_change = *it;
+        Thread* thread_on_core = nullptr;
+        Thread* to_change = nullptr;
+        {
+            std::scoped_lock lock{queue_locks[src_core]};
+            auto it = scheduled_queue[src_core].begin();
+            it++;
+            if (it != scheduled_queue[src_core].end()) {
+                thread_on_core = scheduled_queue[src_core].front();
+                to_change = *it;
+            }
+        }
+        if (thread_on_core != nullptr) {
             if (thread_on_core->IsRunning() || to_change->IsRunning()) {
                 UnloadThread(static_cast<u32>(src_core));
             }
@@ -107,9 +119,13 @@ bool GlobalScheduler::YieldThread(Thread* yielding_thread) {
     const u32 priority = yielding_thread->GetPriority();
 
     // Yield the thread
-    const Thread* const winner = scheduled_queue[core_id].front(priority);
-    ASSERT_MSG(yielding_thread == winner, "Thread yielding without being in front");
-    scheduled_queue[core_id].yield(priority);
+    const Thread* winner = nullptr;
+    {
+        std::scoped_lock lock{queue_locks[core_id]};
+        winner = scheduled_queue[core_id].front(priority);
+        ASSERT_MSG(yielding_thread == winner, "Thread yielding without being in front");
+        scheduled_queue[core_id].yield(priority);
+    }
 
     return AskForReselectionOrMarkRedundant(yielding_thread, winner);
 }
@@ -121,32 +137,35 @@ bool GlobalScheduler::YieldThreadAndBalanceLoad(Thread* yielding_thread) {
     const u32 priority = yielding_thread->GetPriority();
 
     // Yield the thread
-    ASSERT_MSG(yielding_thread == scheduled_queue[core_id].front(priority),
-               "Thread yielding without being in front");
-    scheduled_queue[core_id].yield(priority);
-
-    std::array<Thread*, Core::Hardware::NUM_CPU_CORES> current_threads;
-    for (std::size_t i = 0; i < current_threads.size(); i++) {
-        current_threads[i] = scheduled_queue[i].empty() ? nullptr : scheduled_queue[i].front();
+    Thread* next_thread = nullptr;
+    {
+        std::scoped_lock lock{queue_locks[core_id]};
+        ASSERT_MSG(yielding_thread == scheduled_queue[core_id].front(priority),
+                   "Thread yielding without being in front");
+        scheduled_queue[core_id].yield(priority);
+        next_thread = scheduled_queue[core_id].front(priority);
     }
 
-    Thread* next_thread = scheduled_queue[core_id].front(priority);
+    const auto current_threads = GetFrontThreads();
     Thread* winner = nullptr;
-    for (auto& thread : suggested_queue[core_id]) {
-        const s32 source_core = thread->GetProcessorID();
-        if (source_core >= 0) {
-            if (current_threads[source_core] != nullptr) {
-                if (thread == current_threads[source_core] ||
-                    current_threads[source_core]->GetPriority() < min_regular_priority) {
-                    continue;
+    {
+        std::scoped_lock lock{queue_locks[core_id]};
+        for (auto& thread : suggested_queue[core_id]) {
+            const s32 source_core = thread->GetProcessorID();
+            if (source_core >= 0) {
+                if (current_threads[source_core] != nullptr) {
+                    if (thread == current_threads[source_core] ||
+                        current_threads[source_core]->GetPriority() < min_regular_priority) {
+                        continue;
+                    }
                 }
             }
-        }
-        if (next_thread->GetLastRunningTicks() >= thread->GetLastRunningTicks() ||
-            next_thread->GetPriority() < thread->GetPriority()) {
-            if (thread->GetPriority() <= priority) {
-                winner = thread;
-                break;
+            if (next_thread->GetLastRunningTicks() >= thread->GetLastRunningTicks() ||
+                next_thread->GetPriority() < thread->GetPriority()) {
+                if (thread->GetPriority() <= priority) {
+                    winner = thread;
+                    break;
+                }
             }
         }
     }
@@ -176,22 +195,22 @@ bool GlobalScheduler::YieldThreadAndWaitForLoadBalancing(Thread* yielding_thread
 
     // If the core is idle, perform load balancing, excluding the threads that have just used this
     // function...
-    if (scheduled_queue[core_id].empty()) {
+    if (GetFrontThread(core_id) == nullptr) {
         // Here, "current_threads" is calculated after the ""yield"", unlike yield -1
-        std::array<Thread*, Core::Hardware::NUM_CPU_CORES> current_threads;
-        for (std::size_t i = 0; i < current_threads.size(); i++) {
-            current_threads[i] = scheduled_queue[i].empty() ? nullptr : scheduled_queue[i].front();
-        }
-        for (auto& thread : suggested_queue[core_id]) {
-            const s32 source_core = thread->GetProcessorID();
-            if (source_core < 0 || thread == current_threads[source_core]) {
-                continue;
-            }
-            if (current_threads[source_core] == nullptr ||
-                current_threads[source_core]->GetPriority() >= min_regular_priority) {
-                winner = thread;
+        const auto current_threads = GetFrontThreads();
+        {
+            std::scoped_lock lock{queue_locks[core_id]};
+            for (auto& thread : suggested_queue[core_id]) {
+                const s32 source_core = thread->GetProcessorID();
+                if (source_core < 0 || thread == current_threads[source_core]) {
+                    continue;
+                }
+                if (current_threads[source_core] == nullptr ||
+                    current_threads[source_core]->GetPriority() >= min_regular_priority) {
+                    winner = thread;
+                }
+                break;
             }
-            break;
         }
         if (winner != nullptr) {
             if (winner != yielding_thread) {
@@ -212,37 +231,41 @@ void GlobalScheduler::PreemptThreads() {
     for (std::size_t core_id = 0; core_id < Core::Hardware::NUM_CPU_CORES; core_id++) {
         const u32 priority = preemption_priorities[core_id];
 
-        if (scheduled_queue[core_id].size(priority) > 0) {
-            scheduled_queue[core_id].front(priority)->IncrementYieldCount();
-            scheduled_queue[core_id].yield(priority);
-            if (scheduled_queue[core_id].size(priority) > 1) {
+        {
+            std::scoped_lock lock{queue_locks[core_id]};
+            if (scheduled_queue[core_id].size(priority) > 0) {
                 scheduled_queue[core_id].front(priority)->IncrementYieldCount();
+                scheduled_queue[core_id].yield(priority);
+                if (scheduled_queue[core_id].size(priority) > 1) {
+                    scheduled_queue[core_id].front(priority)->IncrementYieldCount();
+                }
             }
         }
 
-        Thread* current_thread =
-            scheduled_queue[core_id].empty() ? nullptr : scheduled_queue[core_id].front();
+        Thread* current_thread = GetFrontThread(core_id);
         Thread* winner = nullptr;
-        for (auto& thread : suggested_queue[core_id]) {
-            const s32 source_core = thread->GetProcessorID();
-            if (thread->GetPriority() != priority) {
-                continue;
-            }
-            if (source_core >= 0) {
-                Thread* next_thread = scheduled_queue[source_core].empty()
-                                          ? nullptr
-                                          : scheduled_queue[source_core].front();
-                if (next_thread != nullptr && next_thread->GetPriority() < 2) {
-                    break;
-                }
-                if (next_thread == thread) {
+        {
+            const auto next_threads = GetFrontThreads();
+            std::scoped_lock lock{queue_locks[core_id]};
+            for (auto& thread : suggested_queue[core_id]) {
+                const s32 source_core = thread->GetProcessorID();
+                if (thread->GetPriority() != priority) {
                     continue;
                 }
-            }
-            if (current_thread != nullptr &&
-                current_thread->GetLastRunningTicks() >= thread->GetLastRunningTicks()) {
-                winner = thread;
-                break;
+                if (source_core >= 0) {
+                    Thread* next_thread = next_threads[source_core];
+                    if (next_thread != nullptr && next_thread->GetPriority() < 2) {
+                        break;
+                    }
+                    if (next_thread == thread) {
+                        continue;
+                    }
+                }
+                if (current_thread != nullptr &&
+                    current_thread->GetLastRunningTicks() >= thread->GetLastRunningTicks()) {
+                    winner = thread;
+                    break;
+                }
             }
         }
 
@@ -256,26 +279,28 @@ void GlobalScheduler::PreemptThreads() {
         }
 
         if (current_thread != nullptr && current_thread->GetPriority() > priority) {
-            for (auto& thread : suggested_queue[core_id]) {
-                const s32 source_core = thread->GetProcessorID();
-                if (thread->GetPriority() < priority) {
-                    continue;
-                }
-                if (source_core >= 0) {
-                    Thread* next_thread = scheduled_queue[source_core].empty()
-                                              ? nullptr
-                                              : scheduled_queue[source_core].front();
-                    if (next_thread != nullptr && next_thread->GetPriority() < 2) {
-                        break;
-                    }
-                    if (next_thread == thread) {
+            {
+                const auto next_threads = GetFrontThreads();
+                std::scoped_lock lock{queue_locks[core_id]};
+                for (auto& thread : suggested_queue[core_id]) {
+                    const s32 source_core = thread->GetProcessorID();
+                    if (thread->GetPriority() < priority) {
                         continue;
                     }
-                }
-                if (current_thread != nullptr &&
-                    current_thread->GetLastRunningTicks() >= thread->GetLastRunningTicks()) {
-                    winner = thread;
-                    break;
+                    if (source_core >= 0) {
+                        Thread* next_thread = next_threads[source_core];
+                        if (next_thread != nullptr && next_thread->GetPriority() < 2) {
+                            break;
+                        }
+                        if (next_thread == thread) {
+                            continue;
+                        }
+                    }
+                    if (current_thread != nullptr &&
+                        current_thread->GetLastRunningTicks() >= thread->GetLastRunningTicks()) {
+                        winner = thread;
+                        break;
+                    }
                 }
             }
 
@@ -293,29 +318,35 @@ void GlobalScheduler::PreemptThreads() {
 }
 
 void GlobalScheduler::Suggest(u32 priority, std::size_t core, Thread* thread) {
+    std::scoped_lock lock{queue_locks[core]};
     suggested_queue[core].add(thread, priority);
 }
 
 void GlobalScheduler::Unsuggest(u32 priority, std::size_t core, Thread* thread) {
+    std::scoped_lock lock{queue_locks[core]};
     suggested_queue[core].remove(thread, priority);
 }
 
 void GlobalScheduler::Schedule(u32 priority, std::size_t core, Thread* thread) {
     ASSERT_MSG(thread->GetProcessorID() == s32(core), "Thread must be assigned to this core.");
+    std::scoped_lock lock{queue_locks[core]};
     scheduled_queue[core].add(thread, priority);
 }
 
 void GlobalScheduler::SchedulePrepend(u32 priority, std::size_t core, Thread* thread) {
     ASSERT_MSG(thread->GetProcessorID() == s32(core), "Thread must be assigned to this core.");
+    std::scoped_lock lock{queue_locks[core]};
     scheduled_queue[core].add(thread, priority, false);
 }
 
 void GlobalScheduler::Reschedule(u32 priority, std::size_t core, Thread* thread) {
+    std::scoped_lock lock{queue_locks[core]};
     scheduled_queue[core].remove(thread, priority);
     scheduled_queue[core].add(thread, priority);
 }
 
 void GlobalScheduler::Unschedule(u32 priority, std::size_t core, Thread* thread) {
+    std::scoped_lock lock{queue_locks[core]};
     scheduled_queue[core].remove(thread, priority);
 }
 
@@ -326,15 +357,23 @@ void GlobalScheduler::TransferToCore(u32 priority, s32 destination_core, Thread*
         return;
     }
     thread->SetProcessorID(destination_core);
+
+    // The thread's queue nodes are spliced between the scheduled and suggested queues of each
+    // core, so migrating never allocates. Each core is locked on its own, as a thread is never
+    // spliced across cores.
     if (source_core >= 0) {
-        Unschedule(priority, static_cast<u32>(source_core), thread);
+        const auto core = static_cast<u32>(source_core);
+        std::scoped_lock lock{queue_locks[core]};
+        if (!scheduled_queue[core].transfer_to_back(thread, priority, suggested_queue[core])) {
+            suggested_queue[core].add(thread, priority);
+        }
     }
     if (destination_core >= 0) {
-        Unsuggest(priority, static_cast<u32>(destination_core), thread);
-        Schedule(priority, static_cast<u32>(destination_core), thread);
-    }
-    if (source_core >= 0) {
-        Suggest(priority, static_cast<u32>(source_core), thread);
+        const auto core = static_cast<u32>(destination_core);
+        std::scoped_lock lock{queue_locks[core]};
+        if (!suggested_queue[core].transfer_to_back(thread, priority, scheduled_queue[core])) {
+            scheduled_queue[core].add(thread, priority);
+        }
     }
 }
 
@@ -349,8 +388,27 @@ bool GlobalScheduler::AskForReselectionOrMarkRedundant(Thread* current_thread,
     }
 }
 
+bool GlobalScheduler::HaveReadyThreads(std::size_t core_id) const {
+    std::scoped_lock lock{queue_locks[core_id]};
+    return !scheduled_queue[core_id].empty();
+}
+
+Thread* GlobalScheduler::GetFrontThread(std::size_t core) const {
+    std::scoped_lock lock{queue_locks[core]};
+    return scheduled_queue[core].empty() ? nullptr : scheduled_queue[core].front();
+}
+
+std::array<Thread*, Core::Hardware::NUM_CPU_CORES> GlobalScheduler::GetFrontThreads() const {
+    std::array<Thread*, Core::Hardware::NUM_CPU_CORES> front_threads;
+    for (std::size_t core = 0; core < front_threads.size(); core++) {
+        front_threads[core] = GetFrontThread(core);
+    }
+    return front_threads;
+}
+
 void GlobalScheduler::Shutdown() {
     for (std::size_t core = 0; core < Core::Hardware::NUM_CPU_CORES; core++) {
+        std::scoped_lock lock{queue_locks[core]};
         scheduled_queue[core].clear();
         suggested_queue[core].clear();
     }
@@ -358,28 +416,18 @@ void GlobalScheduler::Shutdown() {
 }
 
 void GlobalScheduler::Lock() {
-    Core::EmuThreadHandle current_thread = kernel.GetCurrentEmuThreadID();
-    if (current_thread == current_owner) {
-        ++scope_lock;
-    } else {
-        inner_lock.lock();
-        current_owner = current_thread;
-        ASSERT(current_owner != Core::EmuThreadHandle::InvalidHandle());
-        scope_lock = 1;
-    }
+    const Core::EmuThreadHandle current_thread = kernel.GetCurrentEmuThreadID();
+    ASSERT(current_thread != Core::EmuThreadHandle::InvalidHandle());
+    scheduler_lock.lock(current_thread.GetRaw());
 }
 
 void GlobalScheduler::Unlock() {
-    if (--scope_lock != 0) {
-        ASSERT(scope_lock > 0);
-        return;
-    }
-    for (std::size_t i = 0; i < Core::Hardware::NUM_CPU_CORES; i++) {
-        SelectThread(i);
+    if (scheduler_lock.GetDepth() == 1) {
+        for (std::size_t i = 0; i < Core::Hardware::NUM_CPU_CORES; i++) {
+            SelectThread(i);
+        }
     }
-    current_owner = Core::EmuThreadHandle::InvalidHandle();
-    scope_lock = 1;
-    inner_lock.unlock();
+    scheduler_lock.unlock();
     // TODO(Blinkhawk): Setup the interrupts and change context on current core.
 }
 
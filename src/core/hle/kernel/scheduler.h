@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <memory>
 #include <mutex>
@@ -11,6 +12,7 @@
 
 #include "common/common_types.h"
 #include "common/multi_level_queue.h"
+#include "common/spin_lock.h"
 #include "core/hardware_properties.h"
 #include "core/hle/kernel/thread.h"
 
@@ -88,9 +90,9 @@ public:
      */
     void SelectThread(std::size_t core);
 
-    bool HaveReadyThreads(std::size_t core_id) const {
-        return !scheduled_queue[core_id].empty();
-    }
+    /// Returns whether the given core has threads scheduled, safe to call without the scheduler
+    /// lock.
+    bool HaveReadyThreads(std::size_t core_id) const;
 
     /**
      * Takes a thread and moves it to the back of the it's priority list.
@@ -158,21 +160,30 @@ private:
 
     bool AskForReselectionOrMarkRedundant(Thread* current_thread, const Thread* winner);
 
+    /// Returns the thread at the front of the scheduled queue of a core, or nullptr if the queue
+    /// is empty.
+    Thread* GetFrontThread(std::size_t core) const;
+
+    /// Returns the thread at the front of the scheduled queue of every core.
+    std::array<Thread*, Core::Hardware::NUM_CPU_CORES> GetFrontThreads() const;
+
     static constexpr u32 min_regular_priority = 2;
     std::array<Common::MultiLevelQueue<Thread*, THREADPRIO_COUNT>, Core::Hardware::NUM_CPU_CORES>
         scheduled_queue;
     std::array<Common::MultiLevelQueue<Thread*, THREADPRIO_COUNT>, Core::Hardware::NUM_CPU_CORES>
         suggested_queue;
+    /// Guards the queues of each core, every access to a queue takes the lock of its core. At most
+    /// one of them is held at a time, decisions spanning several cores work on snapshots taken
+    /// through GetFrontThreads.
+    mutable std::array<Common::SpinLock, Core::Hardware::NUM_CPU_CORES> queue_locks;
     std::atomic<bool> is_reselection_pending{false};
 
     // The priority levels at which the global scheduler preempts threads every 10 ms. They are
     // ordered from Core 0 to Core 3.
     std::array<u32, Core::Hardware::NUM_CPU_CORES> preemption_priorities = {59, 59, 59, 62};
 
-    /// Scheduler lock mechanisms.
-    std::mutex inner_lock{}; // TODO(Blinkhawk): Replace for a SpinLock
-    std::atomic<s64> scope_lock{};
-    Core::EmuThreadHandle current_owner{Core::EmuThreadHandle::InvalidHandle()};
+    /// Scheduler lock, owned by the raw EmuThreadHandle of the thread holding it.
+    Common::RecursiveSpinLock scheduler_lock;
 
     /// Lists all thread ids that aren't deleted/etc.
     std::vector<std::shared_ptr<Thread>> thread_list;
@@ -18,8 +18,10 @@
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/server_session.h"
+#include "core/hle/kernel/service_thread.h"
 #include "core/hle/kernel/session.h"
 #include "core/hle/kernel/thread.h"
+#include "core/hle/lock.h"
 #include "core/memory.h"
 
 namespace Kernel {
@@ -146,9 +148,69 @@ ResultCode ServerSession::QueueSyncRequest(std::shared_ptr<Thread> thread,
     return RESULT_SUCCESS;
 }
 
+std::shared_ptr<SessionRequestHandler> ServerSession::GetRequestHandler(
+    const HLERequestContext& context) const {
+    if (!IsDomain() || !context.HasDomainMessageHeader()) {
+        return hle_handler;
+    }
+
+    // Only messages sent to a valid domain object are handled by that object, everything else
+    // (closing virtual handles, malformed requests) is handled by the domain itself.
+    const auto& domain_message_header = context.GetDomainMessageHeader();
+    const u32 object_id{domain_message_header.object_id};
+    if (domain_message_header.command != IPC::DomainMessageHeader::CommandType::SendMessage ||
+        object_id == 0 || object_id > domain_request_handlers.size()) {
+        return nullptr;
+    }
+    return domain_request_handlers[object_id - 1];
+}
+
+bool ServerSession::TryQueueOnServiceThread(const std::shared_ptr<HLERequestContext>& context) {
+    const auto command_type = context->GetCommandType();
+    if (command_type != IPC::CommandType::Request &&
+        command_type != IPC::CommandType::RequestWithContext) {
+        return false;
+    }
+
+    auto handler = GetRequestHandler(*context);
+    if (handler == nullptr || handler->GetServiceThread() == nullptr) {
+        return false;
+    }
+
+    if (IsDomain()) {
+        context->SetDomainRequestHandlers(domain_request_handlers);
+    }
+
+    auto* const service_thread = handler->GetServiceThread();
+    service_thread->QueueSyncRequest(
+        [this, self = SharedFrom(this), handler = std::move(handler), context] {
+            const ResultCode result = handler->HandleSyncRequest(*context);
+
+            // The guest thread may have been terminated while the request was in flight, in
+            // which case there is nobody left to wake up.
+            std::lock_guard lock{HLE::g_hle_lock};
+            auto& thread = context->GetThread();
+            if (thread.GetStatus() != ThreadStatus::WaitIPC || context->IsThreadWaiting()) {
+                return;
+            }
+            thread.ResumeFromWait();
+            thread.SetWaitSynchronizationResult(result);
+            kernel.PrepareReschedule(static_cast<std::size_t>(thread.GetProcessorID()));
+        });
+    return true;
+}
+
 ResultCode ServerSession::CompleteSyncRequest() {
+    std::lock_guard lock{HLE::g_hle_lock};
     ASSERT(!request_queue.Empty());
 
+    // Requests to handlers with their own host thread complete asynchronously, the requesting
+    // thread stays in WaitIPC until the service thread writes the reply and wakes it up.
+    if (TryQueueOnServiceThread(request_queue.Front())) {
+        request_queue.Pop();
+        return RESULT_SUCCESS;
+    }
+
     auto& context = *request_queue.Front();
 
     ResultCode result = RESULT_SUCCESS;
@@ -184,4 +246,9 @@ ResultCode ServerSession::HandleSyncRequest(std::shared_ptr<Thread> thread,
     return QueueSyncRequest(std::move(thread), memory);
 }
 
+ResultCode ServerSession::HandleSyncRequest(std::shared_ptr<HLERequestContext> context) {
+    request_queue.Push(std::move(context));
+    return CompleteSyncRequest();
+}
+
 } // namespace Kernel
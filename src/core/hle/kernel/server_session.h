@@ -94,6 +94,16 @@ public:
      */
     ResultCode HandleSyncRequest(std::shared_ptr<Thread> thread, Core::Memory::Memory& memory);
 
+    /**
+     * Handle a sync request whose command buffer has already been translated, completing it right
+     * away instead of after the emulated IPC latency.
+     *
+     * @param context Context of the request, created for this session.
+     *
+     * @returns ResultCode from the operation.
+     */
+    ResultCode HandleSyncRequest(std::shared_ptr<HLERequestContext> context);
+
     bool ShouldWait(const Thread* thread) const override;
 
     void Acquire(Thread* thread) override;
@@ -131,6 +141,15 @@ private:
     /// Completes a sync request from the emulated application.
     ResultCode CompleteSyncRequest();
 
+    /// Gets the handler that will service the given request, or nullptr if the request is
+    /// handled by the session (or domain) itself.
+    std::shared_ptr<SessionRequestHandler> GetRequestHandler(
+        const HLERequestContext& context) const;
+
+    /// Hands the given request off to the service thread of its handler, if it has one.
+    /// @returns Whether the request was queued on a service thread.
+    bool TryQueueOnServiceThread(const std::shared_ptr<HLERequestContext>& context);
+
     /// Handles a SyncRequest to a domain, forwarding the request to the proper object or closing an
     /// object handle.
     ResultCode HandleDomainSyncRequest(Kernel::HLERequestContext& context);
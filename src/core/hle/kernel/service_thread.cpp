@@ -0,0 +1,96 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "common/microprofile.h"
+#include "common/thread.h"
+#include "core/hle/kernel/service_thread.h"
+
+namespace Kernel {
+
+struct ServiceThread::Impl {
+    explicit Impl(std::string name) : name{std::move(name)} {}
+
+    void ThreadLoop() {
+        const std::string thread_name = fmt::format("yuzu:ServiceThread:{}", name);
+        MicroProfileOnThreadCreate(thread_name.c_str());
+        Common::SetCurrentThreadName(thread_name.c_str());
+
+        while (true) {
+            std::function<void()> request;
+            {
+                std::unique_lock lock{queue_mutex};
+                request_available.wait(lock,
+                                       [this] { return stop_requested || !requests.empty(); });
+
+                // Pending requests are discarded on shutdown, as their guest threads are being
+                // torn down along with the kernel.
+                if (stop_requested) {
+                    return;
+                }
+
+                request = std::move(requests.front());
+                requests.pop();
+            }
+
+            // The request may hold the last reference to the ServiceThread itself, so it must be
+            // released while the Impl is still kept alive by this loop.
+            request();
+            request = nullptr;
+        }
+    }
+
+    std::string name;
+
+    std::mutex queue_mutex;
+    std::condition_variable request_available;
+    std::queue<std::function<void()>> requests;
+    bool stop_requested = false;
+
+    std::thread thread;
+};
+
+ServiceThread::ServiceThread(std::string name) : impl{std::make_shared<Impl>(std::move(name))} {
+    // The worker shares ownership of the Impl so that it remains valid even when the
+    // ServiceThread is destroyed from within one of its own requests.
+    impl->thread = std::thread([impl = impl] { impl->ThreadLoop(); });
+}
+
+ServiceThread::~ServiceThread() {
+    {
+        std::scoped_lock lock{impl->queue_mutex};
+        impl->stop_requested = true;
+    }
+    impl->request_available.notify_one();
+
+    if (impl->thread.get_id() == std::this_thread::get_id()) {
+        impl->thread.detach();
+    } else {
+        impl->thread.join();
+    }
+}
+
+void ServiceThread::QueueSyncRequest(std::function<void()> request) {
+    // The request may release this ServiceThread as soon as it is queued, so only the Impl is
+    // touched after that point.
+    const auto state = impl;
+    {
+        std::scoped_lock lock{state->queue_mutex};
+        state->requests.push(std::move(request));
+    }
+    state->request_available.notify_one();
+}
+
+const std::string& ServiceThread::GetName() const {
+    return impl->name;
+}
+
+} // namespace Kernel
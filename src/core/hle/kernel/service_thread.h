@@ -0,0 +1,39 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace Kernel {
+
+/**
+ * A host thread that executes HLE service requests on behalf of one or more sessions. While a
+ * request is in flight the requesting guest thread stays asleep in WaitIPC, so slow handlers
+ * (file system reads, audio decoding) no longer stall the emulated CPU core that issued them.
+ *
+ * Requests are executed in the order they were queued.
+ */
+class ServiceThread final {
+public:
+    explicit ServiceThread(std::string name);
+    ~ServiceThread();
+
+    ServiceThread(const ServiceThread&) = delete;
+    ServiceThread& operator=(const ServiceThread&) = delete;
+
+    /// Queues a request to be executed on the service thread.
+    void QueueSyncRequest(std::function<void()> request);
+
+    /// Gets the name of this service thread.
+    const std::string& GetName() const;
+
+private:
+    struct Impl;
+    std::shared_ptr<Impl> impl;
+};
+
+} // namespace Kernel
@@ -14,4 +14,7 @@ namespace Kernel::Svc {
 
 void Call(Core::System& system, u32 immediate);
 
+/// Gets the name of the SVC with the given number, as listed in the 64-bit SVC table.
+const char* GetSVCName(u32 immediate);
+
 } // namespace Kernel::Svc
@@ -38,21 +38,18 @@ void Synchronization::SignalObject(SynchronizationObject& obj) const {
     }
 }
 
-std::pair<ResultCode, Handle> Synchronization::WaitFor(
-    std::vector<std::shared_ptr<SynchronizationObject>>& sync_objects, s64 nano_seconds) {
+std::pair<ResultCode, Handle> Synchronization::WaitFor(SynchronizationObjectList& sync_objects,
+                                                      s64 nano_seconds) {
     auto* const thread = system.CurrentScheduler().GetCurrentThread();
-    // Find the first object that is acquirable in the provided list of objects
-    const auto itr = std::find_if(sync_objects.begin(), sync_objects.end(),
-                                  [thread](const std::shared_ptr<SynchronizationObject>& object) {
-                                      return object->IsSignaled();
-                                  });
-
-    if (itr != sync_objects.end()) {
-        // We found a ready object, acquire it and set the result value
-        SynchronizationObject* object = itr->get();
-        object->Acquire(thread);
-        const u32 index = static_cast<s32>(std::distance(sync_objects.begin(), itr));
-        return {RESULT_SUCCESS, index};
+
+    // Fast path: acquire the first object that is already signaled. This neither touches the
+    // waiter lists nor requests a reschedule, so it never contends with the scheduler.
+    for (std::size_t index = 0; index < sync_objects.size(); ++index) {
+        SynchronizationObject* const object = sync_objects[index].get();
+        if (object->IsSignaled()) {
+            object->Acquire(thread);
+            return {RESULT_SUCCESS, static_cast<Handle>(index)};
+        }
     }
 
     // No objects were ready to be acquired, prepare to suspend the thread.
@@ -68,10 +65,6 @@ std::pair<ResultCode, Handle> Synchronization::WaitFor(
         return {ERR_SYNCHRONIZATION_CANCELED, InvalidHandle};
     }
 
-    for (auto& object : sync_objects) {
-        object->AddWaitingThread(SharedFrom(thread));
-    }
-
     thread->SetSynchronizationObjects(std::move(sync_objects));
     thread->SetStatus(ThreadStatus::WaitSynch);
 
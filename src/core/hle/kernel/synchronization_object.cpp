@@ -2,7 +2,6 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
-#include <algorithm>
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
@@ -23,26 +22,17 @@ void SynchronizationObject::Signal() {
     kernel.Synchronization().SignalObject(*this);
 }
 
-void SynchronizationObject::AddWaitingThread(std::shared_ptr<Thread> thread) {
-    auto itr = std::find(waiting_threads.begin(), waiting_threads.end(), thread);
-    if (itr == waiting_threads.end())
-        waiting_threads.push_back(std::move(thread));
-}
-
-void SynchronizationObject::RemoveWaitingThread(std::shared_ptr<Thread> thread) {
-    auto itr = std::find(waiting_threads.begin(), waiting_threads.end(), thread);
-    // If a thread passed multiple handles to the same object,
-    // the kernel might attempt to remove the thread from the object's
-    // waiting threads list multiple times.
-    if (itr != waiting_threads.end())
-        waiting_threads.erase(itr);
+void SynchronizationObject::AddWaitingThread(SynchronizationWaiter& waiter) {
+    ASSERT(!waiter.hook.is_linked());
+    waiting_threads.push_back(waiter);
 }
 
 std::shared_ptr<Thread> SynchronizationObject::GetHighestPriorityReadyThread() const {
     Thread* candidate = nullptr;
     u32 candidate_priority = THREADPRIO_LOWEST + 1;
 
-    for (const auto& thread : waiting_threads) {
+    for (const auto& waiter : waiting_threads) {
+        Thread* const thread = waiter.thread;
         const ThreadStatus thread_status = thread->GetStatus();
 
         // The list of waiting threads must not contain threads that are not waiting to be awakened.
@@ -53,10 +43,10 @@ std::shared_ptr<Thread> SynchronizationObject::GetHighestPriorityReadyThread() c
         if (thread->GetPriority() >= candidate_priority)
             continue;
 
-        if (ShouldWait(thread.get()))
+        if (ShouldWait(thread))
             continue;
 
-        candidate = thread.get();
+        candidate = thread;
         candidate_priority = thread->GetPriority();
     }
 
@@ -79,7 +69,7 @@ void SynchronizationObject::WakeupWaitingThread(std::shared_ptr<Thread> thread)
         Acquire(thread.get());
     }
 
-    const std::size_t index = thread->GetSynchronizationObjectIndex(SharedFrom(this));
+    const std::size_t index = thread->GetSynchronizationObjectIndex(*this);
 
     thread->ClearSynchronizationObjects();
 
@@ -102,8 +92,12 @@ void SynchronizationObject::WakeupAllWaitingThreads() {
     }
 }
 
-const std::vector<std::shared_ptr<Thread>>& SynchronizationObject::GetWaitingThreads() const {
-    return waiting_threads;
+std::vector<std::shared_ptr<Thread>> SynchronizationObject::GetWaitingThreads() const {
+    std::vector<std::shared_ptr<Thread>> threads;
+    for (const auto& waiter : waiting_threads) {
+        threads.push_back(SharedFrom(waiter.thread));
+    }
+    return threads;
 }
 
 } // namespace Kernel
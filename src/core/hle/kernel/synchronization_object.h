@@ -4,16 +4,42 @@
 
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <vector>
 
+#include <boost/container/static_vector.hpp>
+#include <boost/intrusive/list.hpp>
+
 #include "core/hle/kernel/object.h"
 
 namespace Kernel {
 
 class KernelCore;
+class SynchronizationObject;
 class Thread;
 
+/// Maximum number of objects a thread can wait on at once, matching WaitSynchronization's limit.
+constexpr std::size_t MaxSynchronizationObjects = 0x40;
+
+/// Fixed-capacity list of the objects a thread is waiting on, so waiting never allocates.
+using SynchronizationObjectList =
+    boost::container::static_vector<std::shared_ptr<SynchronizationObject>,
+                                    MaxSynchronizationObjects>;
+
+/**
+ * Node linking a waiting thread into the waiter list of one of the objects it is waiting on.
+ * Each thread owns one node per wait slot, so the waiter lists are intrusive and need no
+ * allocations. Nodes unlink themselves when destroyed.
+ */
+struct SynchronizationWaiter {
+    using Hook = boost::intrusive::list_member_hook<
+        boost::intrusive::link_mode<boost::intrusive::auto_unlink>>;
+
+    Hook hook;
+    Thread* thread = nullptr;
+};
+
 /// Class that represents a Kernel object that a thread can be waiting on
 class SynchronizationObject : public Object {
 public:
@@ -38,16 +64,11 @@ public:
     }
 
     /**
-     * Add a thread to wait on this object
-     * @param thread Pointer to thread to add
+     * Add a thread to wait on this object. The thread is removed again by unlinking the node,
+     * which Thread::ClearSynchronizationObjects does for every object the thread waits on.
+     * @param waiter Unlinked waiter node owned by the waiting thread
      */
-    void AddWaitingThread(std::shared_ptr<Thread> thread);
-
-    /**
-     * Removes a thread from waiting on this object (e.g. if it was resumed already)
-     * @param thread Pointer to thread to remove
-     */
-    void RemoveWaitingThread(std::shared_ptr<Thread> thread);
+    void AddWaitingThread(SynchronizationWaiter& waiter);
 
     /**
      * Wake up all threads waiting on this object that can be awoken, in priority order,
@@ -64,15 +85,22 @@ public:
     /// Obtains the highest priority thread that is ready to run from this object's waiting list.
     std::shared_ptr<Thread> GetHighestPriorityReadyThread() const;
 
-    /// Get a const reference to the waiting threads list for debug use
-    const std::vector<std::shared_ptr<Thread>>& GetWaitingThreads() const;
+    /// Get a copy of the waiting threads list for debug use
+    std::vector<std::shared_ptr<Thread>> GetWaitingThreads() const;
 
 protected:
     bool is_signaled{}; // Tells if this sync object is signalled;
 
 private:
+    using WaiterList =
+        boost::intrusive::list<SynchronizationWaiter,
+                               boost::intrusive::member_hook<SynchronizationWaiter,
+                                                             SynchronizationWaiter::Hook,
+                                                             &SynchronizationWaiter::hook>,
+                               boost::intrusive::constant_time_size<false>>;
+
     /// Threads waiting for this object to become available
-    std::vector<std::shared_ptr<Thread>> waiting_threads;
+    WaiterList waiting_threads;
 };
 
 // Specialization of DynamicObjectCast for SynchronizationObjects
@@ -85,4 +113,12 @@ inline std::shared_ptr<SynchronizationObject> DynamicObjectCast<SynchronizationO
     return nullptr;
 }
 
+template <>
+inline SynchronizationObject* DynamicObjectCast<SynchronizationObject>(Object* object) {
+    if (object != nullptr && object->IsWaitable()) {
+        return static_cast<SynchronizationObject*>(object);
+    }
+    return nullptr;
+}
+
 } // namespace Kernel
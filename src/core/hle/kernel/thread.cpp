@@ -49,14 +49,16 @@ void Thread::Stop() {
                                                              global_handle);
     kernel.GlobalHandleTable().Close(global_handle);
     global_handle = 0;
+
+    // The arbiter links threads intrusively, make sure a stopped thread does not stay in its tree
+    if (status == ThreadStatus::WaitArb) {
+        owner_process->GetAddressArbiter().HandleWakeupThread(*this);
+    }
     SetStatus(ThreadStatus::Dead);
     Signal();
 
     // Clean up any dangling references in objects that this thread was waiting for
-    for (auto& wait_object : wait_objects) {
-        wait_object->RemoveWaitingThread(SharedFrom(this));
-    }
-    wait_objects.clear();
+    ClearSynchronizationObjects();
 
     owner_process->UnregisterThread(this);
 
@@ -224,12 +226,37 @@ void Thread::SetWaitSynchronizationOutput(s32 output) {
     context_64.cpu_registers[1] = output;
 }
 
-s32 Thread::GetSynchronizationObjectIndex(std::shared_ptr<SynchronizationObject> object) const {
+s32 Thread::GetSynchronizationObjectIndex(const SynchronizationObject& object) const {
     ASSERT_MSG(!wait_objects.empty(), "Thread is not waiting for anything");
-    const auto match = std::find(wait_objects.rbegin(), wait_objects.rend(), object);
+    const auto match =
+        std::find_if(wait_objects.rbegin(), wait_objects.rend(),
+                     [&object](const auto& wait_object) { return wait_object.get() == &object; });
     return static_cast<s32>(std::distance(match, wait_objects.rend()) - 1);
 }
 
+void Thread::SetSynchronizationObjects(ThreadSynchronizationObjects objects) {
+    ClearSynchronizationObjects();
+    wait_objects = std::move(objects);
+    for (std::size_t i = 0; i < wait_objects.size(); ++i) {
+        // An object passed more than once is only waited on through its first slot, so the
+        // thread appears once in its list of waiting threads.
+        const auto previous_objects_end = wait_objects.begin() + i;
+        if (std::find(wait_objects.begin(), previous_objects_end, wait_objects[i]) !=
+            previous_objects_end) {
+            continue;
+        }
+        wait_nodes[i].thread = this;
+        wait_objects[i]->AddWaitingThread(wait_nodes[i]);
+    }
+}
+
+void Thread::ClearSynchronizationObjects() {
+    for (std::size_t i = 0; i < wait_objects.size(); ++i) {
+        wait_nodes[i].hook.unlink();
+    }
+    wait_objects.clear();
+}
+
 VAddr Thread::GetCommandBufferAddress() const {
     // Offset from the start of TLS at which the IPC command buffer begins.
     constexpr u64 command_header_offset = 0x80;
@@ -321,12 +348,19 @@ void Thread::UpdatePriority() {
     if (GetStatus() == ThreadStatus::WaitCondVar) {
         owner_process->RemoveConditionVariableThread(SharedFrom(this));
     }
+    // The arbiter's wait tree is ordered by priority, so the thread has to be re-inserted
+    if (GetStatus() == ThreadStatus::WaitArb) {
+        owner_process->GetAddressArbiter().RemoveThread(*this);
+    }
 
     SetCurrentPriority(new_priority);
 
     if (GetStatus() == ThreadStatus::WaitCondVar) {
         owner_process->InsertConditionVariableThread(SharedFrom(this));
     }
+    if (GetStatus() == ThreadStatus::WaitArb) {
+        owner_process->GetAddressArbiter().InsertThread(*this);
+    }
 
     if (!lock_owner) {
         return;
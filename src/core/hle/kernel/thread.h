@@ -4,10 +4,13 @@
 
 #pragma once
 
+#include <array>
 #include <functional>
 #include <string>
 #include <vector>
 
+#include <boost/intrusive/set_hook.hpp>
+
 #include "common/common_types.h"
 #include "core/arm/arm_interface.h"
 #include "core/hle/kernel/object.h"
@@ -105,7 +108,7 @@ public:
     using ThreadContext32 = Core::ARM_Interface::ThreadContext32;
     using ThreadContext64 = Core::ARM_Interface::ThreadContext64;
 
-    using ThreadSynchronizationObjects = std::vector<std::shared_ptr<SynchronizationObject>>;
+    using ThreadSynchronizationObjects = SynchronizationObjectList;
 
     using WakeupCallback =
         std::function<bool(ThreadWakeupReason reason, std::shared_ptr<Thread> thread,
@@ -235,7 +238,7 @@ public:
      *
      * @param object Object to query the index of.
      */
-    s32 GetSynchronizationObjectIndex(std::shared_ptr<SynchronizationObject> object) const;
+    s32 GetSynchronizationObjectIndex(const SynchronizationObject& object) const;
 
     /**
      * Stops a thread, invalidating it from further use
@@ -328,16 +331,11 @@ public:
         return wait_objects;
     }
 
-    void SetSynchronizationObjects(ThreadSynchronizationObjects objects) {
-        wait_objects = std::move(objects);
-    }
+    /// Sets the objects this thread waits on and adds the thread to each of their waiter lists.
+    void SetSynchronizationObjects(ThreadSynchronizationObjects objects);
 
-    void ClearSynchronizationObjects() {
-        for (const auto& waiting_object : wait_objects) {
-            waiting_object->RemoveWaitingThread(SharedFrom(this));
-        }
-        wait_objects.clear();
-    }
+    /// Removes the thread from the waiter lists of all its objects and clears them.
+    void ClearSynchronizationObjects();
 
     /// Determines whether all the objects this thread is waiting on are ready.
     bool AllSynchronizationObjectsReady() const;
@@ -467,6 +465,8 @@ public:
     }
 
 private:
+    friend class AddressArbiter;
+
     void SetSchedulingStatus(ThreadSchedStatus new_status);
     void SetCurrentPriority(u32 new_priority);
     ResultCode SetCoreAndAffinityMask(s32 new_core, u64 new_affinity_mask);
@@ -511,6 +511,9 @@ private:
     /// passed to WaitSynchronization.
     ThreadSynchronizationObjects wait_objects;
 
+    /// Nodes linking this thread into the waiter lists of wait_objects, one per object.
+    std::array<SynchronizationWaiter, MaxSynchronizationObjects> wait_nodes;
+
     /// List of threads that are waiting for a mutex that is held by this thread.
     MutexWaitingThreads wait_mutex_threads;
 
@@ -527,6 +530,11 @@ private:
     /// If waiting for an AddressArbiter, this is the address being waited on.
     VAddr arb_wait_address{0};
 
+    /// Links the thread into the wait tree of its process' AddressArbiter while waiting on an
+    /// address. The hook unlinks itself should the thread be destroyed while still waiting.
+    boost::intrusive::set_member_hook<boost::intrusive::link_mode<boost::intrusive::auto_unlink>>
+        arbiter_hook;
+
     /// Handle used as userdata to reference this object when inserting into the CoreTiming queue.
     Handle global_handle = 0;
 
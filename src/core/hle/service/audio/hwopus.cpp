@@ -178,6 +178,7 @@ public:
         // clang-format on
 
         RegisterHandlers(functions);
+        RunOnServiceThread("hwopus");
     }
 
 private:
@@ -67,6 +67,7 @@ public:
             {5, nullptr, "OperateRange"},
         };
         RegisterHandlers(functions);
+        RunOnServiceThread("fsp-srv");
     }
 
 private:
@@ -122,6 +123,7 @@ public:
             {4, &IFile::GetSize, "GetSize"}, {5, nullptr, "OperateRange"},
         };
         RegisterHandlers(functions);
+        RunOnServiceThread("fsp-srv");
     }
 
 private:
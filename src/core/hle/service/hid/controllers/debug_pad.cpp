@@ -34,13 +34,9 @@ void Controller_DebugPad::OnUpdate(const Core::Timing::CoreTiming& core_timing,
     shared_memory.header.entry_count = 16;
 
     const auto& last_entry = shared_memory.pad_states[shared_memory.header.last_entry_index];
-    shared_memory.header.last_entry_index = (shared_memory.header.last_entry_index + 1) % 17;
-    auto& cur_entry = shared_memory.pad_states[shared_memory.header.last_entry_index];
-
-    cur_entry.sampling_number = last_entry.sampling_number + 1;
-    cur_entry.sampling_number2 = cur_entry.sampling_number;
-    cur_entry.attribute.connected.Assign(1);
-    auto& pad = cur_entry.pad_state;
+    PadStates next_entry = last_entry;
+    next_entry.attribute.connected.Assign(1);
+    auto& pad = next_entry.pad_state;
 
     using namespace Settings::NativeButton;
     pad.a.Assign(buttons[A - BUTTON_HID_BEGIN]->GetStatus());
@@ -62,10 +58,23 @@ void Controller_DebugPad::OnUpdate(const Core::Timing::CoreTiming& core_timing,
         analogs[static_cast<std::size_t>(JoystickId::Joystick_Left)]->GetStatus();
     const auto [stick_r_x_f, stick_r_y_f] =
         analogs[static_cast<std::size_t>(JoystickId::Joystick_Right)]->GetStatus();
-    cur_entry.l_stick.x = static_cast<s32>(stick_l_x_f * HID_JOYSTICK_MAX);
-    cur_entry.l_stick.y = static_cast<s32>(stick_l_y_f * HID_JOYSTICK_MAX);
-    cur_entry.r_stick.x = static_cast<s32>(stick_r_x_f * HID_JOYSTICK_MAX);
-    cur_entry.r_stick.y = static_cast<s32>(stick_r_y_f * HID_JOYSTICK_MAX);
+    next_entry.l_stick.x = static_cast<s32>(stick_l_x_f * HID_JOYSTICK_MAX);
+    next_entry.l_stick.y = static_cast<s32>(stick_l_y_f * HID_JOYSTICK_MAX);
+    next_entry.r_stick.x = static_cast<s32>(stick_r_x_f * HID_JOYSTICK_MAX);
+    next_entry.r_stick.y = static_cast<s32>(stick_r_y_f * HID_JOYSTICK_MAX);
+
+    // Only append an entry when the input changed, otherwise just publish the new timestamp.
+    if (std::memcmp(&next_entry, &last_entry, sizeof(PadStates)) == 0) {
+        std::memcpy(data, &shared_memory.header, sizeof(CommonHeader));
+        return;
+    }
+
+    const s64 sampling_number = last_entry.sampling_number + 1;
+    shared_memory.header.last_entry_index = (shared_memory.header.last_entry_index + 1) % 17;
+    auto& cur_entry = shared_memory.pad_states[shared_memory.header.last_entry_index];
+    cur_entry = next_entry;
+    cur_entry.sampling_number = sampling_number;
+    cur_entry.sampling_number2 = sampling_number;
 
     std::memcpy(data, &shared_memory, sizeof(SharedMemory));
 }
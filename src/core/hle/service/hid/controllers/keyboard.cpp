@@ -32,23 +32,31 @@ void Controller_Keyboard::OnUpdate(const Core::Timing::CoreTiming& core_timing,
     shared_memory.header.entry_count = 16;
 
     const auto& last_entry = shared_memory.pad_states[shared_memory.header.last_entry_index];
-    shared_memory.header.last_entry_index = (shared_memory.header.last_entry_index + 1) % 17;
-    auto& cur_entry = shared_memory.pad_states[shared_memory.header.last_entry_index];
-
-    cur_entry.sampling_number = last_entry.sampling_number + 1;
-    cur_entry.sampling_number2 = cur_entry.sampling_number;
-
-    cur_entry.key.fill(0);
-    cur_entry.modifier = 0;
+    KeyboardState next_entry = last_entry;
+    next_entry.key.fill(0);
+    next_entry.modifier = 0;
 
     for (std::size_t i = 0; i < keyboard_keys.size(); ++i) {
-        cur_entry.key[i / KEYS_PER_BYTE] |= (keyboard_keys[i]->GetStatus() << (i % KEYS_PER_BYTE));
+        next_entry.key[i / KEYS_PER_BYTE] |= (keyboard_keys[i]->GetStatus() << (i % KEYS_PER_BYTE));
     }
 
     for (std::size_t i = 0; i < keyboard_mods.size(); ++i) {
-        cur_entry.modifier |= (keyboard_mods[i]->GetStatus() << i);
+        next_entry.modifier |= (keyboard_mods[i]->GetStatus() << i);
+    }
+
+    // Nothing was pressed or released since the last entry, only the timestamp moves forward.
+    if (std::memcmp(&next_entry, &last_entry, sizeof(KeyboardState)) == 0) {
+        std::memcpy(data + SHARED_MEMORY_OFFSET, &shared_memory.header, sizeof(CommonHeader));
+        return;
     }
 
+    const s64 sampling_number = last_entry.sampling_number + 1;
+    shared_memory.header.last_entry_index = (shared_memory.header.last_entry_index + 1) % 17;
+    auto& cur_entry = shared_memory.pad_states[shared_memory.header.last_entry_index];
+    cur_entry = next_entry;
+    cur_entry.sampling_number = sampling_number;
+    cur_entry.sampling_number2 = sampling_number;
+
     std::memcpy(data + SHARED_MEMORY_OFFSET, &shared_memory, sizeof(SharedMemory));
 }
 
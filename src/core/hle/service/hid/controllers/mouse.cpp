@@ -29,29 +29,39 @@ void Controller_Mouse::OnUpdate(const Core::Timing::CoreTiming& core_timing, u8*
     }
     shared_memory.header.entry_count = 16;
 
-    auto& last_entry = shared_memory.mouse_states[shared_memory.header.last_entry_index];
-    shared_memory.header.last_entry_index = (shared_memory.header.last_entry_index + 1) % 17;
-    auto& cur_entry = shared_memory.mouse_states[shared_memory.header.last_entry_index];
-
-    cur_entry.sampling_number = last_entry.sampling_number + 1;
-    cur_entry.sampling_number2 = cur_entry.sampling_number;
+    const auto& last_entry = shared_memory.mouse_states[shared_memory.header.last_entry_index];
+    MouseState next_entry = last_entry;
 
     if (Settings::values.mouse_enabled) {
         const auto [px, py, sx, sy] = mouse_device->GetStatus();
         const auto x = static_cast<s32>(px * Layout::ScreenUndocked::Width);
         const auto y = static_cast<s32>(py * Layout::ScreenUndocked::Height);
-        cur_entry.x = x;
-        cur_entry.y = y;
-        cur_entry.delta_x = x - last_entry.x;
-        cur_entry.delta_y = y - last_entry.y;
-        cur_entry.mouse_wheel_x = sx;
-        cur_entry.mouse_wheel_y = sy;
+        next_entry.x = x;
+        next_entry.y = y;
+        next_entry.delta_x = x - last_entry.x;
+        next_entry.delta_y = y - last_entry.y;
+        next_entry.mouse_wheel_x = sx;
+        next_entry.mouse_wheel_y = sy;
 
+        next_entry.button = 0;
         for (std::size_t i = 0; i < mouse_button_devices.size(); ++i) {
-            cur_entry.button |= (mouse_button_devices[i]->GetStatus() << i);
+            next_entry.button |= (mouse_button_devices[i]->GetStatus() << i);
         }
     }
 
+    // A still mouse keeps its last entry, the header timestamp is bumped regardless.
+    if (std::memcmp(&next_entry, &last_entry, sizeof(MouseState)) == 0) {
+        std::memcpy(data + SHARED_MEMORY_OFFSET, &shared_memory.header, sizeof(CommonHeader));
+        return;
+    }
+
+    const s64 sampling_number = last_entry.sampling_number + 1;
+    shared_memory.header.last_entry_index = (shared_memory.header.last_entry_index + 1) % 17;
+    auto& cur_entry = shared_memory.mouse_states[shared_memory.header.last_entry_index];
+    cur_entry = next_entry;
+    cur_entry.sampling_number = sampling_number;
+    cur_entry.sampling_number2 = sampling_number;
+
     std::memcpy(data + SHARED_MEMORY_OFFSET, &shared_memory, sizeof(SharedMemory));
 }
 
@@ -168,6 +168,7 @@ void Controller_NPad::InitNewlyAddedControler(std::size_t controller_idx) {
     controller.battery_level[0] = BATTERY_FULL;
     controller.battery_level[1] = BATTERY_FULL;
     controller.battery_level[2] = BATTERY_FULL;
+    is_entry_dirty[controller_idx] = true;
     styleset_changed_events[controller_idx].writable->Signal();
 }
 
@@ -182,6 +183,9 @@ void Controller_NPad::OnInit() {
         return;
     }
 
+    // Write every entry in full on the next update, including those without a controller.
+    is_entry_dirty.fill(true);
+
     if (style.raw == 0) {
         // We want to support all controllers
         style.handheld.Assign(1);
@@ -311,6 +315,7 @@ void Controller_NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing, u8*
                                std::size_t data_len) {
     if (!IsControllerActivated())
         return;
+    const s64 timestamp = core_timing.GetTicks();
     for (std::size_t i = 0; i < shared_memory_entries.size(); i++) {
         auto& npad = shared_memory_entries[i];
         const std::array<NPadGeneric*, 7> controller_npads{&npad.main_controller_states,
@@ -320,6 +325,40 @@ void Controller_NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing, u8*
                                                            &npad.right_joy_states,
                                                            &npad.pokeball_states,
                                                            &npad.libnx};
+        u8* const entry_data = data + NPAD_OFFSET + i * sizeof(NPadEntry);
+
+        const auto& controller = connected_controllers[i];
+        const auto& controller_type = controller.type;
+        const bool is_connected =
+            controller_type != NPadControllerType::None && controller.is_connected;
+        auto& pad_state = npad_pad_states[i];
+        if (is_connected) {
+            RequestPadStateUpdate(static_cast<u32>(i));
+            press_state |= static_cast<u32>(pad_state.pad_states.raw);
+        }
+
+        // The libnx ring always holds the latest input of a connected controller. When neither
+        // that nor the controller itself changed, only the ring timestamps are written, leaving
+        // the rest of the 0x5000 byte entry untouched.
+        const auto& last_libnx_entry = npad.libnx.npad[npad.libnx.common.last_entry_index];
+        auto& published_controller = published_controllers[i];
+        const bool has_changed =
+            is_entry_dirty[i] || published_controller.type != controller_type ||
+            published_controller.is_connected != controller.is_connected ||
+            (is_connected &&
+             std::memcmp(&pad_state, &last_libnx_entry.pad, sizeof(ControllerPad)) != 0);
+        if (!has_changed) {
+            for (auto* main_controller : controller_npads) {
+                main_controller->common.timestamp = timestamp;
+                const auto offset = reinterpret_cast<const u8*>(&main_controller->common) -
+                                    reinterpret_cast<const u8*>(&npad);
+                std::memcpy(entry_data + offset, &main_controller->common.timestamp,
+                            sizeof(s64_le));
+            }
+            continue;
+        }
+        is_entry_dirty[i] = false;
+        published_controller = controller;
 
         for (auto* main_controller : controller_npads) {
             main_controller->common.entry_count = 16;
@@ -328,7 +367,7 @@ void Controller_NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing, u8*
             const auto& last_entry =
                 main_controller->npad[main_controller->common.last_entry_index];
 
-            main_controller->common.timestamp = core_timing.GetTicks();
+            main_controller->common.timestamp = timestamp;
             main_controller->common.last_entry_index =
                 (main_controller->common.last_entry_index + 1) % 17;
 
@@ -338,14 +377,10 @@ void Controller_NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing, u8*
             cur_entry.timestamp2 = cur_entry.timestamp;
         }
 
-        const auto& controller_type = connected_controllers[i].type;
-
-        if (controller_type == NPadControllerType::None || !connected_controllers[i].is_connected) {
+        if (!is_connected) {
+            std::memcpy(entry_data, &npad, sizeof(NPadEntry));
             continue;
         }
-        const u32 npad_index = static_cast<u32>(i);
-        RequestPadStateUpdate(npad_index);
-        auto& pad_state = npad_pad_states[npad_index];
 
         auto& main_controller =
             npad.main_controller_states.npad[npad.main_controller_states.common.last_entry_index];
@@ -434,10 +469,8 @@ void Controller_NPad::OnUpdate(const Core::Timing::CoreTiming& core_timing, u8*
         libnx_entry.pad.l_stick = pad_state.l_stick;
         libnx_entry.pad.r_stick = pad_state.r_stick;
 
-        press_state |= static_cast<u32>(pad_state.pad_states.raw);
+        std::memcpy(entry_data, &npad, sizeof(NPadEntry));
     }
-    std::memcpy(data + NPAD_OFFSET, shared_memory_entries.data(),
-                shared_memory_entries.size() * sizeof(NPadEntry));
 }
 
 void Controller_NPad::SetSupportedStyleSet(NPadType style_set) {
@@ -497,6 +530,7 @@ void Controller_NPad::SetNpadMode(u32 npad_id, NPadAssignments assignment_mode)
     ASSERT(npad_index < shared_memory_entries.size());
     if (shared_memory_entries[npad_index].pad_assignment != assignment_mode) {
         shared_memory_entries[npad_index].pad_assignment = assignment_mode;
+        is_entry_dirty[npad_index] = true;
     }
 }
 
@@ -327,6 +327,10 @@ private:
     bool can_controllers_vibrate{true};
 
     std::array<ControllerPad, 10> npad_pad_states{};
+    // Controllers as of the last entry written to shared memory, used to detect changes
+    std::array<ControllerHolder, 10> published_controllers{};
+    // Entries whose shared memory contents changed outside of OnUpdate
+    std::array<bool, 10> is_entry_dirty{};
     bool is_in_lr_assignment_mode{false};
     Core::System& system;
 };
@@ -34,18 +34,33 @@ void Controller_Touchscreen::OnUpdate(const Core::Timing::CoreTiming& core_timin
 
     const auto& last_entry =
         shared_memory.shared_memory_entries[shared_memory.header.last_entry_index];
+    const auto& last_touch_entry = last_entry.states[0];
+
+    const auto [x, y, pressed] = touch_device->GetStatus();
+    const bool is_touching = pressed && Settings::values.touchscreen.enabled;
+    const auto touch_x = static_cast<u16>(x * Layout::ScreenUndocked::Width);
+    const auto touch_y = static_cast<u16>(y * Layout::ScreenUndocked::Height);
+
+    // A finger resting in place, or no finger at all, does not produce new entries.
+    const bool was_touching = last_entry.entry_count != 0;
+    if (is_touching == was_touching &&
+        (!is_touching || (touch_x == last_touch_entry.x && touch_y == last_touch_entry.y))) {
+        std::memcpy(data + SHARED_MEMORY_OFFSET, &shared_memory.header, sizeof(CommonHeader));
+        return;
+    }
+
+    const s64 sampling_number = last_entry.sampling_number + 1;
     shared_memory.header.last_entry_index = (shared_memory.header.last_entry_index + 1) % 17;
     auto& cur_entry = shared_memory.shared_memory_entries[shared_memory.header.last_entry_index];
 
-    cur_entry.sampling_number = last_entry.sampling_number + 1;
-    cur_entry.sampling_number2 = cur_entry.sampling_number;
+    cur_entry.sampling_number = sampling_number;
+    cur_entry.sampling_number2 = sampling_number;
 
-    const auto [x, y, pressed] = touch_device->GetStatus();
     auto& touch_entry = cur_entry.states[0];
     touch_entry.attribute.raw = 0;
-    if (pressed && Settings::values.touchscreen.enabled) {
-        touch_entry.x = static_cast<u16>(x * Layout::ScreenUndocked::Width);
-        touch_entry.y = static_cast<u16>(y * Layout::ScreenUndocked::Height);
+    if (is_touching) {
+        touch_entry.x = touch_x;
+        touch_entry.y = touch_y;
         touch_entry.diameter_x = Settings::values.touchscreen.diameter_x;
         touch_entry.diameter_y = Settings::values.touchscreen.diameter_y;
         touch_entry.rotation_angle = Settings::values.touchscreen.rotation_angle;
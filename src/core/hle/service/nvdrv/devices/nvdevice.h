@@ -4,9 +4,9 @@
 
 #pragma once
 
-#include <vector>
 #include "common/bit_field.h"
 #include "common/common_types.h"
+#include "common/span.h"
 #include "common/swap.h"
 #include "core/hle/service/nvdrv/nvdata.h"
 #include "core/hle/service/service.h"
@@ -39,8 +39,8 @@ public:
      * @param output A buffer where the output data will be written to.
      * @returns The result code of the ioctl.
      */
-    virtual u32 ioctl(Ioctl command, const std::vector<u8>& input, const std::vector<u8>& input2,
-                      std::vector<u8>& output, std::vector<u8>& output2, IoctlCtrl& ctrl,
+    virtual u32 ioctl(Ioctl command, Common::Span<const u8> input, Common::Span<const u8> input2,
+                      Common::Span<u8> output, Common::Span<u8> output2, IoctlCtrl& ctrl,
                       IoctlVersion version) = 0;
 
 protected:
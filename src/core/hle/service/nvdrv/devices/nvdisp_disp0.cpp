@@ -18,8 +18,8 @@ nvdisp_disp0::nvdisp_disp0(Core::System& system, std::shared_ptr<nvmap> nvmap_de
     : nvdevice(system), nvmap_dev(std::move(nvmap_dev)) {}
 nvdisp_disp0 ::~nvdisp_disp0() = default;
 
-u32 nvdisp_disp0::ioctl(Ioctl command, const std::vector<u8>& input, const std::vector<u8>& input2,
-                        std::vector<u8>& output, std::vector<u8>& output2, IoctlCtrl& ctrl,
+u32 nvdisp_disp0::ioctl(Ioctl command, Common::Span<const u8> input, Common::Span<const u8> input2,
+                        Common::Span<u8> output, Common::Span<u8> output2, IoctlCtrl& ctrl,
                         IoctlVersion version) {
     UNIMPLEMENTED_MSG("Unimplemented ioctl");
     return 0;
@@ -38,10 +38,20 @@ void nvdisp_disp0::flip(u32 buffer_handle, u32 offset, u32 format, u32 width, u3
         addr,      offset,   width, height, stride, static_cast<PixelFormat>(format),
         transform, crop_rect};
 
+    auto& gpu = system.GPU();
+    auto& frame_limiter = system.FrameLimiter();
     system.GetPerfStats().EndGameFrame();
     system.GetPerfStats().EndSystemFrame();
-    system.GPU().SwapBuffers(&framebuffer);
-    system.FrameLimiter().DoFrameLimiting(system.CoreTiming().GetGlobalTimeUs());
+    // Wait before presenting rather than after, so frames are shown when they are due no matter
+    // how long each of them took to emulate.
+    frame_limiter.DoFrameLimiting(system.CoreTiming().GetGlobalTimeUs(), gpu.QueuedFrames());
+    const auto present_begin = Core::FrameLimiter::Clock::now();
+    gpu.SwapBuffers(&framebuffer);
+    // The asynchronous GPU only queues the present here. A host present blocking on vsync shows up
+    // as frames queued on the GPU thread instead, which DoFrameLimiting already waits for.
+    if (!gpu.IsAsync()) {
+        frame_limiter.SetHostPresentTime(Core::FrameLimiter::Clock::now() - present_begin);
+    }
     system.GetPerfStats().BeginSystemFrame();
 }
 
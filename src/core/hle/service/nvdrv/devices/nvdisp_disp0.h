@@ -5,7 +5,6 @@
 #pragma once
 
 #include <memory>
-#include <vector>
 #include "common/common_types.h"
 #include "common/math_util.h"
 #include "core/hle/service/nvdrv/devices/nvdevice.h"
@@ -20,8 +19,8 @@ public:
     explicit nvdisp_disp0(Core::System& system, std::shared_ptr<nvmap> nvmap_dev);
     ~nvdisp_disp0() override;
 
-    u32 ioctl(Ioctl command, const std::vector<u8>& input, const std::vector<u8>& input2,
-              std::vector<u8>& output, std::vector<u8>& output2, IoctlCtrl& ctrl,
+    u32 ioctl(Ioctl command, Common::Span<const u8> input, Common::Span<const u8> input2,
+              Common::Span<u8> output, Common::Span<u8> output2, IoctlCtrl& ctrl,
               IoctlVersion version) override;
 
     /// Performs a screen flip, drawing the buffer pointed to by the handle.
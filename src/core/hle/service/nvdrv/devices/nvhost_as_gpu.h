@@ -6,7 +6,6 @@
 
 #include <memory>
 #include <unordered_map>
-#include <vector>
 #include "common/common_types.h"
 #include "common/swap.h"
 #include "core/hle/service/nvdrv/devices/nvdevice.h"
@@ -20,8 +19,8 @@ public:
     explicit nvhost_as_gpu(Core::System& system, std::shared_ptr<nvmap> nvmap_dev);
     ~nvhost_as_gpu() override;
 
-    u32 ioctl(Ioctl command, const std::vector<u8>& input, const std::vector<u8>& input2,
-              std::vector<u8>& output, std::vector<u8>& output2, IoctlCtrl& ctrl,
+    u32 ioctl(Ioctl command, Common::Span<const u8> input, Common::Span<const u8> input2,
+              Common::Span<u8> output, Common::Span<u8> output2, IoctlCtrl& ctrl,
               IoctlVersion version) override;
 
 private:
@@ -117,13 +116,13 @@ private:
 
     u32 channel{};
 
-    u32 InitalizeEx(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 AllocateSpace(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 Remap(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 MapBufferEx(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 UnmapBuffer(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 BindChannel(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 GetVARegions(const std::vector<u8>& input, std::vector<u8>& output);
+    u32 InitalizeEx(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 AllocateSpace(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 Remap(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 MapBufferEx(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 UnmapBuffer(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 BindChannel(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 GetVARegions(Common::Span<const u8> input, Common::Span<u8> output);
 
     std::shared_ptr<nvmap> nvmap_dev;
 };
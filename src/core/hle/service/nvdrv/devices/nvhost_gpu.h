@@ -5,7 +5,6 @@
 #pragma once
 
 #include <memory>
-#include <vector>
 #include "common/bit_field.h"
 #include "common/common_types.h"
 #include "common/swap.h"
@@ -24,8 +23,8 @@ public:
     explicit nvhost_gpu(Core::System& system, std::shared_ptr<nvmap> nvmap_dev);
     ~nvhost_gpu() override;
 
-    u32 ioctl(Ioctl command, const std::vector<u8>& input, const std::vector<u8>& input2,
-              std::vector<u8>& output, std::vector<u8>& output2, IoctlCtrl& ctrl,
+    u32 ioctl(Ioctl command, Common::Span<const u8> input, Common::Span<const u8> input2,
+              Common::Span<u8> output, Common::Span<u8> output2, IoctlCtrl& ctrl,
               IoctlVersion version) override;
 
 private:
@@ -182,20 +181,20 @@ private:
     u32_le channel_priority{};
     u32_le channel_timeslice{};
 
-    u32 SetNVMAPfd(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 SetClientData(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 GetClientData(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 ZCullBind(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 SetErrorNotifier(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 SetChannelPriority(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 AllocGPFIFOEx2(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 AllocateObjectContext(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 SubmitGPFIFO(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 KickoffPB(const std::vector<u8>& input, std::vector<u8>& output,
-                  const std::vector<u8>& input2, IoctlVersion version);
-    u32 GetWaitbase(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 ChannelSetTimeout(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 ChannelSetTimeslice(const std::vector<u8>& input, std::vector<u8>& output);
+    u32 SetNVMAPfd(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 SetClientData(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 GetClientData(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 ZCullBind(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 SetErrorNotifier(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 SetChannelPriority(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 AllocGPFIFOEx2(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 AllocateObjectContext(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 SubmitGPFIFO(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 KickoffPB(Common::Span<const u8> input, Common::Span<u8> output,
+                  Common::Span<const u8> input2, IoctlVersion version);
+    u32 GetWaitbase(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 ChannelSetTimeout(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 ChannelSetTimeslice(Common::Span<const u8> input, Common::Span<u8> output);
 
     std::shared_ptr<nvmap> nvmap_dev;
     u32 assigned_syncpoints{};
@@ -6,7 +6,6 @@
 
 #include <memory>
 #include <unordered_map>
-#include <vector>
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 #include "common/swap.h"
@@ -22,8 +21,8 @@ public:
     /// Returns the allocated address of an nvmap object given its handle.
     VAddr GetObjectAddress(u32 handle) const;
 
-    u32 ioctl(Ioctl command, const std::vector<u8>& input, const std::vector<u8>& input2,
-              std::vector<u8>& output, std::vector<u8>& output2, IoctlCtrl& ctrl,
+    u32 ioctl(Ioctl command, Common::Span<const u8> input, Common::Span<const u8> input2,
+              Common::Span<u8> output, Common::Span<u8> output2, IoctlCtrl& ctrl,
               IoctlVersion version) override;
 
     /// Represents an nvmap object.
@@ -119,12 +118,12 @@ private:
     };
     static_assert(sizeof(IocGetIdParams) == 8, "IocGetIdParams has wrong size");
 
-    u32 IocCreate(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 IocAlloc(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 IocGetId(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 IocFromId(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 IocParam(const std::vector<u8>& input, std::vector<u8>& output);
-    u32 IocFree(const std::vector<u8>& input, std::vector<u8>& output);
+    u32 IocCreate(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 IocAlloc(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 IocGetId(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 IocFromId(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 IocParam(Common::Span<const u8> input, Common::Span<u8> output);
+    u32 IocFree(Common::Span<const u8> input, Common::Span<u8> output);
 };
 
 } // namespace Service::Nvidia::Devices
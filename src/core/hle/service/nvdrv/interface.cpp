@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <cinttypes>
+#include <vector>
 #include "common/logging/log.h"
 #include "core/core.h"
 #include "core/hle/ipc_helpers.h"
@@ -39,19 +40,23 @@ void NVDRV::IoctlBase(Kernel::HLERequestContext& ctx, IoctlVersion version) {
     u32 command = rp.Pop<u32>();
 
     /// Ioctl 3 has 2 outputs, first in the input params, second is the result
-    std::vector<u8> output(ctx.GetWriteBufferSize(0));
-    std::vector<u8> output2;
+    /// Outputs are staged instead of written in place, as the output buffer usually aliases the
+    /// input buffer and devices may still read the input after writing their results.
+    Kernel::ScratchBuffer output(ctx.GetWriteBufferSize(0));
+    Kernel::ScratchBuffer output2;
     if (version == IoctlVersion::Version3) {
         output2.resize((ctx.GetWriteBufferSize(1)));
     }
 
     /// Ioctl2 has 2 inputs. It's used to pass data directly instead of providing a pointer.
     /// KickOfPB uses this
-    auto input = ctx.ReadBuffer(0);
+    Kernel::ScratchBuffer input_scratch;
+    const auto input = ctx.ReadBufferSpan(input_scratch, 0);
 
-    std::vector<u8> input2;
+    Kernel::ScratchBuffer input2_scratch;
+    Common::Span<const u8> input2;
     if (version == IoctlVersion::Version2) {
-        input2 = ctx.ReadBuffer(1);
+        input2 = ctx.ReadBufferSpan(input2_scratch, 1);
     }
 
     IoctlCtrl ctrl{};
@@ -60,24 +65,30 @@ void NVDRV::IoctlBase(Kernel::HLERequestContext& ctx, IoctlVersion version) {
 
     if (ctrl.must_delay) {
         ctrl.fresh_call = false;
-        ctx.SleepClientThread("NVServices::DelayedResponse", ctrl.timeout,
-                              [=](std::shared_ptr<Kernel::Thread> thread,
-                                  Kernel::HLERequestContext& ctx,
-                                  Kernel::ThreadWakeupReason reason) {
-                                  IoctlCtrl ctrl2{ctrl};
-                                  std::vector<u8> tmp_output = output;
-                                  std::vector<u8> tmp_output2 = output2;
-                                  u32 result = nvdrv->Ioctl(fd, command, input, input2, tmp_output,
-                                                            tmp_output2, ctrl2, version);
-                                  ctx.WriteBuffer(tmp_output, 0);
-                                  if (version == IoctlVersion::Version3) {
-                                      ctx.WriteBuffer(tmp_output2, 1);
-                                  }
-                                  IPC::ResponseBuilder rb{ctx, 3};
-                                  rb.Push(RESULT_SUCCESS);
-                                  rb.Push(result);
-                              },
-                              nvdrv->GetEventWriteable(ctrl.event_id));
+        // The delayed call happens after the guest has been resumed, so keep copies of the
+        // buffers as they were submitted.
+        ctx.SleepClientThread(
+            "NVServices::DelayedResponse", ctrl.timeout,
+            [=, input = std::vector<u8>(input.begin(), input.end()),
+             input2 = std::vector<u8>(input2.begin(), input2.end()),
+             output = std::vector<u8>(output.begin(), output.end()),
+             output2 = std::vector<u8>(output2.begin(), output2.end())](
+                std::shared_ptr<Kernel::Thread> thread, Kernel::HLERequestContext& ctx,
+                Kernel::ThreadWakeupReason reason) {
+                IoctlCtrl ctrl2{ctrl};
+                std::vector<u8> tmp_output = output;
+                std::vector<u8> tmp_output2 = output2;
+                u32 result = nvdrv->Ioctl(fd, command, input, input2, tmp_output, tmp_output2,
+                                          ctrl2, version);
+                ctx.WriteBuffer(tmp_output, 0);
+                if (version == IoctlVersion::Version3) {
+                    ctx.WriteBuffer(tmp_output2, 1);
+                }
+                IPC::ResponseBuilder rb{ctx, 3};
+                rb.Push(RESULT_SUCCESS);
+                rb.Push(result);
+            },
+            nvdrv->GetEventWriteable(ctrl.event_id));
     } else {
         ctx.WriteBuffer(output);
         if (version == IoctlVersion::Version3) {
@@ -3,8 +3,10 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <chrono>
 #include <fmt/format.h>
 #include "common/assert.h"
+#include "common/latency_histogram.h"
 #include "common/logging/log.h"
 #include "common/string_util.h"
 #include "core/core.h"
@@ -14,7 +16,9 @@
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/server_port.h"
+#include "core/hle/kernel/service_thread.h"
 #include "core/hle/kernel/thread.h"
+#include "core/hle/lock.h"
 #include "core/hle/service/acc/acc.h"
 #include "core/hle/service/am/am.h"
 #include "core/hle/service/aoc/aoc_u.h"
@@ -68,6 +72,7 @@
 #include "core/hle/service/usb/usb.h"
 #include "core/hle/service/vi/vi.h"
 #include "core/hle/service/wlan/wlan.h"
+#include "core/hle_profiler.h"
 #include "core/reporter.h"
 
 namespace Service {
@@ -129,10 +134,18 @@ std::shared_ptr<Kernel::ClientPort> ServiceFrameworkBase::CreatePort() {
 }
 
 void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n) {
+    // Handler tables are static arrays, so all the instances of a service share the histograms
+    // resolved here by the address of the table.
+    auto* const latencies = Core::System::GetInstance().GetHLEProfiler().GetHandlerTableHistograms(
+        functions, n, service_name, [functions](std::size_t i) {
+            return Core::ServiceCommandInfo{functions[i].expected_header, functions[i].name};
+        });
+
     handlers.reserve(handlers.size() + n);
     for (std::size_t i = 0; i < n; ++i) {
         // Usually this array is sorted by id already, so hint to insert at the end
-        handlers.emplace_hint(handlers.cend(), functions[i].expected_header, functions[i]);
+        handlers.emplace_hint(handlers.cend(), functions[i].expected_header,
+                              Handler{functions[i], &latencies[i]});
     }
 }
 
@@ -156,13 +169,32 @@ void ServiceFrameworkBase::ReportUnimplementedFunction(Kernel::HLERequestContext
 
 void ServiceFrameworkBase::InvokeRequest(Kernel::HLERequestContext& ctx) {
     auto itr = handlers.find(ctx.GetCommand());
-    const FunctionInfoBase* info = itr == handlers.end() ? nullptr : &itr->second;
+    const FunctionInfoBase* info = itr == handlers.end() ? nullptr : &itr->second.info;
     if (info == nullptr || info->handler_callback == nullptr) {
         return ReportUnimplementedFunction(ctx, info);
     }
 
     LOG_TRACE(Service, "{}", MakeFunctionString(info->name, GetServiceName(), ctx.CommandBuffer()));
+
+    const auto start_time = std::chrono::steady_clock::now();
     handler_invoker(this, info->handler_callback, ctx);
+    itr->second.latency->Record(std::chrono::steady_clock::now() - start_time);
+}
+
+std::vector<Core::ServiceCommandProfile> ServiceFrameworkBase::GetCommandLatencyStats() const {
+    std::vector<Core::ServiceCommandProfile> stats;
+    for (const auto& [command_id, handler] : handlers) {
+        auto latency = handler.latency->GetSnapshot();
+        if (latency.count == 0) {
+            continue;
+        }
+        stats.push_back({service_name, command_id, handler.info.name, std::move(latency)});
+    }
+    return stats;
+}
+
+void ServiceFrameworkBase::RunOnServiceThread(const std::string& thread_name) {
+    service_thread = Core::System::GetInstance().Kernel().GetServiceThread(thread_name);
 }
 
 ResultCode ServiceFrameworkBase::HandleSyncRequest(Kernel::HLERequestContext& context) {
@@ -186,6 +218,9 @@ ResultCode ServiceFrameworkBase::HandleSyncRequest(Kernel::HLERequestContext& co
         UNIMPLEMENTED_MSG("command_type={}", static_cast<int>(context.GetCommandType()));
     }
 
+    // Translating outgoing handles touches the handle table of the requesting process, which may
+    // be in use by the emulated CPU cores when this runs on a service thread.
+    std::lock_guard lock{HLE::g_hle_lock};
     context.WriteToOutgoingCommandBuffer(context.GetThread());
 
     return RESULT_SUCCESS;
@@ -6,6 +6,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 #include <boost/container/flat_map.hpp>
 #include "common/common_types.h"
 #include "core/hle/kernel/hle_ipc.h"
@@ -14,9 +15,14 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Namespace Service
 
+namespace Common {
+class LatencyHistogram;
+}
+
 namespace Core {
+struct ServiceCommandProfile;
 class System;
-}
+} // namespace Core
 
 namespace Kernel {
 class ClientPort;
@@ -71,11 +77,22 @@ public:
 
     ResultCode HandleSyncRequest(Kernel::HLERequestContext& context) override;
 
+    /// Returns the host time spent in each command of this service that has been invoked so far,
+    /// as recorded by the system's HLEProfiler.
+    std::vector<Core::ServiceCommandProfile> GetCommandLatencyStats() const;
+
 protected:
     /// Member-function pointer type of SyncRequest handlers.
     template <typename Self>
     using HandlerFnP = void (Self::*)(Kernel::HLERequestContext&);
 
+    /**
+     * Executes requests to this service on the host service thread with the given name instead
+     * of on the emulated CPU core that issued them. Only services whose commands do not create or
+     * signal kernel objects should opt into this, as their handlers run outside of the HLE lock.
+     */
+    void RunOnServiceThread(const std::string& thread_name);
+
 private:
     template <typename T>
     friend class ServiceFramework;
@@ -86,6 +103,12 @@ private:
         const char* name;
     };
 
+    struct Handler {
+        FunctionInfoBase info;
+        /// Latency histogram of the command, owned by the system's HLEProfiler.
+        Common::LatencyHistogram* latency;
+    };
+
     using InvokerFn = void(ServiceFrameworkBase* object, HandlerFnP<ServiceFrameworkBase> member,
                            Kernel::HLERequestContext& ctx);
 
@@ -106,7 +129,7 @@ private:
 
     /// Function used to safely up-cast pointers to the derived class before invoking a handler.
     InvokerFn* handler_invoker;
-    boost::container::flat_map<u32, FunctionInfoBase> handlers;
+    boost::container::flat_map<u32, Handler> handlers;
 };
 
 /**
@@ -0,0 +1,138 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+
+#include <nlohmann/json.hpp>
+
+#include "common/assert.h"
+#include "core/hle/kernel/svc.h"
+#include "core/hle_profiler.h"
+
+namespace Core {
+
+namespace {
+nlohmann::json LatencyToJson(const Common::LatencySnapshot& latency) {
+    // Trailing empty buckets are trimmed to keep the dump readable.
+    const auto last_bucket =
+        std::find_if(latency.buckets.rbegin(), latency.buckets.rend(), [](u64 bucket) {
+            return bucket != 0;
+        }).base();
+
+    return {
+        {"calls", latency.count},
+        {"total_ns", latency.total_ns},
+        {"mean_ns", latency.MeanTime().count()},
+        {"p50_ns", latency.Percentile(50.0).count()},
+        {"p99_ns", latency.Percentile(99.0).count()},
+        {"max_ns", latency.max_ns},
+        {"log2_ns_buckets", std::vector<u64>(latency.buckets.begin(), last_bucket)},
+    };
+}
+
+template <typename T>
+void SortByTotalTime(std::vector<T>& profiles) {
+    std::sort(profiles.begin(), profiles.end(), [](const T& lhs, const T& rhs) {
+        return lhs.latency.total_ns > rhs.latency.total_ns;
+    });
+}
+} // Anonymous namespace
+
+HLEProfiler::HLEProfiler() = default;
+HLEProfiler::~HLEProfiler() = default;
+
+void HLEProfiler::RecordSvc(u32 number, std::chrono::nanoseconds time) {
+    if (number < svc_latencies.size()) {
+        svc_latencies[number].Record(time);
+    }
+}
+
+Common::LatencyHistogram* HLEProfiler::GetHandlerTableHistograms(
+    const void* table, std::size_t num_entries, const std::string& service_name,
+    const std::function<ServiceCommandInfo(std::size_t)>& describe) {
+    std::scoped_lock lock{handler_tables_mutex};
+    auto [it, inserted] = handler_tables.try_emplace(table);
+    auto& entry = it->second;
+    if (inserted) {
+        entry.service_name = service_name;
+        entry.commands.reserve(num_entries);
+        for (std::size_t i = 0; i < num_entries; ++i) {
+            entry.commands.push_back(describe(i));
+        }
+        entry.histograms = std::make_unique<Common::LatencyHistogram[]>(num_entries);
+    }
+    ASSERT(entry.commands.size() == num_entries);
+    return entry.histograms.get();
+}
+
+std::vector<SvcProfile> HLEProfiler::GetSvcProfiles() const {
+    std::vector<SvcProfile> profiles;
+    for (u32 number = 0; number < svc_latencies.size(); ++number) {
+        auto latency = svc_latencies[number].GetSnapshot();
+        if (latency.count != 0) {
+            profiles.push_back({number, Kernel::Svc::GetSVCName(number), std::move(latency)});
+        }
+    }
+    SortByTotalTime(profiles);
+    return profiles;
+}
+
+std::vector<ServiceCommandProfile> HLEProfiler::GetServiceCommandProfiles() const {
+    std::scoped_lock lock{handler_tables_mutex};
+
+    std::vector<ServiceCommandProfile> profiles;
+    for (const auto& [table, entry] : handler_tables) {
+        for (std::size_t i = 0; i < entry.commands.size(); ++i) {
+            auto latency = entry.histograms[i].GetSnapshot();
+            if (latency.count != 0) {
+                const auto& command = entry.commands[i];
+                profiles.push_back({entry.service_name, command.command_id,
+                                    command.command_name ? command.command_name : "",
+                                    std::move(latency)});
+            }
+        }
+    }
+    SortByTotalTime(profiles);
+    return profiles;
+}
+
+std::string HLEProfiler::DumpJson() const {
+    auto svcs = nlohmann::json::array();
+    for (const auto& profile : GetSvcProfiles()) {
+        auto out = LatencyToJson(profile.latency);
+        out["number"] = profile.number;
+        out["name"] = profile.name;
+        svcs.push_back(std::move(out));
+    }
+
+    auto commands = nlohmann::json::array();
+    for (const auto& profile : GetServiceCommandProfiles()) {
+        auto out = LatencyToJson(profile.latency);
+        out["service"] = profile.service_name;
+        out["command_id"] = profile.command_id;
+        out["command"] = profile.command_name;
+        commands.push_back(std::move(out));
+    }
+
+    const nlohmann::json json{
+        {"svcs", std::move(svcs)},
+        {"service_commands", std::move(commands)},
+    };
+    return json.dump(4);
+}
+
+void HLEProfiler::Reset() {
+    for (auto& histogram : svc_latencies) {
+        histogram.Reset();
+    }
+
+    std::scoped_lock lock{handler_tables_mutex};
+    for (auto& [table, entry] : handler_tables) {
+        for (std::size_t i = 0; i < entry.commands.size(); ++i) {
+            entry.histograms[i].Reset();
+        }
+    }
+}
+
+} // namespace Core
@@ -0,0 +1,103 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/latency_histogram.h"
+
+namespace Core {
+
+/// Host latency of a single SVC.
+struct SvcProfile {
+    u32 number;
+    std::string name;
+    Common::LatencySnapshot latency;
+};
+
+/// Host latency of a single command of an HLE service.
+struct ServiceCommandProfile {
+    std::string service_name;
+    u32 command_id;
+    std::string command_name;
+    Common::LatencySnapshot latency;
+};
+
+/// Id and name of one entry of a service handler table.
+struct ServiceCommandInfo {
+    u32 command_id;
+    const char* command_name;
+};
+
+/**
+ * Collects call counts and latency histograms of every SVC and every HLE service command, so the
+ * most expensive ones can be found on real titles. Recording is lock-free and always enabled.
+ * All public functions of this class are thread-safe.
+ */
+class HLEProfiler {
+public:
+    /// Number of SVC numbers that can be recorded, matching the size of the SVC tables.
+    static constexpr std::size_t NumSvcs = 0x80;
+
+    HLEProfiler();
+    ~HLEProfiler();
+
+    HLEProfiler(const HLEProfiler&) = delete;
+    HLEProfiler& operator=(const HLEProfiler&) = delete;
+
+    /// Records the host time spent handling the SVC with the given number.
+    void RecordSvc(u32 number, std::chrono::nanoseconds time);
+
+    /**
+     * Gets the histograms of a service handler table, one per table entry, creating them the
+     * first time the table is registered. Tables are identified by their address rather than by
+     * the service name: several services share a name (am and fsp_srv both have an IStorage),
+     * while every handler table is a static array of its own. Each new instance of a service
+     * (such as every opened IFile) then resolves all its histograms with a single lookup. The
+     * returned array stays valid for the lifetime of the profiler.
+     *
+     * @param describe Returns the id and name of the table entry at the given index. Only called
+     *     when the table is registered for the first time.
+     */
+    Common::LatencyHistogram* GetHandlerTableHistograms(
+        const void* table, std::size_t num_entries, const std::string& service_name,
+        const std::function<ServiceCommandInfo(std::size_t)>& describe);
+
+    /// Returns the profile of every SVC that has been called at least once.
+    std::vector<SvcProfile> GetSvcProfiles() const;
+
+    /// Returns the profile of every service command that has been called at least once.
+    std::vector<ServiceCommandProfile> GetServiceCommandProfiles() const;
+
+    /// Serializes all non-empty profiles into a JSON document.
+    std::string DumpJson() const;
+
+    /// Clears all the recorded samples.
+    void Reset();
+
+private:
+    struct HandlerTable {
+        std::string service_name;
+        std::vector<ServiceCommandInfo> commands;
+        std::unique_ptr<Common::LatencyHistogram[]> histograms;
+    };
+
+    std::array<Common::LatencyHistogram, NumSvcs> svc_latencies;
+
+    /// Keyed by the address of the handler table.
+    std::map<const void*, HandlerTable> handler_tables;
+    mutable std::mutex handler_tables_mutex;
+};
+
+} // namespace Core
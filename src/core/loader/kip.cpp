@@ -74,12 +74,17 @@ AppLoader::LoadResult AppLoader_KIP::Load(Kernel::Process& process) {
     Kernel::CodeSet codeset;
     Kernel::PhysicalMemory program_image;
 
+    // Size the image once up front so the sections can be copied straight into place.
+    program_image.resize(PageAlignSize(kip->GetBSSOffset()) + kip->GetBSSSize());
+
     const auto load_segment = [&program_image](Kernel::CodeSet::Segment& segment,
                                                const std::vector<u8>& data, u32 offset) {
         segment.addr = offset;
         segment.offset = offset;
         segment.size = PageAlignSize(static_cast<u32>(data.size()));
-        program_image.resize(offset + data.size());
+        if (program_image.size() < offset + data.size()) {
+            program_image.resize(offset + data.size());
+        }
         std::memcpy(program_image.data() + offset, data.data(), data.size());
     };
 
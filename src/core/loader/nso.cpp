@@ -2,10 +2,15 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
 #include <cinttypes>
 #include <cstring>
+#include <thread>
 #include <vector>
 
+#include <mbedtls/sha256.h>
+
 #include "common/common_funcs.h"
 #include "common/file_util.h"
 #include "common/hex_util.h"
@@ -35,15 +40,10 @@ struct MODHeader {
 };
 static_assert(sizeof(MODHeader) == 0x1c, "MODHeader has incorrect size.");
 
-std::vector<u8> DecompressSegment(const std::vector<u8>& compressed_data,
-                                  const NSOSegmentHeader& header) {
-    std::vector<u8> uncompressed_data =
-        Common::Compression::DecompressDataLZ4(compressed_data, header.size);
-
-    ASSERT_MSG(uncompressed_data.size() == header.size, "{} != {}", header.size,
-               uncompressed_data.size());
-
-    return uncompressed_data;
+bool VerifySegmentHash(const u8* data, std::size_t size, const NSOHeader::SHA256Hash& expected) {
+    NSOHeader::SHA256Hash hash{};
+    mbedtls_sha256_ret(data, size, hash.data(), 0);
+    return hash == expected;
 }
 
 constexpr u32 PageAlignSize(u32 size) {
@@ -56,6 +56,11 @@ bool NSOHeader::IsSegmentCompressed(size_t segment_num) const {
     return ((flags >> segment_num) & 1) != 0;
 }
 
+bool NSOHeader::IsSegmentHashChecked(size_t segment_num) const {
+    ASSERT_MSG(segment_num < 3, "Invalid segment {}", segment_num);
+    return ((flags >> (segment_num + 3)) & 1) != 0;
+}
+
 AppLoader_NSO::AppLoader_NSO(FileSys::VirtualFile file) : AppLoader(std::move(file)) {}
 
 FileType AppLoader_NSO::IdentifyType(const FileSys::VirtualFile& file) {
@@ -88,21 +93,69 @@ std::optional<VAddr> AppLoader_NSO::LoadModule(Kernel::Process& process,
         return {};
     }
 
-    // Build program image
+    // Build program image. The image is sized up front so that every segment can be read or
+    // decompressed straight into its final location without an intermediate copy.
     Kernel::CodeSet codeset;
     Kernel::PhysicalMemory program_image;
+    std::array<u32, 3> segment_sizes{};
+    std::size_t image_end = 0;
+    for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
+        const auto& segment = nso_header.segments[i];
+        segment_sizes[i] = nso_header.IsSegmentCompressed(i)
+                               ? segment.size
+                               : nso_header.segments_compressed_size[i];
+        image_end = std::max<std::size_t>(image_end,
+                                          std::size_t{segment.location} + segment_sizes[i]);
+        codeset.segments[i].addr = segment.location;
+        codeset.segments[i].offset = segment.location;
+        codeset.segments[i].size = segment.size;
+    }
+    program_image.resize(image_end);
+
+    // File reads are done serially, only the decompression and hashing fan out to workers.
+    std::array<std::vector<u8>, 3> compressed_data;
     for (std::size_t i = 0; i < nso_header.segments.size(); ++i) {
-        std::vector<u8> data =
-            file.ReadBytes(nso_header.segments_compressed_size[i], nso_header.segments[i].offset);
+        const auto& segment = nso_header.segments[i];
         if (nso_header.IsSegmentCompressed(i)) {
-            data = DecompressSegment(data, nso_header.segments[i]);
+            compressed_data[i] =
+                file.ReadBytes(nso_header.segments_compressed_size[i], segment.offset);
+        } else if (file.Read(program_image.data() + segment.location, segment_sizes[i],
+                             segment.offset) != segment_sizes[i]) {
+            LOG_ERROR(Loader, "Failed to read segment {} of {}", i, file.GetName());
+            return {};
         }
-        program_image.resize(nso_header.segments[i].location + static_cast<u32>(data.size()));
-        std::memcpy(program_image.data() + nso_header.segments[i].location, data.data(),
-                    data.size());
-        codeset.segments[i].addr = nso_header.segments[i].location;
-        codeset.segments[i].offset = nso_header.segments[i].location;
-        codeset.segments[i].size = nso_header.segments[i].size;
+    }
+
+    std::array<bool, 3> segment_ok{};
+    const auto process_segment = [&](std::size_t i) {
+        u8* const dest = program_image.data() + nso_header.segments[i].location;
+        if (nso_header.IsSegmentCompressed(i) &&
+            !Common::Compression::DecompressDataLZ4(compressed_data[i].data(),
+                                                    compressed_data[i].size(), dest,
+                                                    segment_sizes[i])) {
+            LOG_ERROR(Loader, "Failed to decompress segment {} of {}", i, file.GetName());
+            return;
+        }
+        if (nso_header.IsSegmentHashChecked(i) &&
+            !VerifySegmentHash(dest, segment_sizes[i], nso_header.segment_hashes[i])) {
+            LOG_WARNING(Loader, "Hash mismatch in segment {} of {}", i, file.GetName());
+        }
+        segment_ok[i] = true;
+    };
+
+    // Text is usually the largest segment, so it is handled on this thread while rodata and
+    // data are processed concurrently.
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < nso_header.segments.size(); ++i) {
+        workers.emplace_back(process_segment, i);
+    }
+    process_segment(0);
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    if (std::find(segment_ok.begin(), segment_ok.end(), false) != segment_ok.end()) {
+        return {};
     }
 
     if (should_pass_arguments && !Settings::values.program_args.empty()) {
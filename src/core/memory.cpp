@@ -31,13 +31,6 @@ struct Memory::Impl {
 
     void SetCurrentPageTable(Kernel::Process& process) {
         current_page_table = &process.PageTable().PageTableImpl();
-
-        const std::size_t address_space_width = process.PageTable().GetAddressSpaceWidth();
-
-        system.ArmInterface(0).PageTableChanged(*current_page_table, address_space_width);
-        system.ArmInterface(1).PageTableChanged(*current_page_table, address_space_width);
-        system.ArmInterface(2).PageTableChanged(*current_page_table, address_space_width);
-        system.ArmInterface(3).PageTableChanged(*current_page_table, address_space_width);
     }
 
     void MapMemoryRegion(Common::PageTable& page_table, VAddr base, u64 size, PAddr target) {
@@ -114,6 +107,27 @@ struct Memory::Impl {
         return {};
     }
 
+    const u8* GetContiguousPointer(const VAddr vaddr, const std::size_t size) const {
+        const std::size_t first_page = vaddr >> PAGE_BITS;
+        const std::size_t last_page = (vaddr + size - 1) >> PAGE_BITS;
+        if (last_page < first_page || last_page >= current_page_table->pointers.size()) {
+            return nullptr;
+        }
+
+        // Pointers are stored relative to the address of their page, so the pages of a
+        // contiguous host allocation all hold the same value.
+        u8* const page_pointer{current_page_table->pointers[first_page]};
+        if (!page_pointer) {
+            return nullptr;
+        }
+        for (std::size_t page = first_page + 1; page <= last_page; ++page) {
+            if (current_page_table->pointers[page] != page_pointer) {
+                return nullptr;
+            }
+        }
+        return page_pointer + vaddr;
+    }
+
     u8 Read8(const VAddr addr) {
         return Read<u8>(addr);
     }
@@ -493,9 +507,14 @@ struct Memory::Impl {
         // granularity of CPU pages, hence why we iterate on a CPU page basis (note: GPU page size
         // is different). This assumes the specified GPU address region is contiguous as well.
 
-        u64 num_pages = ((vaddr + size - 1) >> PAGE_BITS) - (vaddr >> PAGE_BITS) + 1;
-        for (unsigned i = 0; i < num_pages; ++i, vaddr += PAGE_SIZE) {
-            Common::PageType& page_type{current_page_table->attributes[vaddr >> PAGE_BITS]};
+        const u64 first_page = vaddr >> PAGE_BITS;
+        const u64 end_page = ((vaddr + size - 1) >> PAGE_BITS) + 1;
+        Common::PageType* const attributes = current_page_table->attributes.data();
+        u8** const pointers = current_page_table->pointers.data();
+        const u64* const backing_addr = current_page_table->backing_addr.data();
+
+        for (u64 page = first_page; page < end_page; ++page) {
+            Common::PageType& page_type{attributes[page]};
 
             if (cached) {
                 // Switch page type to cached if now cached
@@ -506,7 +525,7 @@ struct Memory::Impl {
                     break;
                 case Common::PageType::Memory:
                     page_type = Common::PageType::RasterizerCachedMemory;
-                    current_page_table->pointers[vaddr >> PAGE_BITS] = nullptr;
+                    pointers[page] = nullptr;
                     break;
                 case Common::PageType::RasterizerCachedMemory:
                     // There can be more than one GPU region mapped per CPU region, so it's common
@@ -527,16 +546,16 @@ struct Memory::Impl {
                     // that this area is already unmarked as cached.
                     break;
                 case Common::PageType::RasterizerCachedMemory: {
-                    u8* pointer{GetPointerFromRasterizerCachedMemory(vaddr & ~PAGE_MASK)};
-                    if (pointer == nullptr) {
+                    const PAddr backing{backing_addr[page]};
+                    if (!backing) {
                         // It's possible that this function has been called while updating the
                         // pagetable after unmapping a VMA. In that case the underlying VMA will no
                         // longer exist, and we should just leave the pagetable entry blank.
                         page_type = Common::PageType::Unmapped;
                     } else {
+                        // Backing addresses are relative to the page, like the pointers are.
                         page_type = Common::PageType::Memory;
-                        current_page_table->pointers[vaddr >> PAGE_BITS] =
-                            pointer - (vaddr & ~PAGE_MASK);
+                        pointers[page] = system.DeviceMemory().GetPointer(backing);
                     }
                     break;
                 }
@@ -563,13 +582,7 @@ struct Memory::Impl {
 
         // During boot, current_page_table might not be set yet, in which case we need not flush
         if (system.IsPoweredOn()) {
-            auto& gpu = system.GPU();
-            for (u64 i = 0; i < size; i++) {
-                const auto page = base + i;
-                if (page_table.attributes[page] == Common::PageType::RasterizerCachedMemory) {
-                    gpu.FlushAndInvalidateRegion(page << PAGE_BITS, PAGE_SIZE);
-                }
-            }
+            FlushRasterizerCachedPages(page_table, base, size);
         }
 
         const VAddr end = base + size;
@@ -577,26 +590,36 @@ struct Memory::Impl {
                    base + page_table.pointers.size());
 
         if (!target) {
-            while (base != end) {
-                page_table.pointers[base] = nullptr;
-                page_table.attributes[base] = type;
-                page_table.backing_addr[base] = 0;
-
-                base += 1;
-            }
-        } else {
-            while (base != end) {
-                page_table.pointers[base] =
-                    system.DeviceMemory().GetPointer(target) - (base << PAGE_BITS);
-                page_table.attributes[base] = type;
-                page_table.backing_addr[base] = target - (base << PAGE_BITS);
-
-                ASSERT_MSG(page_table.pointers[base],
-                           "memory mapping base yield a nullptr within the table");
+            page_table.FillRange(base, size, nullptr, 0, type);
+            return;
+        }
 
-                base += 1;
-                target += PAGE_SIZE;
+        // Pointers and backing addresses are stored relative to the virtual address of the page,
+        // so every page of a contiguous mapping gets the same entries.
+        u8* const pointer = system.DeviceMemory().GetPointer(target) - (base << PAGE_BITS);
+        ASSERT_MSG(pointer, "memory mapping base yield a nullptr within the table");
+        page_table.FillRange(base, size, pointer, target - (base << PAGE_BITS), type);
+    }
+
+    /// Flushes and invalidates every run of rasterizer cached pages within the given range.
+    void FlushRasterizerCachedPages(const Common::PageTable& page_table, u64 base, u64 size) {
+        auto& gpu = system.GPU();
+        const Common::PageType* const attributes = page_table.attributes.data();
+        const Common::PageType* const end = attributes + base + size;
+        const Common::PageType* run_begin = attributes + base;
+        while (true) {
+            run_begin = std::find(run_begin, end, Common::PageType::RasterizerCachedMemory);
+            if (run_begin == end) {
+                break;
             }
+            const Common::PageType* const run_end =
+                std::find_if(run_begin, end, [](Common::PageType type) {
+                    return type != Common::PageType::RasterizerCachedMemory;
+                });
+            const u64 page = static_cast<u64>(run_begin - attributes);
+            const u64 num_pages = static_cast<u64>(run_end - run_begin);
+            gpu.FlushAndInvalidateRegion(page << PAGE_BITS, num_pages * PAGE_SIZE);
+            run_begin = run_end;
         }
     }
 
@@ -732,6 +755,10 @@ const u8* Memory::GetPointer(VAddr vaddr) const {
     return impl->GetPointer(vaddr);
 }
 
+const u8* Memory::GetContiguousPointer(VAddr vaddr, std::size_t size) const {
+    return impl->GetContiguousPointer(vaddr, size);
+}
+
 u8 Memory::Read8(const VAddr addr) {
     return impl->Read8(addr);
 }
@@ -61,6 +61,7 @@ public:
 
     /**
      * Changes the currently active page table to that of the given process instance.
+     * The CPU cores are told about the new page table by the kernel, which owns them.
      *
      * @param process The process to use the page table of.
      */
@@ -160,6 +161,19 @@ public:
      */
     const u8* GetPointer(VAddr vaddr) const;
 
+    /**
+     * Gets a pointer to a range of memory, if it is contiguous in host memory.
+     *
+     * @param vaddr Virtual address of the start of the range.
+     * @param size  Size of the range in bytes, must not be zero.
+     *
+     * @returns The pointer to the given address if every page of the range is mapped to regular
+     *          memory backed by the same host allocation, nullptr otherwise. Ranges touching
+     *          rasterizer cached pages always return nullptr, so GPU caches get a chance to
+     *          flush them through ReadBlock.
+     */
+    const u8* GetContiguousPointer(VAddr vaddr, std::size_t size) const;
+
     /**
      * Reads an 8-bit unsigned value from the current process' address space
      * at the given virtual address.
@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <iterator>
 #include <mutex>
 #include <numeric>
@@ -25,8 +26,27 @@ using std::chrono::microseconds;
 // booting that we shouldn't account for
 constexpr std::size_t IgnoreFrames = 5;
 
+// Bounds the frame lengths kept for percentiles when nothing collects the stats
+constexpr std::size_t MaxFrameLengths = 0x10000;
+
+// Length of the sleeps the frame limiter waits with
+constexpr auto SleepStep = 1ms;
+// Upper bound of the time the frame limiter spins at the end of a wait
+constexpr auto MaxSpinTime = 4ms;
+
 namespace Core {
 
+/// Gets a percentile of the given samples in seconds, with the nearest-rank method.
+static double GetPercentile(std::vector<PerfStats::Clock::duration>& samples, double percentile) {
+    if (samples.empty()) {
+        return 0.0;
+    }
+    const auto rank = static_cast<std::size_t>(std::ceil(percentile / 100.0 * samples.size()));
+    const auto nth = samples.begin() + std::clamp<std::size_t>(rank, 1, samples.size()) - 1;
+    std::nth_element(samples.begin(), nth, samples.end());
+    return duration_cast<DoubleSecs>(*nth).count();
+}
+
 PerfStats::PerfStats(u64 title_id) : title_id(title_id) {}
 
 PerfStats::~PerfStats() {
@@ -49,7 +69,12 @@ PerfStats::~PerfStats() {
 void PerfStats::BeginSystemFrame() {
     std::lock_guard lock{object_mutex};
 
-    frame_begin = Clock::now();
+    const auto now = Clock::now();
+    if (frame_ended && frame_lengths.size() < MaxFrameLengths) {
+        frame_lengths.push_back(now - frame_begin);
+    }
+    frame_ended = false;
+    frame_begin = now;
 }
 
 void PerfStats::EndSystemFrame() {
@@ -66,6 +91,7 @@ void PerfStats::EndSystemFrame() {
 
     previous_frame_length = frame_end - previous_frame_end;
     previous_frame_end = frame_end;
+    frame_ended = true;
 }
 
 void PerfStats::EndGameFrame() {
@@ -100,11 +126,14 @@ PerfStatsResults PerfStats::GetAndResetStats(microseconds current_system_time_us
     results.frametime = duration_cast<DoubleSecs>(accumulated_frametime).count() /
                         static_cast<double>(system_frames);
     results.emulation_speed = system_us_per_second.count() / 1'000'000.0;
+    results.frametime_p50 = GetPercentile(frame_lengths, 50.0);
+    results.frametime_p99 = GetPercentile(frame_lengths, 99.0);
 
     // Reset counters
     reset_point = now;
     reset_point_system_us = current_system_time_us;
     accumulated_frametime = Clock::duration::zero();
+    frame_lengths.clear();
     system_frames = 0;
     game_frames = 0;
 
@@ -118,37 +147,79 @@ double PerfStats::GetLastFrameTimeScale() {
     return duration_cast<DoubleSecs>(previous_frame_length).count() / FRAME_LENGTH;
 }
 
-void FrameLimiter::DoFrameLimiting(microseconds current_system_time_us) {
+void FrameLimiter::DoFrameLimiting(microseconds current_system_time_us, u32 queued_frames) {
+    WaitUntil(NextDeadline(current_system_time_us, queued_frames, Clock::now()));
+}
+
+FrameLimiter::Clock::time_point FrameLimiter::NextDeadline(microseconds current_system_time_us,
+                                                           u32 queued_frames,
+                                                           Clock::time_point now) {
+    const microseconds system_time_delta = current_system_time_us - previous_system_time_us;
+    previous_system_time_us = current_system_time_us;
+
     if (!Settings::values.use_frame_limit) {
-        return;
+        deadline = now;
+        return now;
     }
 
-    auto now = Clock::now();
-
     const double sleep_scale = Settings::values.frame_limit / 100.0;
+    const auto frame_interval = duration_cast<Clock::duration>(
+        std::chrono::duration<double, microseconds::period>(system_time_delta / sleep_scale));
 
     // Max lag caused by slow frames. Shouldn't be more than the length of a frame at the current
     // speed percent or it will clamp too much and prevent this from properly limiting to that
     // percent. High values means it'll take longer after a slow frame to recover and start
     // limiting
-    const microseconds max_lag_time_us = duration_cast<microseconds>(
-        std::chrono::duration<double, std::chrono::microseconds::period>(25ms / sleep_scale));
-    frame_limiting_delta_err += duration_cast<microseconds>(
-        std::chrono::duration<double, std::chrono::microseconds::period>(
-            (current_system_time_us - previous_system_time_us) / sleep_scale));
-    frame_limiting_delta_err -= duration_cast<microseconds>(now - previous_walltime);
-    frame_limiting_delta_err =
-        std::clamp(frame_limiting_delta_err, -max_lag_time_us, max_lag_time_us);
-
-    if (frame_limiting_delta_err > microseconds::zero()) {
-        std::this_thread::sleep_for(frame_limiting_delta_err);
-        auto now_after_sleep = Clock::now();
-        frame_limiting_delta_err -= duration_cast<microseconds>(now_after_sleep - now);
-        now = now_after_sleep;
+    const auto max_lag = duration_cast<Clock::duration>(
+        std::chrono::duration<double, microseconds::period>(25ms / sleep_scale));
+    // Gaps longer than this are loading screens or pauses rather than frames, restart pacing
+    // from them instead of waiting them out
+    const auto max_frame_interval = duration_cast<Clock::duration>(
+        std::chrono::duration<double, microseconds::period>(100ms / sleep_scale));
+
+    if (frame_interval > max_frame_interval) {
+        deadline = now;
+        return now;
     }
 
-    previous_system_time_us = current_system_time_us;
-    previous_walltime = now;
+    // A present that blocked for most of the frame means the host is pacing frames to its own
+    // vsync already. Waiting on top of it would only make this present miss a vblank.
+    if (host_present_time > frame_interval * 3 / 4) {
+        deadline = now;
+        return now;
+    }
+
+    // Frames are due one emulated frame interval after the previous one, no matter how long they
+    // took to emulate. Lag is caught up on by not waiting, up to max_lag.
+    deadline = std::max(deadline + frame_interval, now - max_lag);
+
+    // When the GPU thread is more than a frame behind, let it drain its queue instead of
+    // emulating further ahead of what is shown on screen.
+    if (queued_frames > 1) {
+        deadline += frame_interval * (queued_frames - 1);
+    }
+
+    return deadline;
+}
+
+void FrameLimiter::WaitUntil(Clock::time_point time) {
+    // Sleeps may overshoot by up to a scheduler quantum, so only sleep while more than the longest
+    // recent sleep remains and spin for the rest.
+    auto now = Clock::now();
+    while (time - now > sleep_estimate) {
+        std::this_thread::sleep_for(SleepStep);
+        const auto woken = Clock::now();
+        const auto slept = woken - now;
+        if (slept > sleep_estimate) {
+            sleep_estimate = std::min<Clock::duration>(slept, MaxSpinTime);
+        } else {
+            sleep_estimate -= (sleep_estimate - slept) / 16;
+        }
+        now = woken;
+    }
+    while (Clock::now() < time) {
+        std::this_thread::yield();
+    }
 }
 
 } // namespace Core
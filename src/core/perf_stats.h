@@ -8,6 +8,7 @@
 #include <chrono>
 #include <cstddef>
 #include <mutex>
+#include <vector>
 #include "common/common_types.h"
 
 namespace Core {
@@ -19,6 +20,10 @@ struct PerfStatsResults {
     double game_fps;
     /// Walltime per system frame, in seconds, excluding any waits
     double frametime;
+    /// Median walltime between presented system frames, in seconds, including any waits
+    double frametime_p50;
+    /// 99th percentile of the walltime between presented system frames, in seconds
+    double frametime_p99;
     /// Ratio of walltime / emulated time elapsed
     double emulation_speed;
 };
@@ -70,6 +75,9 @@ private:
 
     /// Cumulative duration (excluding v-sync/frame-limiting) of frames since last reset
     Clock::duration accumulated_frametime = Clock::duration::zero();
+    /// Time between the beginnings of consecutive system frames since last reset, frames begin
+    /// right after the previous one has been presented
+    std::vector<Clock::duration> frame_lengths;
     /// Cumulative number of system frames (LCD VBlanks) presented since last reset
     u32 system_frames = 0;
     /// Cumulative number of game frames (GSP frame submissions) since last reset
@@ -79,24 +87,55 @@ private:
     Clock::time_point previous_frame_end = reset_point;
     /// Point when the current system frame began
     Clock::time_point frame_begin = reset_point;
+    /// Whether the current system frame has ended, so the next one follows it
+    bool frame_ended = false;
     /// Total visible duration (including frame-limiting, etc.) of the previous system frame
     Clock::duration previous_frame_length = Clock::duration::zero();
 };
 
+/**
+ * Paces presented frames to the rate of the emulated system, scaled by the speed limit. Frames are
+ * due at fixed intervals of emulated time, so uneven emulation times don't turn into uneven frame
+ * times, and waits sleep while that is precise enough and spin for the rest.
+ */
 class FrameLimiter {
 public:
-    using Clock = std::chrono::high_resolution_clock;
+    using Clock = std::chrono::steady_clock;
 
-    void DoFrameLimiting(std::chrono::microseconds current_system_time_us);
+    /**
+     * Waits until the frame presented at the given emulated time is due for presentation.
+     * @param current_system_time_us Emulated time at which the guest presented the frame.
+     * @param queued_frames Number of earlier frames the GPU thread has not presented yet.
+     */
+    void DoFrameLimiting(std::chrono::microseconds current_system_time_us, u32 queued_frames);
+
+    /**
+     * Advances the pacing by one frame without waiting, DoFrameLimiting waits on the result.
+     * @param current_system_time_us Emulated time at which the guest presented the frame.
+     * @param queued_frames Number of earlier frames the GPU thread has not presented yet.
+     * @param now Current walltime.
+     * @returns The walltime at which the frame is due, not after now if it is due already.
+     */
+    Clock::time_point NextDeadline(std::chrono::microseconds current_system_time_us,
+                                   u32 queued_frames, Clock::time_point now);
+
+    /// Records the walltime the host took to present the last frame.
+    void SetHostPresentTime(Clock::duration time) {
+        host_present_time = time;
+    }
 
 private:
+    /// Waits until the given point in time with better precision than a plain sleep.
+    void WaitUntil(Clock::time_point time);
+
     /// Emulated system time (in microseconds) at the last limiter invocation
     std::chrono::microseconds previous_system_time_us{0};
-    /// Walltime at the last limiter invocation
-    Clock::time_point previous_walltime = Clock::now();
-
-    /// Accumulated difference between walltime and emulated time
-    std::chrono::microseconds frame_limiting_delta_err{0};
+    /// Walltime at which the last frame was due
+    Clock::time_point deadline = Clock::now();
+    /// Walltime the host took to present the last frame
+    Clock::duration host_present_time = Clock::duration::zero();
+    /// Longest recent time taken by a short sleep, waits shorter than this are spun
+    Clock::duration sleep_estimate = std::chrono::milliseconds{2};
 };
 
 } // namespace Core
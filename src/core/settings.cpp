@@ -113,6 +113,7 @@ void LogSettings() {
                Settings::values.use_asynchronous_gpu_emulation);
     LogSetting("Renderer_UseVsync", Settings::values.use_vsync);
     LogSetting("Renderer_UseAssemblyShaders", Settings::values.use_assembly_shaders);
+    LogSetting("Renderer_VideoWorkerThreads", Settings::values.video_worker_threads);
     LogSetting("Renderer_AnisotropicFilteringLevel", Settings::values.max_anisotropy);
     LogSetting("Audio_OutputEngine", Settings::values.sink_id);
     LogSetting("Audio_EnableAudioStretching", Settings::values.enable_audio_stretching);
@@ -449,6 +449,8 @@ struct Values {
     bool use_assembly_shaders;
     bool force_30fps_mode;
     bool use_fast_gpu_time;
+    bool use_fast_conditional_rendering;
+    u16 video_worker_threads;
 
     float bg_red;
     float bg_green;
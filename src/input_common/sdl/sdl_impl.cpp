@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <cmath>
 #include <functional>
@@ -52,23 +53,26 @@ public:
         : guid{std::move(guid_)}, port{port_}, sdl_joystick{joystick, &SDL_JoystickClose} {}
 
     void SetButton(int button, bool value) {
-        std::lock_guard lock{mutex};
-        state.buttons.insert_or_assign(button, value);
+        if (IsValidIndex(button)) {
+            state.buttons[button].store(value, std::memory_order_relaxed);
+        }
     }
 
     bool GetButton(int button) const {
-        std::lock_guard lock{mutex};
-        return state.buttons.at(button);
+        return IsValidIndex(button) && state.buttons[button].load(std::memory_order_relaxed);
     }
 
     void SetAxis(int axis, Sint16 value) {
-        std::lock_guard lock{mutex};
-        state.axes.insert_or_assign(axis, value);
+        if (IsValidIndex(axis)) {
+            state.axes[axis].store(value, std::memory_order_relaxed);
+        }
     }
 
     float GetAxis(int axis) const {
-        std::lock_guard lock{mutex};
-        return state.axes.at(axis) / 32767.0f;
+        if (!IsValidIndex(axis)) {
+            return 0.0f;
+        }
+        return state.axes[axis].load(std::memory_order_relaxed) / 32767.0f;
     }
 
     std::tuple<float, float> GetAnalog(int axis_x, int axis_y) const {
@@ -89,13 +93,14 @@ public:
     }
 
     void SetHat(int hat, Uint8 direction) {
-        std::lock_guard lock{mutex};
-        state.hats.insert_or_assign(hat, direction);
+        if (IsValidIndex(hat)) {
+            state.hats[hat].store(direction, std::memory_order_relaxed);
+        }
     }
 
     bool GetHatDirection(int hat, Uint8 direction) const {
-        std::lock_guard lock{mutex};
-        return (state.hats.at(hat) & direction) != 0;
+        return IsValidIndex(hat) &&
+               (state.hats[hat].load(std::memory_order_relaxed) & direction) != 0;
     }
     /**
      * The guid of the joystick
@@ -120,15 +125,26 @@ public:
     }
 
 private:
+    /// SDL reports button, axis and hat indices as Uint8, so a fixed table covers all of them.
+    static constexpr std::size_t NUM_INDICES = 0x100;
+
+    static bool IsValidIndex(int index) {
+        return index >= 0 && static_cast<std::size_t>(index) < NUM_INDICES;
+    }
+
+    /**
+     * Latest input of the joystick. The SDL event thread writes it and the emulation thread reads
+     * it once per input poll without taking any lock: every value is independent, so relaxed
+     * atomics are enough.
+     */
     struct State {
-        std::unordered_map<int, bool> buttons;
-        std::unordered_map<int, Sint16> axes;
-        std::unordered_map<int, Uint8> hats;
+        std::array<std::atomic<bool>, NUM_INDICES> buttons{};
+        std::array<std::atomic<Sint16>, NUM_INDICES> axes{};
+        std::array<std::atomic<Uint8>, NUM_INDICES> hats{};
     } state;
     std::string guid;
     int port;
     std::unique_ptr<SDL_Joystick, decltype(&SDL_JoystickClose)> sdl_joystick;
-    mutable std::mutex mutex;
 };
 
 std::shared_ptr<SDLJoystick> SDLState::GetSDLJoystickByGUID(const std::string& guid, int port) {
@@ -407,8 +423,6 @@ public:
             } else {
                 direction = 0;
             }
-            // This is necessary so accessing GetHat with hat won't crash
-            joystick->SetHat(hat, SDL_HAT_CENTERED);
             return std::make_unique<SDLDirectionButton>(joystick, hat, direction);
         }
 
@@ -425,14 +439,10 @@ public:
                 trigger_if_greater = true;
                 LOG_ERROR(Input, "Unknown direction {}", direction_name);
             }
-            // This is necessary so accessing GetAxis with axis won't crash
-            joystick->SetAxis(axis, 0);
             return std::make_unique<SDLAxisButton>(joystick, axis, threshold, trigger_if_greater);
         }
 
         const int button = params.Get("button", 0);
-        // This is necessary so accessing GetButton with button won't crash
-        joystick->SetButton(button, false);
         return std::make_unique<SDLButton>(joystick, button);
     }
 
@@ -460,10 +470,6 @@ public:
         const float deadzone = std::clamp(params.Get("deadzone", 0.0f), 0.0f, .99f);
 
         auto joystick = state.GetSDLJoystickByGUID(guid, port);
-
-        // This is necessary so accessing GetAxis with axis_x and axis_y won't crash
-        joystick->SetAxis(axis_x, 0);
-        joystick->SetAxis(axis_y, 0);
         return std::make_unique<SDLAnalog>(joystick, axis_x, axis_y, deadzone);
     }
 
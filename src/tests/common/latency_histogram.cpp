@@ -0,0 +1,86 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/latency_histogram.h"
+
+namespace Common {
+
+using namespace std::chrono_literals;
+
+TEST_CASE("LatencyHistogram: Buckets by power of two", "[common]") {
+    LatencyHistogram histogram;
+    histogram.Record(0ns);
+    histogram.Record(1ns);
+    histogram.Record(2ns);
+    histogram.Record(3ns);
+    histogram.Record(1000ns);
+    histogram.Record(-5ns);
+
+    const auto snapshot = histogram.GetSnapshot();
+    REQUIRE(snapshot.count == 6);
+    REQUIRE(snapshot.buckets[0] == 3);
+    REQUIRE(snapshot.buckets[1] == 2);
+    REQUIRE(snapshot.buckets[9] == 1);
+    REQUIRE(snapshot.total_ns == 1006);
+    REQUIRE(snapshot.MaxTime() == 1000ns);
+    REQUIRE(snapshot.MeanTime() == 167ns);
+
+    histogram.Reset();
+    REQUIRE(histogram.GetSnapshot().count == 0);
+    REQUIRE(histogram.GetSnapshot().Percentile(99.0) == 0ns);
+}
+
+TEST_CASE("LatencyHistogram: Percentiles", "[common]") {
+    LatencyHistogram histogram;
+    for (int i = 0; i < 99; ++i) {
+        histogram.Record(100ns);
+    }
+    histogram.Record(1ms);
+
+    const auto snapshot = histogram.GetSnapshot();
+    // 100ns falls in the [64, 128) bucket
+    REQUIRE(snapshot.Percentile(50.0) == 127ns);
+    REQUIRE(snapshot.Percentile(99.0) == 127ns);
+    // The top bucket bound is clamped to the largest sample
+    REQUIRE(snapshot.Percentile(100.0) == 1ms);
+}
+
+TEST_CASE("LatencyHistogram: Concurrent recording", "[common]") {
+    constexpr std::size_t num_threads = 4;
+    constexpr u64 iterations = 10000;
+
+    LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&histogram, i] {
+            for (u64 j = 0; j < iterations; ++j) {
+                histogram.Record(std::chrono::nanoseconds{static_cast<s64>(i * iterations + j)});
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    const auto snapshot = histogram.GetSnapshot();
+    const u64 total_samples = num_threads * iterations;
+    REQUIRE(snapshot.count == total_samples);
+    REQUIRE(snapshot.total_ns == total_samples * (total_samples - 1) / 2);
+    REQUIRE(snapshot.max_ns == total_samples - 1);
+
+    u64 bucket_sum = 0;
+    for (const u64 bucket : snapshot.buckets) {
+        bucket_sum += bucket;
+    }
+    REQUIRE(bucket_sum == total_samples);
+}
+
+} // namespace Common
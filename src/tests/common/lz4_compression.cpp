@@ -0,0 +1,54 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/common_types.h"
+#include "common/lz4_compression.h"
+
+namespace Common::Compression {
+
+namespace {
+std::vector<u8> MakeSegmentLikeData(std::size_t size) {
+    // Mix of runs and noise, roughly resembling the compressibility of code segments.
+    std::vector<u8> data(size);
+    u32 state = 0x12345678;
+    for (std::size_t i = 0; i < size; ++i) {
+        state = state * 1103515245 + 12345;
+        data[i] = (i & 0x40) != 0 ? static_cast<u8>(i >> 8) : static_cast<u8>(state >> 24);
+    }
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("LZ4: Decompress into caller buffer", "[common]") {
+    for (const std::size_t size : {0x1000, 0x10000, 0x100000, 0x800000}) {
+        const auto source = MakeSegmentLikeData(size);
+        const auto compressed = CompressDataLZ4(source.data(), source.size());
+
+        // Decompress into the middle of a larger image, as the NSO loader does.
+        std::vector<u8> image(size + 0x2000, 0xCD);
+        REQUIRE(DecompressDataLZ4(compressed.data(), compressed.size(), image.data() + 0x1000,
+                                  size));
+        REQUIRE(std::equal(source.begin(), source.end(), image.begin() + 0x1000));
+        REQUIRE(image[0xFFF] == 0xCD);
+        REQUIRE(image[0x1000 + size] == 0xCD);
+
+        REQUIRE(DecompressDataLZ4(compressed, size) == source);
+    }
+}
+
+TEST_CASE("LZ4: Decompress with wrong size fails", "[common]") {
+    const auto source = MakeSegmentLikeData(0x4000);
+    const auto compressed = CompressDataLZ4(source.data(), source.size());
+
+    std::vector<u8> too_small(source.size() - 1);
+    REQUIRE_FALSE(DecompressDataLZ4(compressed.data(), compressed.size(), too_small.data(),
+                                    too_small.size()));
+    REQUIRE(DecompressDataLZ4(compressed, source.size() + 1).empty());
+}
+
+} // namespace Common::Compression
@@ -0,0 +1,147 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/multi_level_page_table.h"
+#include "common/page_table.h"
+
+namespace Common {
+
+namespace {
+// Same layout as the GPU memory manager: 40-bit address space with 64 KiB pages.
+constexpr std::size_t AddressSpaceBits = 40;
+constexpr std::size_t PageBits = 16;
+constexpr std::size_t SecondLevelBits = 10;
+constexpr std::size_t SecondLevelSize = std::size_t{1} << SecondLevelBits;
+
+/// Number of pages in 1 MiB, the size of a typical remapped buffer.
+constexpr std::size_t BufferPages = (1ULL << 20) >> PageBits;
+} // Anonymous namespace
+
+TEST_CASE("MultiLevelPageTable: Map and unmap ranges", "[common]") {
+    MultiLevelPageTable page_table{AddressSpaceBits, PageBits, SecondLevelBits};
+    REQUIRE(page_table.GetNumPages() == std::size_t{1} << (AddressSpaceBits - PageBits));
+    REQUIRE(page_table.Get(0) == 0);
+    REQUIRE(page_table.Get(page_table.GetNumPages() - 1) == 0);
+
+    // Cross the boundary between two second level tables.
+    const std::size_t first_page = SecondLevelSize - 4;
+    page_table.Map(first_page, 8, 0x80000000);
+    REQUIRE(page_table.Get(first_page - 1) == 0);
+    for (std::size_t i = 0; i < 8; ++i) {
+        REQUIRE(page_table.Get(first_page + i) == 0x80000000 + (i << PageBits));
+    }
+    REQUIRE(page_table.Get(first_page + 8) == 0);
+
+    page_table.Unmap(first_page + 2, 4);
+    REQUIRE(page_table.Get(first_page + 1) == 0x80000000 + (1 << PageBits));
+    REQUIRE(page_table.Get(first_page + 2) == 0);
+    REQUIRE(page_table.Get(first_page + 5) == 0);
+    REQUIRE(page_table.Get(first_page + 6) == 0x80000000 + (6 << PageBits));
+
+    // Unmapping pages that were never mapped does not need any second level table.
+    page_table.Unmap(0, page_table.GetNumPages());
+    REQUIRE(page_table.Get(first_page) == 0);
+    REQUIRE(page_table.Get(first_page + 7) == 0);
+}
+
+TEST_CASE("MultiLevelPageTable: Lookups while remapping", "[common]") {
+    MultiLevelPageTable page_table{AddressSpaceBits, PageBits, SecondLevelBits};
+    constexpr std::size_t num_pages = SecondLevelSize * 64;
+
+    // Every page maps to an address derived from its index, so a lookup can only see that value
+    // or zero, no matter how it interleaves with the remapping thread.
+    std::atomic<bool> stop{false};
+    std::atomic<bool> consistent{true};
+    std::thread reader([&] {
+        std::mt19937 rng{0x1234};
+        while (!stop.load(std::memory_order_relaxed)) {
+            const std::size_t page = rng() % num_pages;
+            const u64 address = page_table.Get(page);
+            if (address != 0 && address != (static_cast<u64>(page) << PageBits)) {
+                consistent = false;
+            }
+        }
+    });
+
+    std::mt19937 rng{0x5678};
+    for (std::size_t i = 0; i < 20000; ++i) {
+        const std::size_t page = rng() % (num_pages - BufferPages);
+        if (rng() % 2 == 0) {
+            page_table.Map(page, BufferPages, static_cast<u64>(page) << PageBits);
+        } else {
+            page_table.Unmap(page, BufferPages);
+        }
+    }
+    stop = true;
+    reader.join();
+
+    REQUIRE(consistent);
+}
+
+TEST_CASE("MultiLevelPageTable: Translation and remap throughput", "[common][!benchmark]") {
+    constexpr std::size_t num_buffers = 4096;
+    constexpr std::size_t num_lookups = 1 << 22;
+
+    MultiLevelPageTable page_table{AddressSpaceBits, PageBits, SecondLevelBits};
+    // The flat table the GPU memory manager used before, reserving every entry up front.
+    PageTable flat_table;
+    flat_table.Resize(AddressSpaceBits, PageBits, false);
+
+    // Scatter buffers over the address space, the way separate allocations end up.
+    std::mt19937 rng{0x1234};
+    std::vector<std::size_t> buffers(num_buffers);
+    for (auto& page : buffers) {
+        page = (rng() % (page_table.GetNumPages() / BufferPages)) * BufferPages;
+        const u64 address = 0x80000000 + (static_cast<u64>(page) << PageBits);
+        page_table.Map(page, BufferPages, address);
+        for (std::size_t i = 0; i < BufferPages; ++i) {
+            flat_table.backing_addr[page + i] = address + (static_cast<u64>(i) << PageBits);
+        }
+    }
+    std::vector<std::size_t> lookups(num_lookups);
+    for (auto& page : lookups) {
+        page = buffers[rng() % num_buffers] + rng() % BufferPages;
+    }
+
+    u64 flat_sum = 0;
+    const auto flat_start = std::chrono::steady_clock::now();
+    for (const std::size_t page : lookups) {
+        flat_sum += flat_table.backing_addr[page];
+    }
+    const std::chrono::duration<double> flat_time = std::chrono::steady_clock::now() - flat_start;
+
+    u64 sum = 0;
+    const auto lookup_start = std::chrono::steady_clock::now();
+    for (const std::size_t page : lookups) {
+        sum += page_table.Get(page);
+    }
+    const std::chrono::duration<double> lookup_time =
+        std::chrono::steady_clock::now() - lookup_start;
+
+    const auto remap_start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < num_buffers; ++i) {
+        page_table.Unmap(buffers[i], BufferPages);
+        page_table.Map(buffers[i], BufferPages, 0x80000000);
+    }
+    const std::chrono::duration<double> remap_time =
+        std::chrono::steady_clock::now() - remap_start;
+
+    WARN("flat lookup: " << flat_time.count() * 1e9 / num_lookups
+                         << " ns, multi-level lookup: " << lookup_time.count() * 1e9 / num_lookups
+                         << " ns, 1 MiB remap: " << remap_time.count() * 1e9 / num_buffers
+                         << " ns");
+    REQUIRE(sum == flat_sum);
+}
+
+} // namespace Common
@@ -0,0 +1,149 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/multi_level_queue.h"
+#include "common/spin_lock.h"
+
+namespace Common {
+
+TEST_CASE("SpinLock: Provides mutual exclusion", "[common]") {
+    constexpr std::size_t num_threads = 4;
+    constexpr u32 iterations = 100000;
+
+    SpinLock lock;
+    u64 counter = 0;
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < num_threads; ++i) {
+        threads.emplace_back([&] {
+            for (u32 j = 0; j < iterations; ++j) {
+                std::scoped_lock guard{lock};
+                ++counter;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(counter == num_threads * iterations);
+
+    REQUIRE(lock.try_lock());
+    REQUIRE(!lock.try_lock());
+    lock.unlock();
+}
+
+TEST_CASE("RecursiveSpinLock: Tracks the owner and depth", "[common]") {
+    RecursiveSpinLock lock;
+    REQUIRE(!lock.IsLockedBy(1));
+
+    lock.lock(1);
+    lock.lock(1);
+    REQUIRE(lock.IsLockedBy(1));
+    REQUIRE(lock.GetDepth() == 2);
+
+    std::atomic<bool> acquired{false};
+    std::thread other([&] {
+        lock.lock(2);
+        acquired = true;
+        lock.unlock();
+    });
+
+    lock.unlock();
+    REQUIRE(lock.IsLockedBy(1));
+    REQUIRE(!acquired);
+    lock.unlock();
+
+    other.join();
+    REQUIRE(acquired);
+    REQUIRE(!lock.IsLockedBy(1));
+}
+
+// Mirrors the GlobalScheduler queue layout: each host thread plays a core that keeps yielding its
+// front thread and migrating threads between its scheduled and suggested queues, while stealing
+// suggested threads from its neighbour ("wake" storm).
+TEST_CASE("SpinLock: Scheduler queue yield/wake storm", "[common]") {
+    constexpr std::size_t num_cores = 4;
+    constexpr std::size_t threads_per_core = 16;
+    constexpr u32 iterations = 20000;
+    constexpr u32 depth = 64;
+
+    struct Core {
+        SpinLock lock;
+        MultiLevelQueue<u32, depth> scheduled;
+        MultiLevelQueue<u32, depth> suggested;
+    };
+    std::array<Core, num_cores> cores;
+
+    for (std::size_t core = 0; core < num_cores; ++core) {
+        for (u32 i = 0; i < threads_per_core; ++i) {
+            const u32 id = static_cast<u32>(core * threads_per_core + i);
+            cores[core].scheduled.add(id, id % depth);
+        }
+    }
+
+    std::vector<std::thread> host_threads;
+    for (std::size_t core = 0; core < num_cores; ++core) {
+        host_threads.emplace_back([&, core] {
+            auto& self = cores[core];
+            auto& neighbour = cores[(core + 1) % num_cores];
+            for (u32 i = 0; i < iterations; ++i) {
+                {
+                    // Yield: rotate the front priority level
+                    std::scoped_lock lock{self.lock};
+                    if (!self.scheduled.empty()) {
+                        const u32 front = self.scheduled.front();
+                        self.scheduled.yield(front % depth);
+                        if (i % 3 == 0) {
+                            self.scheduled.transfer_to_back(front, front % depth, self.suggested);
+                        }
+                    }
+                }
+
+                // Wake: steal a suggested thread from the neighbour and schedule it locally.
+                // The locks are taken one after the other, as in GlobalScheduler::TransferToCore.
+                u32 stolen{};
+                bool have_stolen = false;
+                {
+                    std::scoped_lock lock{neighbour.lock};
+                    if (!neighbour.suggested.empty()) {
+                        stolen = neighbour.suggested.front();
+                        neighbour.suggested.remove(stolen, stolen % depth);
+                        have_stolen = true;
+                    }
+                }
+                if (have_stolen) {
+                    std::scoped_lock lock{self.lock};
+                    self.scheduled.add(stolen, stolen % depth);
+                }
+            }
+        });
+    }
+    for (auto& thread : host_threads) {
+        thread.join();
+    }
+
+    // No thread may have been lost or duplicated by the migrations
+    std::vector<u32> seen(num_cores * threads_per_core);
+    for (auto& core : cores) {
+        for (const u32 id : core.scheduled) {
+            ++seen[id];
+        }
+        for (const u32 id : core.suggested) {
+            ++seen[id];
+        }
+    }
+    for (const u32 count : seen) {
+        REQUIRE(count == 1);
+    }
+}
+
+} // namespace Common
@@ -0,0 +1,162 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <future>
+#include <mutex>
+#include <vector>
+
+#include "common/thread_pool.h"
+
+namespace Common {
+
+namespace {
+/// Keeps the worker running it busy until it is released.
+class Blocker {
+public:
+    void Block() {
+        is_blocking.set_value();
+        release_future.wait();
+    }
+
+    void WaitUntilBlocking() {
+        blocking_future.wait();
+    }
+
+    void Release() {
+        release.set_value();
+    }
+
+private:
+    std::promise<void> is_blocking;
+    std::future<void> blocking_future = is_blocking.get_future();
+    std::promise<void> release;
+    std::shared_future<void> release_future = release.get_future().share();
+};
+
+double Work(std::size_t index) {
+    double value = static_cast<double>(index);
+    for (int i = 0; i < 2000; ++i) {
+        value = std::sqrt(value + i);
+    }
+    return value;
+}
+} // Anonymous namespace
+
+TEST_CASE("ThreadPool: ParallelFor runs every index once", "[common]") {
+    ThreadPool pool{"Test", 4};
+    REQUIRE(pool.NumWorkers() == 4);
+
+    std::vector<std::atomic<int>> visits(10007);
+    pool.ParallelFor(visits.size(), 13, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            ++visits[i];
+        }
+    });
+    for (const auto& count : visits) {
+        REQUIRE(count == 1);
+    }
+
+    // Nested calls from every worker at once can't deadlock, the callers run chunks themselves
+    std::vector<std::future<std::size_t>> results;
+    for (std::size_t i = 0; i < pool.NumWorkers(); ++i) {
+        results.push_back(pool.Async([&pool] {
+            std::atomic<std::size_t> sum{0};
+            pool.ParallelFor(1000, 10, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    sum += i;
+                }
+            });
+            return sum.load();
+        }));
+    }
+    for (auto& result : results) {
+        REQUIRE(result.get() == 999 * 1000 / 2);
+    }
+}
+
+TEST_CASE("ThreadPool: Higher priority tasks run first", "[common]") {
+    // Declared before the pool, the worker still references it until the pool has joined
+    Blocker blocker;
+    ThreadPool pool{"Test", 1};
+    pool.Submit([&] { blocker.Block(); });
+    blocker.WaitUntilBlocking();
+
+    std::mutex mutex;
+    std::vector<TaskPriority> order;
+    const auto record = [&](TaskPriority priority) {
+        return [&, priority] {
+            std::scoped_lock lock{mutex};
+            order.push_back(priority);
+        };
+    };
+    pool.Submit(record(TaskPriority::Low), TaskPriority::Low);
+    pool.Submit(record(TaskPriority::Normal), TaskPriority::Normal);
+    auto last = pool.Async(record(TaskPriority::High), TaskPriority::High);
+    blocker.Release();
+
+    last.wait();
+    // Wait for the remaining tasks by queueing one behind them
+    pool.Async([] {}, TaskPriority::Low).wait();
+    const std::vector expected{TaskPriority::High, TaskPriority::Normal, TaskPriority::Low};
+    REQUIRE(order == expected);
+}
+
+TEST_CASE("ThreadPool: Idle workers steal queued tasks", "[common]") {
+    Blocker blocker;
+    ThreadPool pool{"Test", 2};
+    pool.Submit([&] { blocker.Block(); });
+    blocker.WaitUntilBlocking();
+
+    // One of the workers is busy, so the tasks affine to it have to be stolen to make progress
+    std::vector<std::future<void>> tasks;
+    for (std::size_t worker = 0; worker < pool.NumWorkers(); ++worker) {
+        for (int i = 0; i < 16; ++i) {
+            tasks.push_back(pool.Async([] {}, TaskPriority::Normal, worker));
+        }
+    }
+    for (auto& task : tasks) {
+        task.wait();
+    }
+    blocker.Release();
+
+    REQUIRE(pool.GetStats().tasks_stolen >= 16);
+}
+
+TEST_CASE("ThreadPool: ParallelFor throughput", "[common][!benchmark]") {
+    constexpr std::size_t count = 1 << 14;
+    ThreadPool pool{"Test", 4};
+
+    std::vector<double> serial(count);
+    const auto serial_start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count; ++i) {
+        serial[i] = Work(i);
+    }
+    const std::chrono::duration<double> serial_time =
+        std::chrono::steady_clock::now() - serial_start;
+
+    std::vector<double> parallel(count);
+    const auto parallel_start = std::chrono::steady_clock::now();
+    pool.ParallelFor(count, 64, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            parallel[i] = Work(i);
+        }
+    });
+    const std::chrono::duration<double> parallel_time =
+        std::chrono::steady_clock::now() - parallel_start;
+
+    const ThreadPoolStats stats = pool.GetStats();
+    WARN("serial: " << serial_time.count() * 1000.0
+                    << " ms, parallel: " << parallel_time.count() * 1000.0 << " ms, "
+                    << stats.tasks_executed << " tasks, " << stats.Utilization() * 100.0
+                    << "% utilization");
+    REQUIRE(parallel == serial);
+}
+
+} // namespace Common
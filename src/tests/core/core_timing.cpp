@@ -7,12 +7,15 @@
 #include <array>
 #include <bitset>
 #include <cstdlib>
+#include <future>
 #include <memory>
 #include <string>
+#include <thread>
 
 #include "common/file_util.h"
 #include "core/core.h"
 #include "core/core_timing.h"
+#include "core/hle/lock.h"
 
 namespace {
 // Numbers are chosen randomly to make sure the correct one is given.
@@ -38,6 +41,19 @@ void EmptyCallback(u64 userdata, s64 cycles_late) {
     ++callbacks_done;
 }
 
+bool callback_held_hle_lock = false;
+
+void HleLockCallback(u64 userdata, s64 cycles_late) {
+    // The lock is recursive, so whether it is held has to be checked from another thread.
+    callback_held_hle_lock = !std::async(std::launch::async, [] {
+                                 const bool locked = HLE::g_hle_lock.try_lock();
+                                 if (locked) {
+                                     HLE::g_hle_lock.unlock();
+                                 }
+                                 return locked;
+                             }).get();
+}
+
 struct ScopeInit final {
     ScopeInit() {
         core_timing.Initialize();
@@ -138,6 +154,79 @@ TEST_CASE("CoreTiming[FairSharing]", "[core]") {
     REQUIRE(current_time_2 == current_time + MAX_SLICE_LENGTH * 4);
 }
 
+TEST_CASE("CoreTiming[Multicore]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+    core_timing.SetMulticore(true);
+
+    std::shared_ptr<Core::Timing::EventType> empty_callback =
+        Core::Timing::CreateEvent("empty_callback", EmptyCallback);
+
+    callbacks_done = 0;
+    constexpr u64 MAX_CALLBACKS = 10;
+    for (std::size_t i = 0; i < MAX_CALLBACKS; i++) {
+        core_timing.ScheduleEvent(i * 3333U, empty_callback, 0);
+    }
+
+    const s64 advances = MAX_SLICE_LENGTH / 10;
+    core_timing.ResetRun();
+    const u64 current_time = core_timing.GetTicks();
+
+    // Every core drives its own context from its own host thread, as the CPU manager does.
+    std::array<std::thread, 4> threads;
+    for (u32 core = 0; core < threads.size(); ++core) {
+        threads[core] = std::thread([&core_timing, core, advances] {
+            core_timing.SwitchContext(core);
+            while (core_timing.CanCurrentContextRun()) {
+                core_timing.AddTicks(std::min<s64>(advances, core_timing.GetDowncount()));
+                core_timing.Advance();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    core_timing.SwitchContext(0);
+    REQUIRE(MAX_CALLBACKS == callbacks_done);
+    REQUIRE(core_timing.GetTicks() == current_time + MAX_SLICE_LENGTH * 4);
+}
+
+TEST_CASE("CoreTiming[CallbacksHoldHleLock]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+    core_timing.SetMulticore(true);
+
+    std::shared_ptr<Core::Timing::EventType> cb =
+        Core::Timing::CreateEvent("hle_lock_callback", HleLockCallback);
+    core_timing.ScheduleEvent(100, cb, 0);
+    core_timing.ResetRun();
+
+    callback_held_hle_lock = false;
+    core_timing.SwitchContext(0);
+    core_timing.AddTicks(core_timing.GetDowncount());
+    core_timing.Advance();
+
+    REQUIRE(callback_held_hle_lock);
+}
+
+TEST_CASE("CoreTiming[OtherThreadsReadGlobalTime]", "[core]") {
+    ScopeInit guard;
+    auto& core_timing = guard.core_timing;
+    core_timing.ResetRun();
+
+    core_timing.SwitchContext(0);
+    core_timing.AddTicks(1000);
+    core_timing.Advance();
+    core_timing.AddTicks(300);
+    REQUIRE(core_timing.GetTicks() == 1300);
+
+    // Threads that don't emulate a core don't see the ticks of a slice still running.
+    const u64 other_thread_ticks =
+        std::async(std::launch::async, [&core_timing] { return core_timing.GetTicks(); }).get();
+    REQUIRE(other_thread_ticks == 1000);
+}
+
 TEST_CASE("Core::Timing[PredictableLateness]", "[core]") {
     ScopeInit guard;
     auto& core_timing = guard.core_timing;
@@ -150,6 +239,7 @@ TEST_CASE("Core::Timing[PredictableLateness]", "[core]") {
     // Enter slice 0
     core_timing.ResetRun();
 
+    core_timing.SwitchContext(0);
     core_timing.ScheduleEvent(100, cb_a, CB_IDS[0]);
     core_timing.ScheduleEvent(200, cb_b, CB_IDS[1]);
 
@@ -0,0 +1,82 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/file_sys/vfs.h"
+#include "core/file_sys/vfs_vector.h"
+
+namespace FileSys {
+
+namespace {
+std::vector<u8> MakeData(std::size_t size) {
+    std::vector<u8> data(size);
+    u32 state = 0xDEADBEEF;
+    for (auto& byte : data) {
+        state = state * 1664525 + 1013904223;
+        byte = static_cast<u8>(state >> 24);
+    }
+    return data;
+}
+} // Anonymous namespace
+
+TEST_CASE("VfsPipelinedCopy: Copies and hashes in-memory files", "[core][file_sys]") {
+    constexpr std::size_t size = 0x2000000 + 0x1234; // Deliberately not a multiple of the block
+    const auto src = std::make_shared<VectorVfsFile>(MakeData(size), "src");
+
+    std::array<u8, 0x20> single_block_hash{};
+    {
+        const auto dest = std::make_shared<VectorVfsFile>();
+        REQUIRE(VfsPipelinedCopy(src, dest, size, &single_block_hash));
+        REQUIRE(DeepEquals(src, dest, 0x100000));
+    }
+
+    const auto dest = std::make_shared<VectorVfsFile>();
+    std::array<u8, 0x20> hash{};
+    std::size_t last_progress = 0;
+    bool progress_monotonic = true;
+
+    const auto start = std::chrono::steady_clock::now();
+    REQUIRE(VfsPipelinedCopy(src, dest, 0x100000, &hash, [&](std::size_t written) {
+        progress_monotonic &= written > last_progress;
+        last_progress = written;
+        return true;
+    }));
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    INFO("Throughput: " << size / elapsed.count() / 0x100000 << " MiB/s");
+
+    REQUIRE(dest->GetSize() == size);
+    REQUIRE(DeepEquals(src, dest, 0x100000));
+    REQUIRE(progress_monotonic);
+    REQUIRE(last_progress == size);
+    REQUIRE(hash == single_block_hash);
+}
+
+TEST_CASE("VfsPipelinedCopy: Progress callback can cancel", "[core][file_sys]") {
+    const auto src = std::make_shared<VectorVfsFile>(MakeData(0x100000), "src");
+    const auto dest = std::make_shared<VectorVfsFile>();
+
+    std::size_t calls = 0;
+    REQUIRE_FALSE(VfsPipelinedCopy(src, dest, 0x1000, nullptr, [&](std::size_t written) {
+        ++calls;
+        return written < 0x4000;
+    }));
+    REQUIRE(calls == 4);
+}
+
+TEST_CASE("VfsPipelinedCopy: Empty file", "[core][file_sys]") {
+    const auto src = std::make_shared<VectorVfsFile>(std::vector<u8>{}, "src");
+    const auto dest = std::make_shared<VectorVfsFile>(MakeData(0x10));
+    std::array<u8, 0x20> hash{};
+    REQUIRE(VfsPipelinedCopy(src, dest, 0x1000, &hash));
+    REQUIRE(dest->GetSize() == 0);
+}
+
+} // namespace FileSys
@@ -0,0 +1,126 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/hle/ipc.h"
+#include "core/hle/ipc_helpers.h"
+#include "core/hle/kernel/client_session.h"
+#include "core/hle/kernel/handle_table.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/server_session.h"
+#include "core/hle/kernel/session.h"
+#include "core/hle/kernel/thread.h"
+#include "core/memory.h"
+#include "tests/core/memory_test_common.h"
+
+namespace Kernel {
+
+namespace {
+constexpr VAddr buffer_page = 0x10000;
+constexpr std::size_t buffer_size = 0x200;
+
+/// Guest memory where the page after buffer_page lives at an unrelated host address.
+struct SplitMemory {
+    SplitMemory() : host(3 * Core::Memory::PAGE_SIZE) {
+        env.MapMemory(buffer_page, host.data(), Core::Memory::PAGE_SIZE);
+        env.MapMemory(buffer_page + Core::Memory::PAGE_SIZE,
+                      host.data() + 2 * Core::Memory::PAGE_SIZE, Core::Memory::PAGE_SIZE);
+    }
+
+    /// Returns the host memory backing the given guest address.
+    u8* HostPointer(VAddr vaddr) {
+        const std::size_t offset = vaddr - buffer_page;
+        return offset < Core::Memory::PAGE_SIZE ? host.data() + offset
+                                                : host.data() + Core::Memory::PAGE_SIZE + offset;
+    }
+
+    /// Fills the guest range with a pattern depending on the guest address.
+    void Fill(VAddr vaddr, std::size_t size) {
+        for (std::size_t i = 0; i < size; ++i) {
+            *HostPointer(vaddr + i) = static_cast<u8>((vaddr + i) * 7);
+        }
+    }
+
+    MemoryTests::TestEnvironment env;
+    std::vector<u8> host;
+};
+
+/// Translates a request carrying a single A buffer descriptor, as svcSendSyncRequest does.
+std::shared_ptr<HLERequestContext> MakeRequest(VAddr address, u32 size) {
+    auto& system = Core::System::GetInstance();
+    auto& kernel = system.Kernel();
+
+    std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf{};
+    IPC::ResponseBuilder rb{cmd_buf.data()};
+
+    IPC::CommandHeader header{};
+    header.type.Assign(IPC::CommandType::Request);
+    header.num_buf_a_descriptors.Assign(1);
+    // Payload header, padding and command id
+    header.data_size.Assign(sizeof(IPC::DataPayloadHeader) / sizeof(u32) + 4 + 2);
+    rb.PushRaw(header);
+
+    IPC::BufferDescriptorABW descriptor{};
+    descriptor.address_bits_0_31 = static_cast<u32>(address);
+    descriptor.size_bits_0_31 = size;
+    rb.PushRaw(descriptor);
+    rb.AlignWithPadding();
+
+    IPC::DataPayloadHeader data_payload_header{};
+    data_payload_header.magic = Common::MakeMagic('S', 'F', 'C', 'I');
+    rb.PushRaw(data_payload_header);
+    rb.Push<u64>(0);
+
+    auto [client, server] = Session::Create(kernel, "test");
+    auto context = std::make_shared<HLERequestContext>(kernel, system.Memory(), server,
+                                                       std::make_shared<Thread>(kernel));
+    HandleTable handle_table;
+    context->PopulateFromIncomingCommandBuffer(handle_table, cmd_buf.data());
+    return context;
+}
+} // Anonymous namespace
+
+TEST_CASE("HLERequestContext: Reads contiguous buffers in place", "[core][kernel]") {
+    SplitMemory memory;
+    constexpr VAddr address = buffer_page + 0x100;
+    memory.Fill(address, buffer_size);
+
+    const auto context = MakeRequest(address, buffer_size);
+    ScratchBuffer scratch;
+    const auto buffer = context->ReadBufferSpan(scratch, 0);
+
+    REQUIRE(buffer.size() == buffer_size);
+    REQUIRE(buffer.data() == memory.HostPointer(address));
+    REQUIRE(scratch.empty());
+}
+
+TEST_CASE("HLERequestContext: Copies buffers straddling host allocations", "[core][kernel]") {
+    SplitMemory memory;
+    constexpr VAddr address = buffer_page + Core::Memory::PAGE_SIZE - buffer_size / 2;
+    memory.Fill(address, buffer_size);
+
+    const auto context = MakeRequest(address, buffer_size);
+    ScratchBuffer scratch;
+    const auto buffer = context->ReadBufferSpan(scratch, 0);
+
+    REQUIRE(buffer.size() == buffer_size);
+    REQUIRE(buffer.data() == scratch.data());
+    for (std::size_t i = 0; i < buffer_size; ++i) {
+        REQUIRE(buffer[i] == *memory.HostPointer(address + i));
+    }
+    // The copying path must read the same bytes as ReadBuffer
+    const auto copy = context->ReadBuffer(0);
+    REQUIRE(std::vector<u8>(buffer.begin(), buffer.end()) == copy);
+}
+
+} // namespace Kernel
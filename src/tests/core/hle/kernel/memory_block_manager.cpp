@@ -0,0 +1,122 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/hle/kernel/memory/memory_block_manager.h"
+
+namespace Kernel::Memory {
+
+namespace {
+constexpr VAddr BaseAddress = 0x8000000;
+constexpr std::size_t NumPages = 0x10000;
+
+constexpr std::array States{MemoryState::Free, MemoryState::Normal, MemoryState::Stack,
+                            MemoryState::Code};
+
+struct PageState {
+    MemoryState state;
+    MemoryPermission perm;
+};
+
+/// Applies random updates to the manager and a page by page reference model of it.
+class RandomUpdater {
+public:
+    RandomUpdater() : pages(NumPages, PageState{MemoryState::Free, MemoryPermission::None}) {}
+
+    void Update(MemoryBlockManager& manager) {
+        const std::size_t page = std::uniform_int_distribution<std::size_t>{0, NumPages - 1}(rng);
+        const std::size_t max_pages = std::min<std::size_t>(NumPages - page, 16);
+        const std::size_t num_pages = std::uniform_int_distribution<std::size_t>{1, max_pages}(rng);
+        const MemoryState state = States[rng() % States.size()];
+        const MemoryPermission perm =
+            state == MemoryState::Free ? MemoryPermission::None : MemoryPermission::ReadAndWrite;
+
+        manager.Update(BaseAddress + page * PageSize, num_pages, state, perm);
+        for (std::size_t i = page; i < page + num_pages; ++i) {
+            pages[i] = {state, perm};
+        }
+    }
+
+    VAddr RandomAddress() {
+        return BaseAddress + (rng() % (NumPages * PageSize));
+    }
+
+    const PageState& GetPage(VAddr addr) const {
+        return pages[(addr - BaseAddress) / PageSize];
+    }
+
+private:
+    std::mt19937 rng{0x1234};
+    std::vector<PageState> pages;
+};
+} // Anonymous namespace
+
+TEST_CASE("MemoryBlockManager: Random updates match a page map", "[core][kernel]") {
+    MemoryBlockManager manager{BaseAddress, BaseAddress + NumPages * PageSize};
+    RandomUpdater updater;
+
+    for (std::size_t i = 0; i < 20000; ++i) {
+        updater.Update(manager);
+    }
+
+    // The blocks cover the whole range without gaps, and adjacent blocks have been merged.
+    VAddr expected_addr = BaseAddress;
+    std::size_t num_blocks = 0;
+    MemoryInfo prev_info{};
+    manager.IterateForRange(BaseAddress, BaseAddress + NumPages * PageSize,
+                            [&](const MemoryInfo& info) {
+                                REQUIRE(info.GetAddress() == expected_addr);
+                                REQUIRE(info.GetSize() > 0);
+                                if (num_blocks != 0) {
+                                    REQUIRE((info.state != prev_info.state ||
+                                             info.perm != prev_info.perm));
+                                }
+                                expected_addr = info.GetEndAddress();
+                                prev_info = info;
+                                ++num_blocks;
+                            });
+    REQUIRE(expected_addr == BaseAddress + NumPages * PageSize);
+    REQUIRE(num_blocks > 1000);
+
+    for (std::size_t i = 0; i < 20000; ++i) {
+        const VAddr addr = updater.RandomAddress();
+        const MemoryInfo info = manager.FindBlock(addr).GetMemoryInfo();
+        REQUIRE(info.GetAddress() <= addr);
+        REQUIRE(addr <= info.GetLastAddress());
+        REQUIRE(info.state == updater.GetPage(addr).state);
+        REQUIRE(info.perm == updater.GetPage(addr).perm);
+    }
+
+    REQUIRE(manager.FindIterator(BaseAddress - 1) == manager.end());
+    REQUIRE(manager.FindIterator(BaseAddress + NumPages * PageSize) == manager.end());
+}
+
+TEST_CASE("MemoryBlockManager: Fragmented update and query throughput",
+          "[core][kernel][!benchmark]") {
+    constexpr std::size_t iterations = 100000;
+
+    MemoryBlockManager manager{BaseAddress, BaseAddress + NumPages * PageSize};
+    RandomUpdater updater;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++i) {
+        updater.Update(manager);
+        const VAddr addr = updater.RandomAddress();
+        REQUIRE(manager.FindBlock(addr).GetMemoryInfo().state == updater.GetPage(addr).state);
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    WARN("update and query: " << iterations / elapsed.count() << " operations/s");
+}
+
+} // namespace Kernel::Memory
@@ -0,0 +1,288 @@
+// Copyright 2020 yuzu emulator team
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <condition_variable>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/hle/ipc.h"
+#include "core/hle/ipc_helpers.h"
+#include "core/hle/kernel/client_session.h"
+#include "core/hle/kernel/handle_table.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/server_session.h"
+#include "core/hle/kernel/service_thread.h"
+#include "core/hle/kernel/session.h"
+#include "core/hle/kernel/thread.h"
+#include "core/hle/lock.h"
+
+namespace Kernel {
+
+namespace {
+/// Stand-in for a guest thread blocked in SendSyncRequest: owns a command buffer and sleeps
+/// until the service thread writes the reply into it.
+struct SyntheticClient {
+    std::array<u32, 0x40> cmd_buf{};
+    std::thread::id handled_on;
+
+    std::mutex mutex;
+    std::condition_variable woken;
+    bool waiting = false;
+
+    void SendSyncRequest(ServiceThread& service_thread, u32 command, u32 argument) {
+        cmd_buf[0] = command;
+        cmd_buf[1] = argument;
+        {
+            std::scoped_lock lock{mutex};
+            waiting = true;
+        }
+
+        service_thread.QueueSyncRequest([this] {
+            handled_on = std::this_thread::get_id();
+            // Reply: result code followed by the argument echoed back incremented
+            cmd_buf[0] = 0;
+            cmd_buf[2] = cmd_buf[1] + 1;
+
+            std::scoped_lock lock{mutex};
+            waiting = false;
+            woken.notify_one();
+        });
+
+        std::unique_lock lock{mutex};
+        woken.wait(lock, [this] { return !waiting; });
+    }
+};
+
+/// Handler opted into a service thread, replying to requests with their argument incremented.
+class IncrementHandler final : public SessionRequestHandler {
+public:
+    explicit IncrementHandler(KernelCore& kernel) {
+        service_thread = kernel.GetServiceThread("test");
+    }
+
+    ResultCode HandleSyncRequest(HLERequestContext& context) override {
+        handled_on = std::this_thread::get_id();
+
+        IPC::RequestParser rp{context};
+        const auto value{rp.Pop<u32>()};
+
+        IPC::ResponseBuilder rb{context, 3};
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(value + 1);
+        return RESULT_SUCCESS;
+    }
+
+    std::thread::id handled_on;
+};
+
+/// A guest thread with a session to an IncrementHandler. The kernel isn't initialized, so the
+/// request is translated by hand instead of being read from the thread's TLS.
+struct SessionEnvironment {
+    SessionEnvironment()
+        : kernel{Core::System::GetInstance().Kernel()},
+          handler{std::make_shared<IncrementHandler>(kernel)},
+          thread{std::make_shared<Thread>(kernel)} {
+        std::tie(client, server) = Session::Create(kernel, "test");
+        handler->ClientConnected(server);
+        thread->SetStatus(ThreadStatus::WaitIPC);
+    }
+
+    ~SessionEnvironment() {
+        // Removes the thread from the scheduler queues it was added to when woken up
+        std::lock_guard lock{HLE::g_hle_lock};
+        thread->SetStatus(ThreadStatus::Dead);
+    }
+
+    /// Sends a Request command with a single argument, the way svcSendSyncRequest does after
+    /// reading the command buffer.
+    std::shared_ptr<HLERequestContext> SendSyncRequest(u32 argument) {
+        std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf{};
+        IPC::ResponseBuilder rb{cmd_buf.data()};
+
+        IPC::CommandHeader header{};
+        header.type.Assign(IPC::CommandType::Request);
+        // Payload header, padding, command id and argument
+        header.data_size.Assign(sizeof(IPC::DataPayloadHeader) / sizeof(u32) + 4 + 2 + 1);
+        rb.PushRaw(header);
+        rb.AlignWithPadding();
+
+        IPC::DataPayloadHeader data_payload_header{};
+        data_payload_header.magic = Common::MakeMagic('S', 'F', 'C', 'I');
+        rb.PushRaw(data_payload_header);
+        rb.Push<u64>(1);
+        rb.Push(argument);
+
+        auto context = std::make_shared<HLERequestContext>(
+            kernel, Core::System::GetInstance().Memory(), server, thread);
+        context->PopulateFromIncomingCommandBuffer(handle_table, cmd_buf.data());
+        REQUIRE(server->HandleSyncRequest(context) == RESULT_SUCCESS);
+        return context;
+    }
+
+    ThreadStatus GetThreadStatus() const {
+        std::lock_guard lock{HLE::g_hle_lock};
+        return thread->GetStatus();
+    }
+
+    KernelCore& kernel;
+    std::shared_ptr<IncrementHandler> handler;
+    std::shared_ptr<Thread> thread;
+    std::shared_ptr<ClientSession> client;
+    std::shared_ptr<ServerSession> server;
+    HandleTable handle_table;
+};
+
+/// Occupies a service thread until it is released, so that requests queued behind it stay in
+/// flight.
+class ServiceThreadBlocker {
+public:
+    explicit ServiceThreadBlocker(ServiceThread& service_thread) {
+        service_thread.QueueSyncRequest(
+            [release_future = released.get_future().share()] { release_future.wait(); });
+    }
+
+    void Release() {
+        released.set_value();
+    }
+
+private:
+    std::promise<void> released;
+};
+
+/// Waits until the requests queued on the service thread so far have been executed.
+void Flush(ServiceThread& service_thread) {
+    std::promise<void> flushed;
+    auto future = flushed.get_future();
+    service_thread.QueueSyncRequest([&flushed] { flushed.set_value(); });
+    future.wait();
+}
+} // Anonymous namespace
+
+TEST_CASE("ServiceThread: Replies to synthetic requests off the requesting thread",
+          "[core][kernel]") {
+    ServiceThread service_thread{"test"};
+    REQUIRE(service_thread.GetName() == "test");
+
+    SyntheticClient client;
+    for (u32 i = 0; i < 100; ++i) {
+        client.SendSyncRequest(service_thread, 1, i);
+        REQUIRE(client.cmd_buf[0] == 0);
+        REQUIRE(client.cmd_buf[2] == i + 1);
+        REQUIRE(client.handled_on != std::this_thread::get_id());
+    }
+}
+
+TEST_CASE("ServiceThread: Serves concurrent clients in order", "[core][kernel]") {
+    constexpr std::size_t num_clients = 4;
+    constexpr u32 requests_per_client = 250;
+
+    ServiceThread service_thread{"test"};
+
+    std::mutex order_mutex;
+    std::array<std::vector<u32>, num_clients> handled;
+    std::vector<std::thread> clients;
+    for (std::size_t index = 0; index < num_clients; ++index) {
+        clients.emplace_back([&, index] {
+            // Each client pipelines its requests, as a guest would across several threads
+            for (u32 i = 0; i < requests_per_client; ++i) {
+                service_thread.QueueSyncRequest([&, index, i] {
+                    std::scoped_lock lock{order_mutex};
+                    handled[index].push_back(i);
+                });
+            }
+
+            SyntheticClient synchronous;
+            synchronous.SendSyncRequest(service_thread, 2, 0);
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    for (const auto& client_handled : handled) {
+        REQUIRE(client_handled.size() == requests_per_client);
+        for (u32 i = 0; i < requests_per_client; ++i) {
+            REQUIRE(client_handled[i] == i);
+        }
+    }
+}
+
+TEST_CASE("ServiceThread: Can be released by its own request", "[core][kernel]") {
+    auto service_thread = std::make_shared<ServiceThread>("test");
+    auto* const raw_service_thread = service_thread.get();
+
+    std::mutex mutex;
+    std::condition_variable released;
+    bool done = false;
+
+    // Mirrors a session closing while its last request is still in flight, which leaves the
+    // request as the only owner of the handler and therefore of the service thread.
+    raw_service_thread->QueueSyncRequest([&, owner = std::move(service_thread)]() mutable {
+        owner.reset();
+        std::scoped_lock lock{mutex};
+        done = true;
+        released.notify_one();
+    });
+
+    std::unique_lock lock{mutex};
+    released.wait(lock, [&] { return done; });
+    REQUIRE(done);
+}
+
+TEST_CASE("ServiceThread: Completes session requests and wakes up the client",
+          "[core][kernel]") {
+    SessionEnvironment env;
+    auto& service_thread = *env.handler->GetServiceThread();
+
+    ServiceThreadBlocker blocker{service_thread};
+    const auto context = env.SendSyncRequest(41);
+
+    // The request was handed off, the client keeps waiting until the service thread replies
+    REQUIRE(env.GetThreadStatus() == ThreadStatus::WaitIPC);
+
+    blocker.Release();
+    Flush(service_thread);
+
+    REQUIRE(env.handler->handled_on != std::this_thread::get_id());
+    REQUIRE(env.GetThreadStatus() == ThreadStatus::Ready);
+    REQUIRE(env.thread->GetContext64().cpu_registers[0] == RESULT_SUCCESS.raw);
+
+    // Skip the header, its padding and the payload header, the result code is 64-bit wide
+    IPC::RequestParser rp{context->CommandBuffer()};
+    rp.Skip(6, false);
+    REQUIRE(rp.Pop<ResultCode>() == RESULT_SUCCESS);
+    rp.Skip(1, false);
+    REQUIRE(rp.Pop<u32>() == 42);
+}
+
+TEST_CASE("ServiceThread: Doesn't wake up clients terminated during a request",
+          "[core][kernel]") {
+    SessionEnvironment env;
+    auto& service_thread = *env.handler->GetServiceThread();
+
+    ServiceThreadBlocker blocker{service_thread};
+    env.SendSyncRequest(41);
+    {
+        std::lock_guard lock{HLE::g_hle_lock};
+        env.thread->SetStatus(ThreadStatus::Dead);
+    }
+
+    blocker.Release();
+    Flush(service_thread);
+
+    REQUIRE(env.handler->handled_on != std::thread::id{});
+    REQUIRE(env.GetThreadStatus() == ThreadStatus::Dead);
+}
+
+} // namespace Kernel
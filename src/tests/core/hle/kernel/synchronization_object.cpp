@@ -0,0 +1,38 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <memory>
+
+#include "core/core.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/readable_event.h"
+#include "core/hle/kernel/thread.h"
+#include "core/hle/kernel/writable_event.h"
+
+namespace Kernel {
+
+TEST_CASE("SynchronizationObject: Lists a thread waiting on duplicate handles once",
+          "[core][kernel]") {
+    auto& kernel = Core::System::GetInstance().Kernel();
+    const auto first = WritableEvent::CreateEventPair(kernel, "first");
+    const auto second = WritableEvent::CreateEventPair(kernel, "second");
+    const auto thread = std::make_shared<Thread>(kernel);
+
+    // As passed by svcWaitSynchronization with the same handle at indices 0 and 2
+    thread->SetSynchronizationObjects(
+        {first.readable, second.readable, first.readable, second.readable});
+    REQUIRE(first.readable->GetWaitingThreads().size() == 1);
+    REQUIRE(second.readable->GetWaitingThreads().size() == 1);
+
+    // The index reported on wakeup still refers to the handles as passed
+    REQUIRE(thread->GetSynchronizationObjectIndex(*first.readable) == 2);
+
+    thread->ClearSynchronizationObjects();
+    REQUIRE(first.readable->GetWaitingThreads().empty());
+    REQUIRE(second.readable->GetWaitingThreads().empty());
+}
+
+} // namespace Kernel
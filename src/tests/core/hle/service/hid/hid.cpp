@@ -0,0 +1,186 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/param_package.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/frontend/input.h"
+#include "core/hle/service/hid/controllers/controller_base.h"
+#include "core/hle/service/hid/controllers/debug_pad.h"
+#include "core/hle/service/hid/controllers/keyboard.h"
+#include "core/hle/service/hid/controllers/mouse.h"
+#include "core/hle/service/hid/controllers/npad.h"
+#include "core/hle/service/hid/controllers/touchscreen.h"
+#include "core/settings.h"
+
+namespace Service::HID {
+
+namespace {
+constexpr std::size_t SharedMemorySize = 0x40000;
+
+// Layout of the libnx ring of the first NPad entry in shared memory.
+constexpr std::size_t LibnxOffset = 0x9A00 + 0x1408;
+constexpr std::size_t LibnxTotalEntryCountOffset = LibnxOffset + 0x8;
+constexpr std::size_t LibnxLastEntryIndexOffset = LibnxOffset + 0x10;
+constexpr std::size_t LibnxStatesOffset = LibnxOffset + 0x20;
+constexpr std::size_t GenericStateSize = 0x30;
+constexpr std::size_t GenericStatePadOffset = 0x10;
+
+std::atomic<bool> test_button_pressed{false};
+
+class TestButton final : public Input::ButtonDevice {
+public:
+    bool GetStatus() const override {
+        return test_button_pressed.load(std::memory_order_relaxed);
+    }
+};
+
+class TestButtonFactory final : public Input::Factory<Input::ButtonDevice> {
+public:
+    std::unique_ptr<Input::ButtonDevice> Create(const Common::ParamPackage&) override {
+        return std::make_unique<TestButton>();
+    }
+};
+
+/// Binds the A button of the first player to the test button for the lifetime of the scope.
+class ScopeInit final {
+public:
+    ScopeInit()
+        : connected{Settings::values.players[0].connected},
+          type{Settings::values.players[0].type},
+          button_a{Settings::values.players[0].buttons[Settings::NativeButton::A]} {
+        Input::RegisterFactory<Input::ButtonDevice>("hid_test",
+                                                    std::make_shared<TestButtonFactory>());
+        auto& player = Settings::values.players[0];
+        player.connected = true;
+        player.type = Settings::ControllerType::ProController;
+        player.buttons[Settings::NativeButton::A] = "engine:hid_test";
+        test_button_pressed = false;
+    }
+
+    ~ScopeInit() {
+        auto& player = Settings::values.players[0];
+        player.connected = connected;
+        player.type = type;
+        player.buttons[Settings::NativeButton::A] = button_a;
+        Input::UnregisterFactory<Input::ButtonDevice>("hid_test");
+    }
+
+private:
+    bool connected;
+    Settings::ControllerType type;
+    std::string button_a;
+};
+
+/// The controllers IAppletResource updates with actual input, activated and with devices loaded.
+std::vector<std::unique_ptr<ControllerBase>> MakeControllers() {
+    auto& system = Core::System::GetInstance();
+    std::vector<std::unique_ptr<ControllerBase>> controllers;
+    controllers.push_back(std::make_unique<Controller_DebugPad>(system));
+    controllers.push_back(std::make_unique<Controller_Touchscreen>(system));
+    controllers.push_back(std::make_unique<Controller_Mouse>(system));
+    controllers.push_back(std::make_unique<Controller_Keyboard>(system));
+    controllers.push_back(std::make_unique<Controller_NPad>(system));
+    for (auto& controller : controllers) {
+        controller->ActivateController();
+        controller->OnLoadInputDevices();
+    }
+    return controllers;
+}
+
+/// Runs one tick of IAppletResource::UpdateControllers.
+void UpdateControllers(std::vector<std::unique_ptr<ControllerBase>>& controllers,
+                       Core::Timing::CoreTiming& core_timing, std::vector<u8>& shared_memory) {
+    for (auto& controller : controllers) {
+        controller->OnUpdate(core_timing, shared_memory.data(), shared_memory.size());
+    }
+}
+
+template <typename T>
+T Read(const std::vector<u8>& shared_memory, std::size_t offset) {
+    T value;
+    std::memcpy(&value, shared_memory.data() + offset, sizeof(T));
+    return value;
+}
+
+u64 ReadLatestLibnxButtons(const std::vector<u8>& shared_memory) {
+    const auto index = Read<s64>(shared_memory, LibnxLastEntryIndexOffset);
+    return Read<u64>(shared_memory,
+                     LibnxStatesOffset + index * GenericStateSize + GenericStatePadOffset);
+}
+} // Anonymous namespace
+
+TEST_CASE("HID: Controllers only append entries when the input changes", "[core][hid]") {
+    ScopeInit guard;
+    Core::Timing::CoreTiming core_timing;
+    std::vector<u8> shared_memory(SharedMemorySize);
+    auto controllers = MakeControllers();
+
+    UpdateControllers(controllers, core_timing, shared_memory);
+    REQUIRE(Read<s64>(shared_memory, LibnxTotalEntryCountOffset) == 17);
+    const auto first_index = Read<s64>(shared_memory, LibnxLastEntryIndexOffset);
+    REQUIRE(ReadLatestLibnxButtons(shared_memory) == 0);
+
+    // Idle input keeps the ring in place, but the timestamp still follows the core timing.
+    for (std::size_t i = 0; i < 4; ++i) {
+        core_timing.AddTicks(1000);
+        UpdateControllers(controllers, core_timing, shared_memory);
+        REQUIRE(Read<s64>(shared_memory, LibnxLastEntryIndexOffset) == first_index);
+        REQUIRE(Read<s64>(shared_memory, LibnxOffset) == static_cast<s64>(core_timing.GetTicks()));
+    }
+
+    test_button_pressed = true;
+    UpdateControllers(controllers, core_timing, shared_memory);
+    REQUIRE(Read<s64>(shared_memory, LibnxLastEntryIndexOffset) == (first_index + 1) % 17);
+    REQUIRE((ReadLatestLibnxButtons(shared_memory) & 1) == 1);
+
+    UpdateControllers(controllers, core_timing, shared_memory);
+    REQUIRE(Read<s64>(shared_memory, LibnxLastEntryIndexOffset) == (first_index + 1) % 17);
+
+    test_button_pressed = false;
+    UpdateControllers(controllers, core_timing, shared_memory);
+    REQUIRE(Read<s64>(shared_memory, LibnxLastEntryIndexOffset) == (first_index + 2) % 17);
+    REQUIRE(ReadLatestLibnxButtons(shared_memory) == 0);
+}
+
+TEST_CASE("HID: UpdateControllers cost per tick", "[core][hid][!benchmark]") {
+    constexpr std::size_t num_ticks = 20000;
+
+    ScopeInit guard;
+    Core::Timing::CoreTiming core_timing;
+    std::vector<u8> shared_memory(SharedMemorySize);
+    auto controllers = MakeControllers();
+
+    const auto idle_start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < num_ticks; ++i) {
+        UpdateControllers(controllers, core_timing, shared_memory);
+    }
+    const std::chrono::duration<double> idle_time = std::chrono::steady_clock::now() - idle_start;
+
+    // Pressing and releasing a button every tick appends a new entry each time.
+    const auto active_start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < num_ticks; ++i) {
+        test_button_pressed = i % 2 == 0;
+        UpdateControllers(controllers, core_timing, shared_memory);
+    }
+    const std::chrono::duration<double> active_time =
+        std::chrono::steady_clock::now() - active_start;
+
+    WARN("idle input: " << idle_time.count() * 1e9 / num_ticks
+                        << " ns/tick, changing input: " << active_time.count() * 1e9 / num_ticks
+                        << " ns/tick");
+}
+
+} // namespace Service::HID
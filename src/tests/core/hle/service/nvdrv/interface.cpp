@@ -0,0 +1,163 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "common/common_funcs.h"
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/hle/ipc.h"
+#include "core/hle/ipc_helpers.h"
+#include "core/hle/kernel/client_session.h"
+#include "core/hle/kernel/handle_table.h"
+#include "core/hle/kernel/hle_ipc.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/server_session.h"
+#include "core/hle/kernel/session.h"
+#include "core/hle/kernel/thread.h"
+#include "core/hle/service/nvdrv/devices/nvmap.h"
+#include "core/hle/service/nvdrv/interface.h"
+#include "core/hle/service/nvdrv/nvdrv.h"
+#include "core/memory.h"
+#include "tests/core/memory_test_common.h"
+
+namespace Service::Nvidia {
+
+namespace {
+constexpr u32 IocCreate = 0xC0080101;
+constexpr u32 IocCreateSize = 8;
+constexpr u32 ObjectSize = 0x1000;
+
+constexpr VAddr buffer_page = 0x10000;
+
+/// An nvdrv session with an open nvmap device. Ioctl parameters live in guest memory where the
+/// page after buffer_page is backed by an unrelated host address.
+struct NvmapEnvironment {
+    NvmapEnvironment()
+        : module{std::make_shared<Module>(Core::System::GetInstance())},
+          service{module, "nvdrv"}, host(3 * Core::Memory::PAGE_SIZE) {
+        env.MapMemory(buffer_page, host.data(), Core::Memory::PAGE_SIZE);
+        env.MapMemory(buffer_page + Core::Memory::PAGE_SIZE,
+                      host.data() + 2 * Core::Memory::PAGE_SIZE, Core::Memory::PAGE_SIZE);
+        fd = module->Open("/dev/nvmap");
+    }
+
+    /// Returns the host memory backing the given guest address.
+    u8* HostPointer(VAddr vaddr) {
+        const std::size_t offset = vaddr - buffer_page;
+        return offset < Core::Memory::PAGE_SIZE ? host.data() + offset
+                                                : host.data() + Core::Memory::PAGE_SIZE + offset;
+    }
+
+    void WriteGuest(VAddr vaddr, u32 value) {
+        for (std::size_t i = 0; i < sizeof(value); ++i) {
+            *HostPointer(vaddr + i) = static_cast<u8>(value >> (i * 8));
+        }
+    }
+
+    u32 ReadGuest(VAddr vaddr) {
+        u32 value = 0;
+        for (std::size_t i = 0; i < sizeof(value); ++i) {
+            value |= static_cast<u32>(*HostPointer(vaddr + i)) << (i * 8);
+        }
+        return value;
+    }
+
+    /// Sends an Ioctl request whose input and output buffers alias the same guest memory, as
+    /// games do, and returns the result of the ioctl.
+    u32 Ioctl(u32 command, VAddr address, u32 size) {
+        auto& system = Core::System::GetInstance();
+        auto& kernel = system.Kernel();
+
+        std::array<u32, IPC::COMMAND_BUFFER_LENGTH> cmd_buf{};
+        IPC::ResponseBuilder rb{cmd_buf.data()};
+
+        IPC::CommandHeader header{};
+        header.type.Assign(IPC::CommandType::Request);
+        header.num_buf_a_descriptors.Assign(1);
+        header.num_buf_b_descriptors.Assign(1);
+        // Payload header, padding, command id, fd and ioctl command
+        header.data_size.Assign(sizeof(IPC::DataPayloadHeader) / sizeof(u32) + 4 + 2 + 2);
+        rb.PushRaw(header);
+
+        IPC::BufferDescriptorABW descriptor{};
+        descriptor.address_bits_0_31 = static_cast<u32>(address);
+        descriptor.size_bits_0_31 = size;
+        rb.PushRaw(descriptor);
+        rb.PushRaw(descriptor);
+        rb.AlignWithPadding();
+
+        IPC::DataPayloadHeader data_payload_header{};
+        data_payload_header.magic = Common::MakeMagic('S', 'F', 'C', 'I');
+        rb.PushRaw(data_payload_header);
+        // Ioctl
+        rb.Push<u64>(1);
+        rb.Push(fd);
+        rb.Push(command);
+
+        auto [client, server] = Kernel::Session::Create(kernel, "test");
+        auto context = std::make_shared<Kernel::HLERequestContext>(
+            kernel, system.Memory(), server, std::make_shared<Kernel::Thread>(kernel));
+        Kernel::HandleTable handle_table;
+        context->PopulateFromIncomingCommandBuffer(handle_table, cmd_buf.data());
+        service.InvokeRequest(*context);
+
+        IPC::RequestParser rp{context->CommandBuffer()};
+        rp.PopRaw<IPC::CommandHeader>();
+        rp.AlignWithPadding();
+        REQUIRE(rp.PopRaw<IPC::DataPayloadHeader>().magic ==
+                Common::MakeMagic('S', 'F', 'C', 'O'));
+        REQUIRE(rp.Pop<ResultCode>() == RESULT_SUCCESS);
+        return rp.Pop<u32>();
+    }
+
+    /// Creates an nvmap object with its parameters at the given address, returning its handle.
+    u32 CreateObject(VAddr address) {
+        WriteGuest(address, ObjectSize);
+        WriteGuest(address + 4, 0);
+        REQUIRE(Ioctl(IocCreate, address, IocCreateSize) == 0);
+        // The parameters are written back along with the new handle
+        REQUIRE(ReadGuest(address) == ObjectSize);
+        return ReadGuest(address + 4);
+    }
+
+    MemoryTests::TestEnvironment env;
+    std::shared_ptr<Module> module;
+    NVDRV service;
+    std::vector<u8> host;
+    u32 fd{};
+};
+} // Anonymous namespace
+
+TEST_CASE("NVDRV: Ioctl with contiguous parameters", "[core][nvdrv]") {
+    NvmapEnvironment env;
+    const auto nvmap = env.module->GetDevice<Devices::nvmap>("/dev/nvmap");
+
+    const u32 handle = env.CreateObject(buffer_page + 0x100);
+    REQUIRE(handle != 0);
+    REQUIRE(nvmap->GetObject(handle) != nullptr);
+    REQUIRE(nvmap->GetObject(handle)->size == ObjectSize);
+}
+
+TEST_CASE("NVDRV: Ioctl with parameters straddling host allocations", "[core][nvdrv]") {
+    NvmapEnvironment env;
+    const auto nvmap = env.module->GetDevice<Devices::nvmap>("/dev/nvmap");
+
+    // The size is on the first page and the handle on the second one
+    const u32 handle = env.CreateObject(buffer_page + Core::Memory::PAGE_SIZE - 4);
+    REQUIRE(handle != 0);
+    REQUIRE(nvmap->GetObject(handle) != nullptr);
+    REQUIRE(nvmap->GetObject(handle)->size == ObjectSize);
+
+    // Both ioctls were served by the same device
+    const u32 next_handle = env.CreateObject(buffer_page);
+    REQUIRE(next_handle != handle);
+    REQUIRE(nvmap->GetObject(next_handle) != nullptr);
+}
+
+} // namespace Service::Nvidia
@@ -0,0 +1,71 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/memory.h"
+#include "tests/core/memory_test_common.h"
+
+namespace Core::Memory {
+
+TEST_CASE("Memory: Contiguous pointer of a single host allocation", "[core][memory]") {
+    MemoryTests::TestEnvironment env;
+    auto& memory = Core::System::GetInstance().Memory();
+
+    std::vector<u8> host(2 * PAGE_SIZE);
+    env.MapMemory(0x10000, host.data(), host.size());
+
+    REQUIRE(memory.GetContiguousPointer(0x10000, 1) == host.data());
+    REQUIRE(memory.GetContiguousPointer(0x10000, host.size()) == host.data());
+    // Ranges crossing a page boundary stay contiguous within the same allocation
+    REQUIRE(memory.GetContiguousPointer(0x10ff0, 0x20) == host.data() + 0xff0);
+    REQUIRE(memory.GetContiguousPointer(0x11fff, 1) == host.data() + 0x1fff);
+
+    // Past the end of the mapping
+    REQUIRE(memory.GetContiguousPointer(0x11ff0, 0x20) == nullptr);
+    REQUIRE(memory.GetContiguousPointer(0x12000, 1) == nullptr);
+}
+
+TEST_CASE("Memory: Contiguous pointer of separate host allocations", "[core][memory]") {
+    MemoryTests::TestEnvironment env;
+    auto& memory = Core::System::GetInstance().Memory();
+
+    // Leave a page between the two, so they can't happen to be adjacent in host memory
+    std::vector<u8> host(3 * PAGE_SIZE);
+    u8* const first = host.data();
+    u8* const second = host.data() + 2 * PAGE_SIZE;
+    env.MapMemory(0x20000, first, PAGE_SIZE);
+    env.MapMemory(0x21000, second, PAGE_SIZE);
+
+    // Each page on its own is contiguous
+    REQUIRE(memory.GetContiguousPointer(0x20100, 0x100) == first + 0x100);
+    REQUIRE(memory.GetContiguousPointer(0x20f00, 0x100) == first + 0xf00);
+    REQUIRE(memory.GetContiguousPointer(0x21000, 0x100) == second);
+
+    // Straddling both pages is not, even though the guest addresses are
+    REQUIRE(memory.GetContiguousPointer(0x20f00, 0x200) == nullptr);
+    REQUIRE(memory.GetContiguousPointer(0x20fff, 2) == nullptr);
+}
+
+TEST_CASE("Memory: Contiguous pointer of unmapped and rasterizer cached pages", "[core][memory]") {
+    MemoryTests::TestEnvironment env;
+    auto& memory = Core::System::GetInstance().Memory();
+
+    std::vector<u8> host(2 * PAGE_SIZE);
+    env.MapMemory(0x30000, host.data(), host.size());
+    env.MapRasterizerCachedMemory(0x32000, PAGE_SIZE);
+
+    REQUIRE(memory.GetContiguousPointer(0x40000, 0x10) == nullptr);
+    REQUIRE(memory.GetContiguousPointer(0x32000, 0x10) == nullptr);
+    // Running into a cached page must go through ReadBlock, so the GPU can flush it
+    REQUIRE(memory.GetContiguousPointer(0x31ff0, 0x20) == nullptr);
+    // A range that would wrap around the address space
+    REQUIRE(memory.GetContiguousPointer(0x30000, ~0ULL) == nullptr);
+}
+
+} // namespace Core::Memory
@@ -0,0 +1,48 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/assert.h"
+#include "common/page_table.h"
+#include "core/core.h"
+#include "core/hle/kernel/kernel.h"
+#include "core/hle/kernel/memory/page_table.h"
+#include "core/hle/kernel/process.h"
+#include "core/memory.h"
+#include "tests/core/memory_test_common.h"
+
+namespace MemoryTests {
+
+namespace {
+/// Guest addresses used by the tests fit in a 32-bit address space
+constexpr std::size_t address_space_width = 32;
+} // Anonymous namespace
+
+TestEnvironment::TestEnvironment() : kernel{Core::System::GetInstance().Kernel()} {
+    auto& system = Core::System::GetInstance();
+
+    process = Kernel::Process::Create(system, "", Kernel::Process::ProcessType::Userland);
+    page_table = &process->PageTable().PageTableImpl();
+    page_table->Resize(address_space_width, Core::Memory::PAGE_BITS, true);
+
+    kernel.MakeCurrentProcess(process.get());
+}
+
+TestEnvironment::~TestEnvironment() {
+    kernel.MakeCurrentProcess(nullptr);
+}
+
+void TestEnvironment::MapMemory(VAddr vaddr, u8* host_buffer, std::size_t size) {
+    ASSERT((vaddr & Core::Memory::PAGE_MASK) == 0 && (size & Core::Memory::PAGE_MASK) == 0);
+    // Pointers are stored relative to the virtual address of their page, as MapPages does
+    page_table->FillRange(vaddr >> Core::Memory::PAGE_BITS, size >> Core::Memory::PAGE_BITS,
+                          host_buffer - vaddr, 0, Common::PageType::Memory);
+}
+
+void TestEnvironment::MapRasterizerCachedMemory(VAddr vaddr, std::size_t size) {
+    ASSERT((vaddr & Core::Memory::PAGE_MASK) == 0 && (size & Core::Memory::PAGE_MASK) == 0);
+    page_table->FillRange(vaddr >> Core::Memory::PAGE_BITS, size >> Core::Memory::PAGE_BITS,
+                          nullptr, 0, Common::PageType::RasterizerCachedMemory);
+}
+
+} // namespace MemoryTests
@@ -0,0 +1,44 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "common/common_types.h"
+
+namespace Common {
+struct PageTable;
+}
+
+namespace Kernel {
+class KernelCore;
+class Process;
+} // namespace Kernel
+
+namespace MemoryTests {
+
+/**
+ * Makes a process with an empty address space the current one. The tests don't bring up device
+ * memory, so guest pages are backed by host buffers owned by the test instead.
+ */
+class TestEnvironment final {
+public:
+    TestEnvironment();
+    ~TestEnvironment();
+
+    /// Maps a page aligned range of guest memory onto the given host buffer.
+    void MapMemory(VAddr vaddr, u8* host_buffer, std::size_t size);
+
+    /// Marks a page aligned range of guest memory as cached by the rasterizer.
+    void MapRasterizerCachedMemory(VAddr vaddr, std::size_t size);
+
+private:
+    Kernel::KernelCore& kernel;
+    std::shared_ptr<Kernel::Process> process;
+    Common::PageTable* page_table;
+};
+
+} // namespace MemoryTests
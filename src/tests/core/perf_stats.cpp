@@ -0,0 +1,125 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <random>
+
+#include "common/common_types.h"
+#include "core/perf_stats.h"
+#include "core/settings.h"
+
+namespace Core {
+
+namespace {
+using namespace std::chrono_literals;
+using Clock = FrameLimiter::Clock;
+
+constexpr std::chrono::microseconds FrameInterval{16667};
+
+/// Sets the frame limit up the way a default configuration has it, for the lifetime of the object.
+class ScopedFrameLimit {
+public:
+    ScopedFrameLimit()
+        : use_frame_limit{Settings::values.use_frame_limit},
+          frame_limit{Settings::values.frame_limit} {
+        Settings::values.use_frame_limit = true;
+        Settings::values.frame_limit = 100;
+    }
+
+    ~ScopedFrameLimit() {
+        Settings::values.use_frame_limit = use_frame_limit;
+        Settings::values.frame_limit = frame_limit;
+    }
+
+private:
+    bool use_frame_limit;
+    u16 frame_limit;
+};
+
+/// Starts pacing at the given walltime. A gap longer than any frame restarts pacing from now.
+void StartPacing(FrameLimiter& frame_limiter, Clock::time_point now) {
+    REQUIRE(frame_limiter.NextDeadline(1s, 0, now) == now);
+}
+} // Anonymous namespace
+
+TEST_CASE("FrameLimiter: Paces a simulated workload", "[core]") {
+    constexpr std::size_t num_frames = 120;
+    constexpr std::size_t slow_frame = 60;
+    ScopedFrameLimit scoped_frame_limit;
+
+    FrameLimiter frame_limiter;
+    std::mt19937 rng{0x1234};
+    std::uniform_int_distribution<int> work_ms{1, 12};
+
+    // Frames go to a null sink: presenting takes no time and the GPU never falls behind.
+    const Clock::time_point start = Clock::now();
+    StartPacing(frame_limiter, start);
+    std::chrono::microseconds system_time = 1s;
+    Clock::time_point now = start;
+    for (std::size_t frame = 1; frame <= num_frames; ++frame) {
+        now += frame == slow_frame ? 20ms : std::chrono::milliseconds{work_ms(rng)};
+        system_time += FrameInterval;
+        now = std::max(now, frame_limiter.NextDeadline(system_time, 0, now));
+
+        // The slow frame is late, the one after it catches up by not waiting as long
+        if (frame != slow_frame) {
+            REQUIRE(now == start + FrameInterval * frame);
+        }
+    }
+}
+
+TEST_CASE("FrameLimiter: Limits how far it catches up", "[core]") {
+    ScopedFrameLimit scoped_frame_limit;
+
+    FrameLimiter frame_limiter;
+    const Clock::time_point start = Clock::now();
+    StartPacing(frame_limiter, start);
+
+    // A stall of several frames is only caught up on up to a frame and a half
+    const Clock::time_point stalled = start + 100ms;
+    REQUIRE(frame_limiter.NextDeadline(1s + FrameInterval, 0, stalled) == stalled - 25ms);
+    REQUIRE(frame_limiter.NextDeadline(1s + FrameInterval * 2, 0, stalled) ==
+            stalled - 25ms + FrameInterval);
+}
+
+TEST_CASE("FrameLimiter: Defers to a blocking host present", "[core]") {
+    ScopedFrameLimit scoped_frame_limit;
+
+    FrameLimiter frame_limiter;
+    const Clock::time_point start = Clock::now();
+    StartPacing(frame_limiter, start);
+
+    // The host present blocked on vsync for most of the frame, it is already paced.
+    frame_limiter.SetHostPresentTime(15ms);
+    const Clock::time_point now = start + 1ms;
+    REQUIRE(frame_limiter.NextDeadline(1s + FrameInterval, 0, now) == now);
+}
+
+TEST_CASE("FrameLimiter: Waits for the GPU thread backlog", "[core]") {
+    ScopedFrameLimit scoped_frame_limit;
+
+    FrameLimiter frame_limiter;
+    const Clock::time_point start = Clock::now();
+    StartPacing(frame_limiter, start);
+
+    // Two frames more than usual are waiting to be presented, give the GPU thread time for them.
+    REQUIRE(frame_limiter.NextDeadline(1s + FrameInterval, 3, start) ==
+            start + FrameInterval * 3);
+}
+
+TEST_CASE("FrameLimiter: Doesn't wait without a frame limit", "[core]") {
+    ScopedFrameLimit scoped_frame_limit;
+    Settings::values.use_frame_limit = false;
+
+    FrameLimiter frame_limiter;
+    const Clock::time_point start = Clock::now();
+    StartPacing(frame_limiter, start);
+    REQUIRE(frame_limiter.NextDeadline(1s + FrameInterval, 0, start) == start);
+}
+
+} // namespace Core
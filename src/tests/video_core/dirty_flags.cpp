@@ -0,0 +1,103 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+
+#include "common/common_types.h"
+#include "video_core/dirty_flags.h"
+#include "video_core/engines/maxwell_3d.h"
+#include "video_core/renderer_opengl/gl_dirty_flags.h"
+#include "video_core/renderer_vulkan/vk_state_tracker.h"
+
+#define OFF(field_name) MAXWELL3D_REG_INDEX(field_name)
+
+namespace VideoCommon::Dirty {
+
+namespace {
+
+using Tegra::Engines::Maxwell3D;
+using Regs = Maxwell3D::Regs;
+
+// The same tables the state trackers install, built from the same bindings.
+constexpr Table opengl_table = MakeTable(CommonBindings, OpenGL::Dirty::Bindings);
+constexpr Table vulkan_table = MakeTable(CommonBindings, Vulkan::Dirty::Bindings);
+
+void CheckFlagsInRange(const Table& table, u8 last_flag) {
+    for (std::size_t method = 0; method < Regs::NUM_REGS; ++method) {
+        INFO("method 0x" << std::hex << method);
+        REQUIRE(table[method][0] < last_flag);
+        REQUIRE(table[method][1] < last_flag);
+    }
+}
+
+} // Anonymous namespace
+
+TEST_CASE("DirtyFlags: Register ranges fit in the register file", "[video_core]") {
+    for (const RegisterRange& range : RegisterRanges) {
+        INFO("range " << static_cast<std::size_t>(range.range));
+        REQUIRE(range.num > 0);
+        REQUIRE(range.count > 0);
+        // Elements of an array must not overlap each other
+        REQUIRE((range.count == 1 || range.num <= range.stride));
+        REQUIRE(range.begin + (range.count - 1) * range.stride + range.num <= Regs::NUM_REGS);
+    }
+}
+
+TEST_CASE("DirtyFlags: OpenGL table", "[video_core]") {
+    using namespace OpenGL::Dirty;
+    CheckFlagsInRange(opengl_table, Last);
+
+    constexpr std::size_t rt_size = sizeof(Regs::rt[0]) / sizeof(u32);
+    REQUIRE(opengl_table[OFF(rt) + 3 * rt_size][0] == ColorBuffer3);
+    REQUIRE(opengl_table[OFF(rt) + 3 * rt_size][1] == RenderTargets);
+    REQUIRE(opengl_table[OFF(zeta_enable)][0] == ZetaBuffer);
+
+    constexpr std::size_t viewport_size = sizeof(Regs::viewport_transform[0]) / sizeof(u32);
+    REQUIRE(opengl_table[OFF(viewport_transform) + 5 * viewport_size][0] == Viewport0 + 5);
+    REQUIRE(opengl_table[OFF(viewport_transform) + 5 * viewport_size][1] == Viewports);
+    REQUIRE(opengl_table[OFF(viewport_transform_enabled)][0] == ViewportTransform);
+
+    // The last word of a vertex array is its divisor, which belongs to the instancing state
+    REQUIRE(opengl_table[OFF(vertex_array[2])][0] == VertexBuffer0 + 2);
+    REQUIRE(opengl_table[OFF(vertex_array[2]) + 3][0] == VertexInstance0 + 2);
+    REQUIRE(opengl_table[OFF(vertex_array[2]) + 3][1] == VertexInstances);
+    REQUIRE(opengl_table[OFF(vertex_array_limit[31]) + 1][0] == VertexBuffer0 + 31);
+
+    REQUIRE(opengl_table[OFF(blend.enable) + 4][0] == BlendState0 + 4);
+    REQUIRE(opengl_table[OFF(blend.enable) + 4][1] == BlendStates);
+    REQUIRE(opengl_table[OFF(blend.equation_rgb)][0] == NullEntry);
+    REQUIRE(opengl_table[OFF(blend.equation_rgb)][1] == BlendStates);
+
+    REQUIRE(opengl_table[OFF(stencil_back_mask)][0] == StencilTest);
+    REQUIRE(opengl_table[OFF(fill_rectangle)][0] == PolygonModes);
+
+    // Shader registers only have their own flag, they are not part of the vertex array group
+    REQUIRE(opengl_table[OFF(shader_config[3])][0] == Shaders);
+    REQUIRE(opengl_table[OFF(shader_config[3])][1] == NullEntry);
+
+    REQUIRE(opengl_table[OFF(depth_bounds)][0] == NullEntry);
+}
+
+TEST_CASE("DirtyFlags: Vulkan table", "[video_core]") {
+    using namespace Vulkan::Dirty;
+    CheckFlagsInRange(vulkan_table, Last);
+
+    constexpr std::size_t rt_size = sizeof(Regs::rt[0]) / sizeof(u32);
+    REQUIRE(vulkan_table[OFF(rt) + rt_size][0] == ColorBuffer1);
+    REQUIRE(vulkan_table[OFF(rt) + rt_size][1] == RenderTargets);
+
+    constexpr std::size_t viewport_size = sizeof(Regs::viewports[0]) / sizeof(u32);
+    REQUIRE(vulkan_table[OFF(viewports) + 3 * viewport_size][0] == Viewports);
+    REQUIRE(vulkan_table[OFF(viewports) + 3 * viewport_size][1] == NullEntry);
+
+    REQUIRE(vulkan_table[OFF(polygon_offset_units)][0] == DepthBias);
+    REQUIRE(vulkan_table[OFF(polygon_offset_fill_enable)][0] == NullEntry);
+    REQUIRE(vulkan_table[OFF(depth_bounds)][0] == DepthBounds);
+    REQUIRE(vulkan_table[OFF(stencil_front_func_ref)][0] == StencilProperties);
+    REQUIRE(vulkan_table[OFF(stencil_enable)][0] == NullEntry);
+}
+
+} // namespace VideoCommon::Dirty
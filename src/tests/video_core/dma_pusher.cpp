@@ -0,0 +1,60 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include "common/common_types.h"
+#include "video_core/dma_pusher.h"
+
+namespace Tegra {
+
+namespace {
+CommandList MakeCommandList(std::size_t num_entries) {
+    CommandList command_list(num_entries);
+    for (std::size_t i = 0; i < num_entries; ++i) {
+        command_list[i].raw = i;
+    }
+    return command_list;
+}
+} // Anonymous namespace
+
+TEST_CASE("CommandListPool: Reuses the storage of released lists", "[video_core]") {
+    CommandListPool pool;
+    REQUIRE(pool.Acquire().capacity() == 0);
+
+    CommandList command_list = MakeCommandList(32);
+    const CommandListHeader* const storage = command_list.data();
+    pool.Release(std::move(command_list));
+    REQUIRE(pool.NumFreeLists() == 1);
+
+    CommandList reused = pool.Acquire();
+    REQUIRE(reused.empty());
+    REQUIRE(reused.capacity() >= 32);
+    REQUIRE(reused.data() == storage);
+    REQUIRE(pool.NumFreeLists() == 0);
+
+    // Once drained, new lists start out without storage
+    REQUIRE(pool.Acquire().capacity() == 0);
+}
+
+TEST_CASE("CommandListPool: Keeps at most max_free_lists lists", "[video_core]") {
+    CommandListPool pool;
+    for (std::size_t i = 0; i < CommandListPool::max_free_lists + 16; ++i) {
+        pool.Release(MakeCommandList(8));
+    }
+    REQUIRE(pool.NumFreeLists() == CommandListPool::max_free_lists);
+
+    for (std::size_t i = 0; i < CommandListPool::max_free_lists; ++i) {
+        const CommandList command_list = pool.Acquire();
+        REQUIRE(command_list.empty());
+        REQUIRE(command_list.capacity() >= 8);
+    }
+    REQUIRE(pool.NumFreeLists() == 0);
+    REQUIRE(pool.Acquire().capacity() == 0);
+}
+
+} // namespace Tegra
@@ -0,0 +1,286 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "common/common_types.h"
+#include "core/core.h"
+#include "core/settings.h"
+#include "video_core/query_cache.h"
+#include "video_core/rasterizer_interface.h"
+
+namespace VideoCommon {
+
+namespace {
+class TestQueryCache;
+
+/// Host counter whose result only becomes available once the test marks it as ready.
+class TestCounter final : public HostCounterBase<TestQueryCache, TestCounter> {
+public:
+    explicit TestCounter(std::shared_ptr<TestCounter> dependency, u64 value)
+        : HostCounterBase{std::move(dependency)}, value{value} {}
+
+    /// Counter handed out by a query cache, ready when the cache says its results are.
+    explicit TestCounter(TestQueryCache& cache, std::shared_ptr<TestCounter> dependency,
+                         VideoCore::QueryType type);
+
+    void EndQuery() {}
+
+    bool is_ready = false;
+    mutable std::size_t num_blocking_queries = 0;
+
+private:
+    u64 BlockingQuery() const override {
+        ++num_blocking_queries;
+        return value;
+    }
+
+    std::optional<u64> PollQuery() const override;
+
+    const TestQueryCache* cache = nullptr;
+    const u64 value;
+};
+
+class TestCachedQuery final : public CachedQueryBase<TestCounter> {
+public:
+    explicit TestCachedQuery(VAddr cpu_addr, u8* host_ptr) : CachedQueryBase{cpu_addr, host_ptr} {}
+
+    explicit TestCachedQuery(TestQueryCache&, VideoCore::QueryType, VAddr cpu_addr, u8* host_ptr)
+        : CachedQueryBase{cpu_addr, host_ptr} {}
+};
+
+using TestCounterStream = CounterStreamBase<TestQueryCache, TestCounter>;
+
+struct TestQueryPool {};
+
+/// Rasterizer that only keeps track of the queries cached in guest memory.
+class TestRasterizer final : public VideoCore::RasterizerInterface {
+public:
+    void Draw(bool is_indexed, bool is_instanced) override {}
+    void Clear() override {}
+    void DispatchCompute(GPUVAddr code_addr) override {}
+    void ResetCounter(VideoCore::QueryType type) override {}
+    void Query(GPUVAddr gpu_addr, VideoCore::QueryType type,
+               std::optional<u64> timestamp) override {}
+    void SignalSemaphore(GPUVAddr addr, u32 value) override {}
+    void SignalSyncPoint(u32 value) override {}
+    void ReleaseFences() override {}
+    void FlushAll() override {}
+    void FlushRegion(VAddr addr, u64 size) override {}
+    bool MustFlushRegion(VAddr addr, u64 size) override {
+        return false;
+    }
+    void InvalidateRegion(VAddr addr, u64 size) override {}
+    void OnCPUWrite(VAddr addr, u64 size) override {}
+    void SyncGuestHost() override {}
+    void FlushAndInvalidateRegion(VAddr addr, u64 size) override {}
+    void WaitForIdle() override {}
+    void FlushCommands() override {}
+    void TickFrame() override {}
+
+    void UpdatePagesCachedCount(VAddr addr, u64 size, int delta) override {
+        num_cached_queries += delta;
+    }
+
+    int num_cached_queries = 0;
+};
+
+/// Query cache recording queries at guest addresses directly, as if already translated.
+class TestQueryCache final : public QueryCacheBase<TestQueryCache, TestCachedQuery,
+                                                   TestCounterStream, TestCounter, TestQueryPool> {
+public:
+    explicit TestQueryCache(VideoCore::RasterizerInterface& rasterizer)
+        : QueryCacheBase{Core::System::GetInstance(), rasterizer} {}
+
+    using QueryCacheBase::RecordQuery;
+
+    bool results_ready = false; ///< Whether the host GPU has produced the results of counters
+    u64 counter_value = 0;      ///< Value counted by the counters created from now on
+};
+
+TestCounter::TestCounter(TestQueryCache& cache, std::shared_ptr<TestCounter> dependency,
+                         VideoCore::QueryType)
+    : HostCounterBase{std::move(dependency)}, cache{&cache}, value{cache.counter_value} {}
+
+std::optional<u64> TestCounter::PollQuery() const {
+    if (!is_ready && !(cache && cache->results_ready)) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+/// Sets whether queries are flushed asynchronously for the lifetime of the object.
+class ScopedAsyncGpu {
+public:
+    explicit ScopedAsyncGpu(bool enabled)
+        : use_asynchronous_gpu_emulation{Settings::values.use_asynchronous_gpu_emulation} {
+        Settings::values.use_asynchronous_gpu_emulation = enabled;
+    }
+
+    ~ScopedAsyncGpu() {
+        Settings::values.use_asynchronous_gpu_emulation = use_asynchronous_gpu_emulation;
+    }
+
+private:
+    bool use_asynchronous_gpu_emulation;
+};
+
+u64 ReadResult(const std::array<u8, 16>& guest_memory) {
+    u64 value;
+    std::memcpy(&value, guest_memory.data(), sizeof(value));
+    return value;
+}
+} // Anonymous namespace
+
+TEST_CASE("QueryCache: Polled results include their dependencies", "[video_core]") {
+    const auto first = std::make_shared<TestCounter>(nullptr, 3);
+    const auto second = std::make_shared<TestCounter>(first, 4);
+
+    second->is_ready = true;
+    REQUIRE(!second->TryQuery());
+
+    first->is_ready = true;
+    REQUIRE(second->TryQuery() == 7U);
+    REQUIRE(second->Query() == 7U);
+    REQUIRE(first->num_blocking_queries == 0);
+    REQUIRE(second->num_blocking_queries == 0);
+}
+
+TEST_CASE("QueryCache: Pending results keep the last known value", "[video_core]") {
+    std::array<u8, 16> guest_memory{};
+    TestCachedQuery query{0x1000, guest_memory.data()};
+
+    const auto first = std::make_shared<TestCounter>(nullptr, 10);
+    first->is_ready = true;
+    query.BindCounter(first, std::nullopt);
+    REQUIRE(query.TryFlush());
+    REQUIRE(ReadResult(guest_memory) == 10);
+
+    // The game rewrites the query, the new result isn't available yet.
+    const auto second = std::make_shared<TestCounter>(nullptr, 20);
+    query.BindCounter(second, std::nullopt);
+    REQUIRE(!query.TryFlush());
+    REQUIRE(ReadResult(guest_memory) == 10);
+    REQUIRE(second->num_blocking_queries == 0);
+
+    second->is_ready = true;
+    REQUIRE(query.TryFlush());
+    REQUIRE(ReadResult(guest_memory) == 20);
+    REQUIRE(second->num_blocking_queries == 0);
+
+    // Blocking flushes still work for results that never became available.
+    const auto third = std::make_shared<TestCounter>(nullptr, 30);
+    query.BindCounter(third, std::nullopt);
+    query.Flush();
+    REQUIRE(ReadResult(guest_memory) == 30);
+    REQUIRE(third->num_blocking_queries == 1);
+}
+
+TEST_CASE("QueryCache: Ready region flushes leave pending queries cached", "[video_core]") {
+    ScopedAsyncGpu async_gpu{false};
+    TestRasterizer rasterizer;
+    TestQueryCache cache{rasterizer};
+    cache.counter_value = 5;
+    cache.Stream(VideoCore::QueryType::SamplesPassed).Update(true);
+
+    constexpr VAddr first_addr = 0x1000;
+    constexpr VAddr second_addr = 0x2000;
+    std::array<u8, 16> first_memory{};
+    std::array<u8, 16> second_memory{};
+
+    cache.RecordQuery(first_addr, first_memory.data(), VideoCore::QueryType::SamplesPassed,
+                      std::nullopt);
+    REQUIRE(rasterizer.num_cached_queries == 1);
+
+    // Not produced yet, the query keeps its last known value and stays cached
+    cache.FlushReadyRegion(first_addr, 8);
+    REQUIRE(ReadResult(first_memory) == 0);
+    REQUIRE(cache.GetStats().stalls_avoided == 1);
+    REQUIRE(rasterizer.num_cached_queries == 1);
+
+    cache.results_ready = true;
+    cache.FlushReadyRegion(first_addr, 8);
+    REQUIRE(ReadResult(first_memory) == 5);
+    REQUIRE(cache.GetStats().ready_flushes == 1);
+    REQUIRE(rasterizer.num_cached_queries == 0);
+
+    // Flushed queries are no longer cached
+    cache.FlushReadyRegion(first_addr, 8);
+    cache.FlushRegion(first_addr, 8);
+    REQUIRE(cache.GetStats().ready_flushes == 1);
+    REQUIRE(cache.GetStats().blocking_flushes == 0);
+
+    // Counters include the ones sliced before them
+    cache.results_ready = false;
+    cache.RecordQuery(second_addr, second_memory.data(), VideoCore::QueryType::SamplesPassed,
+                      std::nullopt);
+    cache.FlushRegion(second_addr, 8);
+    REQUIRE(ReadResult(second_memory) == 10);
+
+    const QueryCacheStats stats = cache.GetStats();
+    REQUIRE(stats.async_flushes == 0);
+    REQUIRE(stats.ready_flushes == 1);
+    REQUIRE(stats.blocking_flushes == 1);
+    REQUIRE(stats.stalls_avoided == 1);
+    REQUIRE(rasterizer.num_cached_queries == 0);
+}
+
+TEST_CASE("QueryCache: Fenced flushes write back queries asynchronously", "[video_core]") {
+    ScopedAsyncGpu async_gpu{true};
+    TestRasterizer rasterizer;
+    TestQueryCache cache{rasterizer};
+    cache.counter_value = 3;
+    cache.Stream(VideoCore::QueryType::SamplesPassed).Update(true);
+
+    constexpr VAddr first_addr = 0x1000;
+    constexpr VAddr second_addr = 0x2000;
+    std::array<u8, 16> first_memory{};
+    std::array<u8, 16> second_memory{};
+
+    REQUIRE(!cache.HasUncommittedFlushes());
+    REQUIRE(!cache.ShouldWaitAsyncFlushes());
+
+    cache.RecordQuery(first_addr, first_memory.data(), VideoCore::QueryType::SamplesPassed,
+                      std::nullopt);
+    REQUIRE(cache.HasUncommittedFlushes());
+    cache.CommitAsyncFlushes();
+    REQUIRE(!cache.HasUncommittedFlushes());
+    REQUIRE(cache.ShouldWaitAsyncFlushes());
+
+    // The fence has passed and the result is available
+    cache.results_ready = true;
+    cache.PopAsyncFlushes();
+    REQUIRE(!cache.ShouldWaitAsyncFlushes());
+    REQUIRE(ReadResult(first_memory) == 3);
+    REQUIRE(cache.GetStats().async_flushes == 1);
+    REQUIRE(rasterizer.num_cached_queries == 0);
+
+    // The fence has passed but the result can't be polled, it has to wait on the host GPU
+    cache.results_ready = false;
+    cache.RecordQuery(second_addr, second_memory.data(), VideoCore::QueryType::SamplesPassed,
+                      std::nullopt);
+    cache.CommitAsyncFlushes();
+    cache.PopAsyncFlushes();
+    REQUIRE(ReadResult(second_memory) == 6);
+
+    // Commits without queries don't have to be waited on
+    cache.CommitAsyncFlushes();
+    REQUIRE(!cache.ShouldWaitAsyncFlushes());
+    cache.PopAsyncFlushes();
+
+    const QueryCacheStats stats = cache.GetStats();
+    REQUIRE(stats.async_flushes == 1);
+    REQUIRE(stats.ready_flushes == 0);
+    REQUIRE(stats.blocking_flushes == 1);
+    REQUIRE(stats.stalls_avoided == 0);
+    REQUIRE(rasterizer.num_cached_queries == 0);
+}
+
+} // namespace VideoCommon
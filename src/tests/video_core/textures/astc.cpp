@@ -0,0 +1,72 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "common/common_types.h"
+#include "common/thread_pool.h"
+#include "video_core/textures/astc.h"
+
+namespace Tegra::Texture::ASTC {
+
+namespace {
+constexpr std::size_t BlockSize = 16;
+
+/**
+ * Returns ASTC blocks for a texture of the given size. Every block uses a 4x2 grid of 1-bit
+ * weights, one partition and direct LDR RGBA endpoints, the endpoint and weight bits are random.
+ */
+std::vector<u8> MakeBlocks(u32 width, u32 height, u32 depth, u32 block_width, u32 block_height) {
+    // Block mode 0x001 and color endpoint mode 12 (LDR RGBA direct) in the low 17 bits
+    constexpr u32 BlockHeader = 0x001 | (12 << 13);
+    constexpr u32 BlockHeaderMask = (1 << 17) - 1;
+
+    const std::size_t blocks_per_row = (width + block_width - 1) / block_width;
+    const std::size_t block_rows = (height + block_height - 1) / block_height;
+    std::vector<u8> blocks(blocks_per_row * block_rows * depth * BlockSize);
+
+    std::mt19937 rng(0x1234);
+    std::uniform_int_distribution<u32> distribution(0, 255);
+    for (u8& value : blocks) {
+        value = static_cast<u8>(distribution(rng));
+    }
+    for (std::size_t offset = 0; offset < blocks.size(); offset += BlockSize) {
+        for (std::size_t i = 0; i < 3; ++i) {
+            const u32 mask = (BlockHeaderMask >> (i * 8)) & 0xFF;
+            blocks[offset + i] = static_cast<u8>((blocks[offset + i] & ~mask) |
+                                                 ((BlockHeader >> (i * 8)) & mask));
+        }
+    }
+    return blocks;
+}
+} // Anonymous namespace
+
+TEST_CASE("ASTC: Parallel decoding matches a single worker", "[video_core]") {
+    // Not a multiple of the block size in either dimension, and wide enough for every row of
+    // blocks to be a task of its own
+    constexpr u32 width = 1283;
+    constexpr u32 height = 37;
+    constexpr u32 depth = 3;
+    constexpr u32 block_width = 5;
+    constexpr u32 block_height = 4;
+
+    const std::vector<u8> blocks = MakeBlocks(width, height, depth, block_width, block_height);
+
+    Common::ThreadPool serial_pool{"ASTC", 1};
+    const std::vector<u8> serial =
+        Decompress(blocks.data(), width, height, depth, block_width, block_height, serial_pool);
+
+    Common::ThreadPool parallel_pool{"ASTC", 4};
+    const std::vector<u8> parallel =
+        Decompress(blocks.data(), width, height, depth, block_width, block_height, parallel_pool);
+
+    REQUIRE(serial.size() == std::size_t{width} * height * depth * 4);
+    REQUIRE(parallel == serial);
+}
+
+} // namespace Tegra::Texture::ASTC
@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <list>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -110,6 +112,62 @@ public:
         });
     }
 
+    /**
+     * Copies a range of memory within the cache on the host GPU, used for DMA buffer copies.
+     * This only pays off when the source holds data written by the GPU, since copying it through
+     * guest memory would require downloading it first. Otherwise nothing is done and false is
+     * returned, so the caller performs the copy itself.
+     * Only the buffer cache is updated, the caller is responsible for invalidating the other caches
+     * and for guest memory.
+     */
+    bool DMACopy(GPUVAddr src_gpu_addr, GPUVAddr dst_gpu_addr, std::size_t size) {
+        std::lock_guard lock{mutex};
+
+        const auto& memory_manager = system.GPU().MemoryManager();
+        const std::optional<VAddr> src_cpu_addr = memory_manager.GpuToCpuAddress(src_gpu_addr);
+        const std::optional<VAddr> dst_cpu_addr = memory_manager.GpuToCpuAddress(dst_gpu_addr);
+        if (size == 0 || !src_cpu_addr || !dst_cpu_addr) {
+            return false;
+        }
+        if (*src_cpu_addr < *dst_cpu_addr + size && *dst_cpu_addr < *src_cpu_addr + size) {
+            // Overlapping copies have memmove semantics, which host buffer copies do not provide.
+            return false;
+        }
+
+        const VectorMapInterval src_maps = GetMapsInRange(*src_cpu_addr, size);
+        if (std::none_of(src_maps.begin(), src_maps.end(),
+                         [](const MapInterval* map) { return map->is_modified; })) {
+            return false;
+        }
+
+        // Make sure both ranges are fully backed by blocks. Mapping the destination may merge the
+        // block of the source into a new one, so it is looked up again afterwards.
+        if (!MapAddress(GetBlock(*src_cpu_addr, size), src_gpu_addr, *src_cpu_addr, size)) {
+            return false;
+        }
+        const OwnerBuffer dst_block = GetBlock(*dst_cpu_addr, size);
+        MapInterval* const dst_map = MapAddress(dst_block, dst_gpu_addr, *dst_cpu_addr, size);
+        if (!dst_map) {
+            return false;
+        }
+        const OwnerBuffer src_block = GetBlock(*src_cpu_addr, size);
+
+        CopyBlock(src_block, dst_block, src_block->GetOffset(*src_cpu_addr),
+                  dst_block->GetOffset(*dst_cpu_addr), size);
+
+        // The copy only happened on the host GPU, so the destination is now newer than guest
+        // memory, just like a storage buffer written by a shader.
+        dst_map->MarkAsModified(true, GetModifiedTicks());
+        if (Settings::IsGPULevelHigh() && Settings::values.use_asynchronous_gpu_emulation) {
+            MarkForAsyncFlush(dst_map);
+        }
+        if (!dst_map->is_written) {
+            dst_map->is_written = true;
+            MarkRegionAsWritten(dst_map->start, dst_map->end - 1);
+        }
+        return true;
+    }
+
     void Map(std::size_t max_size) {
         std::lock_guard lock{mutex};
 
@@ -174,6 +232,20 @@ public:
         }
     }
 
+    /// Writes the given data to the cached buffers overlapping the specified region, so they stay
+    /// registered and only the written bytes are uploaded
+    void UpdateRegion(VAddr addr, const u8* data, std::size_t size) {
+        std::lock_guard lock{mutex};
+
+        const VAddr addr_end = addr + size;
+        for (MapInterval* object : GetMapsInRange(addr, size)) {
+            const VAddr start = std::max(object->start, addr);
+            const VAddr end = std::min(object->end, addr_end);
+            const OwnerBuffer& block = blocks[object->start >> block_page_bits];
+            UploadBlockData(block, block->GetOffset(start), end - start, data + (start - addr));
+        }
+    }
+
     void OnCPUWrite(VAddr addr, std::size_t size) {
         std::lock_guard lock{mutex};
 
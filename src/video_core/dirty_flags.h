@@ -4,9 +4,8 @@
 
 #pragma once
 
-#include <algorithm>
+#include <array>
 #include <cstddef>
-#include <iterator>
 
 #include "common/common_types.h"
 #include "video_core/engines/maxwell_3d.h"
@@ -30,20 +29,271 @@ enum : u8 {
     LastCommonEntry,
 };
 
-template <typename Integer>
-void FillBlock(Tegra::Engines::Maxwell3D::DirtyState::Table& table, std::size_t begin,
-               std::size_t num, Integer dirty_index) {
-    const auto it = std::begin(table) + begin;
-    std::fill(it, it + num, static_cast<u8>(dirty_index));
+using Table = Tegra::Engines::Maxwell3D::DirtyState::Table;
+
+/// Maxwell3D register ranges whose writes are tracked by at least one of the renderers.
+enum class Range : std::size_t {
+    RenderTarget,
+    ZetaEnable,
+    ZetaWidth,
+    ZetaHeight,
+    Zeta,
+    ColorMaskCommon,
+    ColorMask,
+    ViewportTransform,
+    Viewport,
+    ViewportTransformEnabled,
+    ScissorTest,
+    VertexArray,
+    VertexArrayDivisor,
+    VertexArrayLimit,
+    InstancedArray,
+    VertexAttribFormat,
+    ShaderConfig,
+    PolygonModeFront,
+    PolygonModeBack,
+    FillRectangle,
+    DepthTestEnable,
+    DepthWriteEnabled,
+    DepthTestFunc,
+    DepthBounds,
+    StencilEnable,
+    StencilFrontFuncFunc,
+    StencilFrontFuncRef,
+    StencilFrontFuncMask,
+    StencilFrontOpFail,
+    StencilFrontOpZFail,
+    StencilFrontOpZPass,
+    StencilFrontMask,
+    StencilTwoSideEnable,
+    StencilBackFuncFunc,
+    StencilBackFuncRef,
+    StencilBackFuncMask,
+    StencilBackOpFail,
+    StencilBackOpZFail,
+    StencilBackOpZPass,
+    StencilBackMask,
+    AlphaTestRef,
+    AlphaTestFunc,
+    AlphaTestEnabled,
+    BlendColor,
+    IndependentBlendEnable,
+    IndependentBlend,
+    Blend,
+    BlendEnable,
+    PrimitiveRestart,
+    PolygonOffsetFillEnable,
+    PolygonOffsetLineEnable,
+    PolygonOffsetPointEnable,
+    PolygonOffsetFactor,
+    PolygonOffsetUnits,
+    PolygonOffsetClamp,
+    MultisampleControl,
+    RasterizeEnable,
+    FramebufferSRGB,
+    LogicOp,
+    FragColorClamp,
+    VpPointSize,
+    PointSize,
+    PointSpriteEnable,
+    LineWidthSmooth,
+    LineWidthAliased,
+    LineSmoothEnable,
+    ScreenYControl,
+    DepthMode,
+    ViewVolumeClipControl,
+    ClipDistanceEnabled,
+    FrontFace,
+    CullTestEnabled,
+    CullFace,
+
+    Count,
+};
+
+/**
+ * Registers covered by a range: `count` elements of `num` registers each, `stride` registers
+ * apart. Arrays of per-element state (one per render target, viewport...) are a single range.
+ */
+struct RegisterRange {
+    Range range;
+    std::size_t begin;
+    std::size_t num;
+    std::size_t count = 1;
+    std::size_t stride = 0;
+};
+
+#define OFF(field_name) MAXWELL3D_REG_INDEX(field_name)
+#define NUM(field_name) (sizeof(Tegra::Engines::Maxwell3D::Regs::field_name) / (sizeof(u32)))
+#define ARRAY(range, field_name, count)                                                            \
+    RegisterRange {                                                                                \
+        range, OFF(field_name), NUM(field_name[0]), count, NUM(field_name[0])                      \
+    }
+#define SINGLE(range, field_name)                                                                  \
+    RegisterRange {                                                                                \
+        range, OFF(field_name), NUM(field_name)                                                    \
+    }
+
+/// Every tracked register range, indexed by Range. Shared by all renderers.
+constexpr std::array<RegisterRange, static_cast<std::size_t>(Range::Count)> RegisterRanges{{
+    ARRAY(Range::RenderTarget, rt, Tegra::Engines::Maxwell3D::Regs::NumRenderTargets),
+    SINGLE(Range::ZetaEnable, zeta_enable),
+    SINGLE(Range::ZetaWidth, zeta_width),
+    SINGLE(Range::ZetaHeight, zeta_height),
+    SINGLE(Range::Zeta, zeta),
+    SINGLE(Range::ColorMaskCommon, color_mask_common),
+    ARRAY(Range::ColorMask, color_mask, Tegra::Engines::Maxwell3D::Regs::NumRenderTargets),
+    ARRAY(Range::ViewportTransform, viewport_transform,
+          Tegra::Engines::Maxwell3D::Regs::NumViewports),
+    ARRAY(Range::Viewport, viewports, Tegra::Engines::Maxwell3D::Regs::NumViewports),
+    SINGLE(Range::ViewportTransformEnabled, viewport_transform_enabled),
+    ARRAY(Range::ScissorTest, scissor_test, Tegra::Engines::Maxwell3D::Regs::NumViewports),
+    // The first three words of a vertex array hold its stride and address, the last one its
+    // instancing divisor.
+    {Range::VertexArray, OFF(vertex_array), 3, Tegra::Engines::Maxwell3D::Regs::NumVertexArrays,
+     NUM(vertex_array[0])},
+    {Range::VertexArrayDivisor, OFF(vertex_array) + 3, 1,
+     Tegra::Engines::Maxwell3D::Regs::NumVertexArrays, NUM(vertex_array[0])},
+    ARRAY(Range::VertexArrayLimit, vertex_array_limit,
+          Tegra::Engines::Maxwell3D::Regs::NumVertexArrays),
+    ARRAY(Range::InstancedArray, instanced_arrays.is_instanced,
+          Tegra::Engines::Maxwell3D::Regs::NumVertexArrays),
+    ARRAY(Range::VertexAttribFormat, vertex_attrib_format,
+          Tegra::Engines::Maxwell3D::Regs::NumVertexAttributes),
+    SINGLE(Range::ShaderConfig, shader_config),
+    SINGLE(Range::PolygonModeFront, polygon_mode_front),
+    SINGLE(Range::PolygonModeBack, polygon_mode_back),
+    SINGLE(Range::FillRectangle, fill_rectangle),
+    SINGLE(Range::DepthTestEnable, depth_test_enable),
+    SINGLE(Range::DepthWriteEnabled, depth_write_enabled),
+    SINGLE(Range::DepthTestFunc, depth_test_func),
+    SINGLE(Range::DepthBounds, depth_bounds),
+    SINGLE(Range::StencilEnable, stencil_enable),
+    SINGLE(Range::StencilFrontFuncFunc, stencil_front_func_func),
+    SINGLE(Range::StencilFrontFuncRef, stencil_front_func_ref),
+    SINGLE(Range::StencilFrontFuncMask, stencil_front_func_mask),
+    SINGLE(Range::StencilFrontOpFail, stencil_front_op_fail),
+    SINGLE(Range::StencilFrontOpZFail, stencil_front_op_zfail),
+    SINGLE(Range::StencilFrontOpZPass, stencil_front_op_zpass),
+    SINGLE(Range::StencilFrontMask, stencil_front_mask),
+    SINGLE(Range::StencilTwoSideEnable, stencil_two_side_enable),
+    SINGLE(Range::StencilBackFuncFunc, stencil_back_func_func),
+    SINGLE(Range::StencilBackFuncRef, stencil_back_func_ref),
+    SINGLE(Range::StencilBackFuncMask, stencil_back_func_mask),
+    SINGLE(Range::StencilBackOpFail, stencil_back_op_fail),
+    SINGLE(Range::StencilBackOpZFail, stencil_back_op_zfail),
+    SINGLE(Range::StencilBackOpZPass, stencil_back_op_zpass),
+    SINGLE(Range::StencilBackMask, stencil_back_mask),
+    SINGLE(Range::AlphaTestRef, alpha_test_ref),
+    SINGLE(Range::AlphaTestFunc, alpha_test_func),
+    SINGLE(Range::AlphaTestEnabled, alpha_test_enabled),
+    SINGLE(Range::BlendColor, blend_color),
+    SINGLE(Range::IndependentBlendEnable, independent_blend_enable),
+    ARRAY(Range::IndependentBlend, independent_blend,
+          Tegra::Engines::Maxwell3D::Regs::NumRenderTargets),
+    SINGLE(Range::Blend, blend),
+    ARRAY(Range::BlendEnable, blend.enable, Tegra::Engines::Maxwell3D::Regs::NumRenderTargets),
+    SINGLE(Range::PrimitiveRestart, primitive_restart),
+    SINGLE(Range::PolygonOffsetFillEnable, polygon_offset_fill_enable),
+    SINGLE(Range::PolygonOffsetLineEnable, polygon_offset_line_enable),
+    SINGLE(Range::PolygonOffsetPointEnable, polygon_offset_point_enable),
+    SINGLE(Range::PolygonOffsetFactor, polygon_offset_factor),
+    SINGLE(Range::PolygonOffsetUnits, polygon_offset_units),
+    SINGLE(Range::PolygonOffsetClamp, polygon_offset_clamp),
+    SINGLE(Range::MultisampleControl, multisample_control),
+    SINGLE(Range::RasterizeEnable, rasterize_enable),
+    SINGLE(Range::FramebufferSRGB, framebuffer_srgb),
+    SINGLE(Range::LogicOp, logic_op),
+    SINGLE(Range::FragColorClamp, frag_color_clamp),
+    SINGLE(Range::VpPointSize, vp_point_size),
+    SINGLE(Range::PointSize, point_size),
+    SINGLE(Range::PointSpriteEnable, point_sprite_enable),
+    SINGLE(Range::LineWidthSmooth, line_width_smooth),
+    SINGLE(Range::LineWidthAliased, line_width_aliased),
+    SINGLE(Range::LineSmoothEnable, line_smooth_enable),
+    SINGLE(Range::ScreenYControl, screen_y_control),
+    SINGLE(Range::DepthMode, depth_mode),
+    SINGLE(Range::ViewVolumeClipControl, view_volume_clip_control),
+    SINGLE(Range::ClipDistanceEnabled, clip_distance_enabled),
+    SINGLE(Range::FrontFace, front_face),
+    SINGLE(Range::CullTestEnabled, cull_test_enabled),
+    SINGLE(Range::CullFace, cull_face),
+}};
+
+#undef SINGLE
+#undef ARRAY
+#undef NUM
+#undef OFF
+
+constexpr bool AreRegisterRangesOrdered() {
+    for (std::size_t i = 0; i < RegisterRanges.size(); ++i) {
+        if (RegisterRanges[i].range != static_cast<Range>(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+static_assert(AreRegisterRangesOrdered(), "RegisterRanges must be listed in Range order");
+
+/// Flags set by writes to the registers of a range.
+struct Binding {
+    Range range;
+    /// Flag of each register, or NullEntry.
+    u8 flag;
+    /// Flag of the group the registers belong to, or NullEntry.
+    u8 group_flag;
+    /// Whether each element of the range gets its own flag, starting from `flag`.
+    bool indexed;
+};
+
+/// Binds a range to a single flag and, optionally, to the flag of its group.
+constexpr Binding Bind(Range range, u8 flag, u8 group_flag = NullEntry) {
+    return {range, flag, group_flag, false};
+}
+
+/// Binds each element of a range to consecutive flags starting from first_flag.
+constexpr Binding BindIndexed(Range range, u8 first_flag, u8 group_flag = NullEntry) {
+    return {range, first_flag, group_flag, true};
 }
 
-template <typename Integer1, typename Integer2>
-void FillBlock(Tegra::Engines::Maxwell3D::DirtyState::Tables& tables, std::size_t begin,
-               std::size_t num, Integer1 index_a, Integer2 index_b) {
-    FillBlock(tables[0], begin, num, index_a);
-    FillBlock(tables[1], begin, num, index_b);
+/// Only binds a range to the flag of its group.
+constexpr Binding BindGroup(Range range, u8 group_flag) {
+    return {range, NullEntry, group_flag, false};
 }
 
-void SetupDirtyRenderTargets(Tegra::Engines::Maxwell3D::DirtyState::Tables& tables);
+/// Bindings of the render target flags, common to all renderers.
+constexpr std::array CommonBindings{
+    BindIndexed(Range::RenderTarget, ColorBuffer0, RenderTargets),
+    Bind(Range::ZetaEnable, ZetaBuffer, RenderTargets),
+    Bind(Range::ZetaWidth, ZetaBuffer, RenderTargets),
+    Bind(Range::ZetaHeight, ZetaBuffer, RenderTargets),
+    Bind(Range::Zeta, ZetaBuffer, RenderTargets),
+};
+
+template <std::size_t N>
+constexpr void ApplyBindings(Table& table, const std::array<Binding, N>& bindings) {
+    for (const Binding& binding : bindings) {
+        const RegisterRange& range = RegisterRanges[static_cast<std::size_t>(binding.range)];
+        for (std::size_t element = 0; element < range.count; ++element) {
+            const std::size_t begin = range.begin + element * range.stride;
+            const std::size_t flag = binding.indexed ? binding.flag + element : binding.flag;
+            for (std::size_t method = begin; method < begin + range.num; ++method) {
+                if (binding.flag != NullEntry) {
+                    table[method][0] = static_cast<u8>(flag);
+                }
+                if (binding.group_flag != NullEntry) {
+                    table[method][1] = binding.group_flag;
+                }
+            }
+        }
+    }
+}
+
+/// Builds the dirty table of a renderer from its bindings. Meant to be evaluated at compile time.
+template <std::size_t... N>
+constexpr Table MakeTable(const std::array<Binding, N>&... bindings) {
+    Table table{};
+    (ApplyBindings(table, bindings), ...);
+    return table;
+}
 
 } // namespace VideoCommon::Dirty
@@ -49,7 +49,7 @@ bool DmaPusher::Step() {
     ASSERT_OR_EXECUTE(!command_list.empty(), {
         // Somehow the command_list is empty, in order to avoid a crash
         // We ignore it and assume its size is 0.
-        dma_pushbuffer.pop();
+        PopCommandList();
         dma_pushbuffer_subindex = 0;
         return true;
     });
@@ -58,7 +58,7 @@ bool DmaPusher::Step() {
 
     if (dma_pushbuffer_subindex >= command_list.size()) {
         // We've gone through the current list, remove it from the queue
-        dma_pushbuffer.pop();
+        PopCommandList();
         dma_pushbuffer_subindex = 0;
     }
 
@@ -66,20 +66,32 @@ bool DmaPusher::Step() {
         return true;
     }
 
-    // Push buffer non-empty, read a word
-    command_headers.resize(command_list_header.size);
-    gpu.MemoryManager().ReadBlockUnsafe(dma_get, command_headers.data(),
-                                        command_list_header.size * sizeof(u32));
+    // Push buffer non-empty, read a word. Segments that are contiguous in host memory, which is
+    // the common case, are decoded in place instead of being copied out first.
+    auto& memory_manager = gpu.MemoryManager();
+    const std::size_t size_bytes = command_list_header.size * sizeof(u32);
+    const u8* const host_pointer = memory_manager.GetPointer(dma_get);
+    if (host_pointer != nullptr && memory_manager.IsBlockContinuous(dma_get, size_bytes)) {
+        ProcessCommands(reinterpret_cast<const CommandHeader*>(host_pointer),
+                        command_list_header.size);
+    } else {
+        command_headers.resize(command_list_header.size);
+        memory_manager.ReadBlockUnsafe(dma_get, command_headers.data(), size_bytes);
+        ProcessCommands(command_headers.data(), command_headers.size());
+    }
 
-    for (std::size_t index = 0; index < command_headers.size();) {
-        const CommandHeader& command_header = command_headers[index];
+    return true;
+}
+
+void DmaPusher::ProcessCommands(const CommandHeader* headers, std::size_t num_headers) {
+    for (std::size_t index = 0; index < num_headers;) {
+        const CommandHeader& command_header = headers[index];
 
         if (dma_state.method_count) {
             // Data word of methods command
             if (dma_state.non_incrementing) {
                 const u32 max_write = static_cast<u32>(
-                    std::min<std::size_t>(index + dma_state.method_count, command_headers.size()) -
-                    index);
+                    std::min<std::size_t>(index + dma_state.method_count, num_headers) - index);
                 CallMultiMethod(&command_header.argument, max_write);
                 dma_state.method_count -= max_write;
                 dma_state.is_last_call = true;
@@ -130,8 +142,11 @@ bool DmaPusher::Step() {
         }
         index++;
     }
+}
 
-    return true;
+void DmaPusher::PopCommandList() {
+    command_list_pool.Release(std::move(dma_pushbuffer.front()));
+    dma_pushbuffer.pop();
 }
 
 void DmaPusher::SetState(const CommandHeader& command_header) {
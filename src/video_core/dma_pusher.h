@@ -5,6 +5,8 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
+#include <mutex>
 #include <vector>
 #include <queue>
 
@@ -53,6 +55,47 @@ class GPU;
 
 using CommandList = std::vector<Tegra::CommandListHeader>;
 
+/**
+ * Keeps the storage of processed command lists around, so that submitting a list doesn't have to
+ * allocate. Thread-safe, lists are acquired by the thread submitting them and released by the
+ * thread processing them.
+ */
+class CommandListPool {
+public:
+    /// Maximum number of processed command lists kept around for reuse
+    static constexpr std::size_t max_free_lists = 64;
+
+    /// Returns an empty command list, reusing the storage of a released list when possible.
+    CommandList Acquire() {
+        std::scoped_lock lock{mutex};
+        if (free_lists.empty()) {
+            return {};
+        }
+        CommandList command_list = std::move(free_lists.back());
+        free_lists.pop_back();
+        return command_list;
+    }
+
+    /// Takes back a processed command list, keeping its storage unless the pool is full.
+    void Release(CommandList&& command_list) {
+        command_list.clear();
+        std::scoped_lock lock{mutex};
+        if (free_lists.size() < max_free_lists) {
+            free_lists.push_back(std::move(command_list));
+        }
+    }
+
+    /// Returns the number of lists currently held for reuse.
+    std::size_t NumFreeLists() const {
+        std::scoped_lock lock{mutex};
+        return free_lists.size();
+    }
+
+private:
+    mutable std::mutex mutex;
+    std::vector<CommandList> free_lists; ///< Processed lists whose storage can be reused
+};
+
 /**
  * The DmaPusher class implements DMA submission to FIFOs, providing an area of memory that the
  * emulated app fills with commands and tells PFIFO to process. The pushbuffers are then assembled
@@ -69,6 +112,12 @@ public:
         dma_pushbuffer.push(std::move(entries));
     }
 
+    /// Returns an empty command list, reusing the storage of a list that has already been
+    /// processed when possible. Thread-safe, it is called by the thread submitting the lists.
+    CommandList AcquireCommandList() {
+        return command_list_pool.Acquire();
+    }
+
     void DispatchCalls();
 
     void BindSubchannel(Tegra::Engines::EngineInterface* engine, u32 subchannel_id) {
@@ -80,16 +129,25 @@ private:
     static constexpr u32 max_subchannels = 8;
     bool Step();
 
+    /// Decodes and executes the given words of a pushbuffer segment.
+    void ProcessCommands(const CommandHeader* headers, std::size_t num_headers);
+
+    /// Removes the front command list from the queue and recycles its storage.
+    void PopCommandList();
+
     void SetState(const CommandHeader& command_header);
 
     void CallMethod(u32 argument) const;
     void CallMultiMethod(const u32* base_start, u32 num_methods) const;
 
-    std::vector<CommandHeader> command_headers; ///< Buffer for list of commands fetched at once
+    /// Buffer for segments that have to be copied out of non-contiguous memory before decoding
+    std::vector<CommandHeader> command_headers;
 
     std::queue<CommandList> dma_pushbuffer; ///< Queue of command lists to be processed
     std::size_t dma_pushbuffer_subindex{};  ///< Index within a command list within the pushbuffer
 
+    CommandListPool command_list_pool; ///< Storage of processed lists, reused for new ones
+
     struct DmaState {
         u32 method;            ///< Current method
         u32 subchannel;        ///< Current subchannel
@@ -8,6 +8,7 @@
 #include "common/assert.h"
 #include "core/core.h"
 #include "core/core_timing.h"
+#include "core/settings.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/engines/shader_type.h"
 #include "video_core/gpu.h"
@@ -22,11 +23,15 @@ using VideoCore::QueryType;
 /// First register id that is actually a Macro call.
 constexpr u32 MacroRegistersStart = 0xE00;
 
+/// Dirty table used until the renderer installs its own, registers do not set any flag.
+constexpr Maxwell3D::DirtyState::Table NullDirtyTable{};
+
 Maxwell3D::Maxwell3D(Core::System& system, VideoCore::RasterizerInterface& rasterizer,
                      MemoryManager& memory_manager)
     : system{system}, rasterizer{rasterizer}, memory_manager{memory_manager},
       macro_engine{GetMacroEngine(*this)}, upload_state{memory_manager, regs.upload} {
     dirty.flags.flip();
+    dirty.table = &NullDirtyTable;
     InitializeRegisterDefaults();
 }
 
@@ -185,9 +190,9 @@ void Maxwell3D::CallMethod(u32 method, u32 method_argument, bool is_last_call) {
     if (regs.reg_array[method] != arg) {
         regs.reg_array[method] = arg;
 
-        for (const auto& table : dirty.tables) {
-            dirty.flags[table[method]] = true;
-        }
+        const auto& [flag, group_flag] = (*dirty.table)[method];
+        dirty.flags[flag] = true;
+        dirty.flags[group_flag] = true;
     }
 
     switch (method) {
@@ -503,21 +508,18 @@ void Maxwell3D::ProcessQueryCondition() {
         break;
     }
     case Regs::ConditionMode::ResNonZero: {
-        Regs::QueryCompare cmp;
-        memory_manager.ReadBlock(condition_address, &cmp, sizeof(cmp));
+        const Regs::QueryCompare cmp = ReadQueryCompare(condition_address);
         execute_on = cmp.initial_sequence != 0U && cmp.initial_mode != 0U;
         break;
     }
     case Regs::ConditionMode::Equal: {
-        Regs::QueryCompare cmp;
-        memory_manager.ReadBlock(condition_address, &cmp, sizeof(cmp));
+        const Regs::QueryCompare cmp = ReadQueryCompare(condition_address);
         execute_on =
             cmp.initial_sequence == cmp.current_sequence && cmp.initial_mode == cmp.current_mode;
         break;
     }
     case Regs::ConditionMode::NotEqual: {
-        Regs::QueryCompare cmp;
-        memory_manager.ReadBlock(condition_address, &cmp, sizeof(cmp));
+        const Regs::QueryCompare cmp = ReadQueryCompare(condition_address);
         execute_on =
             cmp.initial_sequence != cmp.current_sequence || cmp.initial_mode != cmp.current_mode;
         break;
@@ -530,6 +532,21 @@ void Maxwell3D::ProcessQueryCondition() {
     }
 }
 
+Maxwell3D::Regs::QueryCompare Maxwell3D::ReadQueryCompare(GPUVAddr condition_address) const {
+    Regs::QueryCompare cmp;
+    if (!Settings::values.use_fast_conditional_rendering) {
+        memory_manager.ReadBlock(condition_address, &cmp, sizeof(cmp));
+        return cmp;
+    }
+    // Don't stall the GPU thread on results the host GPU hasn't produced yet. Those queries keep
+    // their last known value in guest memory until their fence passes or they are read again.
+    if (const std::optional<VAddr> cpu_addr = memory_manager.GpuToCpuAddress(condition_address)) {
+        rasterizer.FlushReadyQueries(*cpu_addr, sizeof(cmp));
+    }
+    memory_manager.ReadBlockUnsafe(condition_address, &cmp, sizeof(cmp));
+    return cmp;
+}
+
 void Maxwell3D::ProcessCounterReset() {
     switch (regs.counter_reset) {
     case Regs::CounterReset::SampleCnt:
@@ -642,12 +659,9 @@ void Maxwell3D::ProcessCBMultiData(u32 method, const u32* start_base, u32 amount
         cb_data_state.counter = 0;
     }
     const std::size_t id = cb_data_state.id;
-    const std::size_t size = amount;
-    std::size_t i = 0;
-    for (; i < size; i++) {
-        cb_data_state.buffer[id][cb_data_state.counter] = start_base[i];
-        cb_data_state.counter++;
-    }
+    std::memcpy(&cb_data_state.buffer[id][cb_data_state.counter], start_base,
+                amount * sizeof(u32));
+    cb_data_state.counter += amount;
     // Increment the current buffer position.
     regs.const_buffer.cb_pos = regs.const_buffer.cb_pos + 4 * amount;
 }
@@ -664,7 +678,16 @@ void Maxwell3D::FinishCBData() {
     const std::size_t size = regs.const_buffer.cb_pos - cb_data_state.start_pos;
 
     const u32 id = cb_data_state.id;
-    memory_manager.WriteBlock(address, cb_data_state.buffer[id].data(), size);
+    const auto* const data = reinterpret_cast<const u8*>(cb_data_state.buffer[id].data());
+    const std::optional<VAddr> cpu_addr = memory_manager.GpuToCpuAddress(address);
+    if (cpu_addr && memory_manager.IsBlockContinuous(address, size)) {
+        // Commit the whole batch at once and update cached buffers with the written range only,
+        // instead of invalidating them and uploading the entire buffer on the next draw.
+        rasterizer.UpdateRegion(*cpu_addr, data, size);
+        memory_manager.WriteBlockUnsafe(address, data, size);
+    } else {
+        memory_manager.WriteBlock(address, data, size);
+    }
     OnMemoryWrite();
 
     cb_data_state.id = null_cb_data;
@@ -1438,12 +1438,13 @@ public:
 
     struct DirtyState {
         using Flags = std::bitset<std::numeric_limits<u8>::max()>;
-        using Table = std::array<u8, Regs::NUM_REGS>;
-        using Tables = std::array<Table, 2>;
+        /// Flags set by writes to each register: its own flag and the flag of its group.
+        using Table = std::array<std::array<u8, 2>, Regs::NUM_REGS>;
 
         Flags flags;
         Flags on_write_stores;
-        Tables tables{};
+        /// Register to flag mapping of the renderer, generated at compile time.
+        const Table* table = nullptr;
     } dirty;
 
 private:
@@ -1518,6 +1519,9 @@ private:
     /// Handles conditional rendering.
     void ProcessQueryCondition();
 
+    /// Reads the query results conditional rendering compares.
+    Regs::QueryCompare ReadQueryCompare(GPUVAddr condition_address) const;
+
     /// Handles counter resets.
     void ProcessCounterReset();
 
@@ -9,13 +9,15 @@
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/engines/maxwell_dma.h"
 #include "video_core/memory_manager.h"
+#include "video_core/rasterizer_interface.h"
 #include "video_core/renderer_base.h"
 #include "video_core/textures/decoders.h"
 
 namespace Tegra::Engines {
 
-MaxwellDMA::MaxwellDMA(Core::System& system, MemoryManager& memory_manager)
-    : system{system}, memory_manager{memory_manager} {}
+MaxwellDMA::MaxwellDMA(Core::System& system, VideoCore::RasterizerInterface& rasterizer,
+                       MemoryManager& memory_manager)
+    : system{system}, rasterizer{rasterizer}, memory_manager{memory_manager} {}
 
 void MaxwellDMA::CallMethod(u32 method, u32 method_argument, bool is_last_call) {
     ASSERT_MSG(method < Regs::NUM_REGS,
@@ -71,7 +73,13 @@ void MaxwellDMA::HandleCopy() {
         // buffer of length `x_count`, otherwise we copy a 2D image of dimensions (x_count,
         // y_count).
         if (!regs.exec.enable_2d) {
-            memory_manager.CopyBlock(dest, source, regs.x_count);
+            CopyBuffer(dest, source, regs.x_count);
+            return;
+        }
+
+        // Images without padding at the end of their lines are copied as a single buffer.
+        if (regs.src_pitch == regs.x_count && regs.dst_pitch == regs.x_count) {
+            CopyBuffer(dest, source, static_cast<u64>(regs.x_count) * regs.y_count);
             return;
         }
 
@@ -116,10 +124,11 @@ void MaxwellDMA::HandleCopy() {
 
             if (Settings::IsGPULevelExtreme()) {
                 memory_manager.ReadBlock(source + offset, read_buffer.data(), src_size);
-                memory_manager.ReadBlock(dest, write_buffer.data(), dst_size);
             } else {
                 memory_manager.ReadBlockUnsafe(source + offset, read_buffer.data(), src_size);
-                memory_manager.ReadBlockUnsafe(dest, write_buffer.data(), dst_size);
+            }
+            if (regs.x_count * bytes_per_pixel != regs.dst_pitch) {
+                ReadDestination(dest, dst_size);
             }
 
             Texture::UnswizzleSubrect(regs.x_count, regs.y_count, regs.dst_pitch,
@@ -153,10 +162,12 @@ void MaxwellDMA::HandleCopy() {
 
         if (Settings::IsGPULevelExtreme()) {
             memory_manager.ReadBlock(source, read_buffer.data(), src_size);
-            memory_manager.ReadBlock(dest, write_buffer.data(), dst_size);
         } else {
             memory_manager.ReadBlockUnsafe(source, read_buffer.data(), src_size);
-            memory_manager.ReadBlockUnsafe(dest, write_buffer.data(), dst_size);
+        }
+        // Lines that are written in full do not need the previous contents of the destination.
+        if (regs.x_count * bytes_per_pixel != regs.dst_pitch) {
+            ReadDestination(dest, dst_size);
         }
 
         Texture::UnswizzleSubrect(
@@ -190,11 +201,10 @@ void MaxwellDMA::HandleCopy() {
 
         if (Settings::IsGPULevelExtreme()) {
             memory_manager.ReadBlock(source, read_buffer.data(), src_size);
-            memory_manager.ReadBlock(dest, write_buffer.data(), dst_size);
         } else {
             memory_manager.ReadBlockUnsafe(source, read_buffer.data(), src_size);
-            memory_manager.ReadBlockUnsafe(dest, write_buffer.data(), dst_size);
         }
+        ReadDestination(dest, dst_size);
 
         // If the input is linear and the output is tiled, swizzle the input and copy it over.
         Texture::SwizzleSubrect(
@@ -206,4 +216,22 @@ void MaxwellDMA::HandleCopy() {
     }
 }
 
+void MaxwellDMA::CopyBuffer(GPUVAddr dest, GPUVAddr source, u64 size) {
+    if (rasterizer.AccelerateDMABufferCopy(source, dest, size)) {
+        // Readers that skip flushing, like swizzled copies and conditional rendering, read guest
+        // memory directly. Keep the destination as current there as the source is.
+        memory_manager.CopyBlockUnsafe(dest, source, size);
+        return;
+    }
+    memory_manager.CopyBlock(dest, source, size);
+}
+
+void MaxwellDMA::ReadDestination(GPUVAddr dest, std::size_t dst_size) {
+    if (Settings::IsGPULevelExtreme()) {
+        memory_manager.ReadBlock(dest, write_buffer.data(), dst_size);
+    } else {
+        memory_manager.ReadBlockUnsafe(dest, write_buffer.data(), dst_size);
+    }
+}
+
 } // namespace Tegra::Engines
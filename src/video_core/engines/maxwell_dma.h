@@ -21,6 +21,10 @@ namespace Tegra {
 class MemoryManager;
 }
 
+namespace VideoCore {
+class RasterizerInterface;
+}
+
 namespace Tegra::Engines {
 
 /**
@@ -30,7 +34,8 @@ namespace Tegra::Engines {
 
 class MaxwellDMA final : public EngineInterface {
 public:
-    explicit MaxwellDMA(Core::System& system, MemoryManager& memory_manager);
+    explicit MaxwellDMA(Core::System& system, VideoCore::RasterizerInterface& rasterizer,
+                        MemoryManager& memory_manager);
     ~MaxwellDMA() = default;
 
     /// Write the value to the register identified by method.
@@ -180,14 +185,23 @@ public:
 private:
     Core::System& system;
 
+    VideoCore::RasterizerInterface& rasterizer;
+
     MemoryManager& memory_manager;
 
+    /// Staging memory for swizzled copies, kept around between copies to avoid reallocating it.
     std::vector<u8> read_buffer;
     std::vector<u8> write_buffer;
 
     /// Performs the copy from the source buffer to the destination buffer as configured in the
     /// registers.
     void HandleCopy();
+
+    /// Copies a linear buffer, letting the rasterizer do it on the host GPU when possible.
+    void CopyBuffer(GPUVAddr dest, GPUVAddr source, u64 size);
+
+    /// Reads the current contents of the destination of a swizzled copy into the write buffer.
+    void ReadDestination(GPUVAddr dest, std::size_t dst_size);
 };
 
 #define ASSERT_REG_POSITION(field_name, position)                                                  \
@@ -2,12 +2,17 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <thread>
+
 #include "common/assert.h"
 #include "common/microprofile.h"
+#include "common/thread_pool.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/core_timing_util.h"
 #include "core/frontend/emu_window.h"
+#include "core/hardware_properties.h"
 #include "core/memory.h"
 #include "core/settings.h"
 #include "video_core/engines/fermi_2d.h"
@@ -24,15 +29,31 @@ namespace Tegra {
 
 MICROPROFILE_DEFINE(GPU_wait, "GPU", "Wait for the GPU", MP_RGB(128, 128, 192));
 
+namespace {
+/**
+ * Uses the number of workers set by the user. By default, leaves a host thread for each thread
+ * running the emulated CPU and one for the GPU thread, and is never smaller than one worker.
+ */
+std::size_t NumWorkerThreads() {
+    if (Settings::values.video_worker_threads != 0) {
+        return Settings::values.video_worker_threads;
+    }
+    const u32 num_cpu_threads = Settings::values.use_multi_core ? Core::Hardware::NUM_CPU_CORES : 1;
+    const u32 num_reserved = num_cpu_threads + 1;
+    return std::max(std::thread::hardware_concurrency(), num_reserved + 1) - num_reserved;
+}
+} // Anonymous namespace
+
 GPU::GPU(Core::System& system, std::unique_ptr<VideoCore::RendererBase>&& renderer_, bool is_async)
-    : system{system}, renderer{std::move(renderer_)}, is_async{is_async} {
+    : worker_pool{std::make_unique<Common::ThreadPool>("VideoWorker", NumWorkerThreads())},
+      system{system}, renderer{std::move(renderer_)}, is_async{is_async} {
     auto& rasterizer{renderer->Rasterizer()};
     memory_manager = std::make_unique<Tegra::MemoryManager>(system, rasterizer);
     dma_pusher = std::make_unique<Tegra::DmaPusher>(system, *this);
     maxwell_3d = std::make_unique<Engines::Maxwell3D>(system, rasterizer, *memory_manager);
     fermi_2d = std::make_unique<Engines::Fermi2D>(rasterizer);
     kepler_compute = std::make_unique<Engines::KeplerCompute>(system, rasterizer, *memory_manager);
-    maxwell_dma = std::make_unique<Engines::MaxwellDMA>(system, *memory_manager);
+    maxwell_dma = std::make_unique<Engines::MaxwellDMA>(system, rasterizer, *memory_manager);
     kepler_memory = std::make_unique<Engines::KeplerMemory>(system, *memory_manager);
 }
 
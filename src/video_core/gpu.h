@@ -24,6 +24,10 @@ inline u8* FromCacheAddr(CacheAddr cache_addr) {
     return reinterpret_cast<u8*>(cache_addr);
 }
 
+namespace Common {
+class ThreadPool;
+} // namespace Common
+
 namespace Core {
 namespace Frontend {
 class EmuWindow;
@@ -199,6 +203,11 @@ public:
     /// Returns a reference to the GPU DMA pusher.
     Tegra::DmaPusher& DmaPusher();
 
+    /// Returns a reference to the thread pool shared by the video core subsystems.
+    Common::ThreadPool& WorkerPool() {
+        return *worker_pool;
+    }
+
     VideoCore::RendererBase& Renderer() {
         return *renderer;
     }
@@ -210,6 +219,9 @@ public:
     // Waits for the GPU to finish working
     virtual void WaitIdle() const = 0;
 
+    /// Returns the number of swapped frames that have not been presented on the host yet.
+    virtual u32 QueuedFrames() const = 0;
+
     /// Allows the CPU/NvFlinger to wait on the GPU before presenting a frame.
     void WaitFence(u32 syncpoint_id, u32 value);
 
@@ -322,6 +334,8 @@ private:
     bool ExecuteMethodOnEngine(u32 method);
 
 protected:
+    /// Declared first so that it outlives the renderer and the engines submitting work to it.
+    std::unique_ptr<Common::ThreadPool> worker_pool;
     std::unique_ptr<Tegra::DmaPusher> dma_pusher;
     Core::System& system;
     std::unique_ptr<VideoCore::RendererBase> renderer;
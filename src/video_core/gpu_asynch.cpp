@@ -52,6 +52,10 @@ void GPUAsynch::WaitIdle() const {
     gpu_thread.WaitIdle();
 }
 
+u32 GPUAsynch::QueuedFrames() const {
+    return gpu_thread.QueuedFrames();
+}
+
 void GPUAsynch::OnCommandListEnd() {
     gpu_thread.OnCommandListEnd();
 }
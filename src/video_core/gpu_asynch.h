@@ -31,6 +31,7 @@ public:
     void InvalidateRegion(VAddr addr, u64 size) override;
     void FlushAndInvalidateRegion(VAddr addr, u64 size) override;
     void WaitIdle() const override;
+    u32 QueuedFrames() const override;
 
     void OnCommandListEnd() override;
 
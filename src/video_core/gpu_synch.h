@@ -30,6 +30,9 @@ public:
     void InvalidateRegion(VAddr addr, u64 size) override;
     void FlushAndInvalidateRegion(VAddr addr, u64 size) override;
     void WaitIdle() const override {}
+    u32 QueuedFrames() const override {
+        return 0;
+    }
 
 protected:
     void TriggerCpuInterrupt([[maybe_unused]] u32 syncpoint_id,
@@ -39,6 +39,7 @@ static void RunThread(Core::System& system, VideoCore::RendererBase& renderer,
             dma_pusher.DispatchCalls();
         } else if (const auto data = std::get_if<SwapBuffersCommand>(&next.data)) {
             renderer.SwapBuffers(data->framebuffer ? &*data->framebuffer : nullptr);
+            state.queued_frames.fetch_sub(1, std::memory_order_relaxed);
         } else if (const auto data = std::get_if<OnCommandListEndCommand>(&next.data)) {
             renderer.Rasterizer().ReleaseFences();
         } else if (const auto data = std::get_if<GPUTickCommand>(&next.data)) {
@@ -80,6 +81,7 @@ void ThreadManager::SubmitList(Tegra::CommandList&& entries) {
 }
 
 void ThreadManager::SwapBuffers(const Tegra::FramebufferConfig* framebuffer) {
+    state.queued_frames.fetch_add(1, std::memory_order_relaxed);
     PushCommand(SwapBuffersCommand(framebuffer ? std::make_optional(*framebuffer) : std::nullopt));
 }
 
@@ -119,6 +121,7 @@ void ThreadManager::OnCommandListEnd() {
 }
 
 u64 ThreadManager::PushCommand(CommandData&& command_data) {
+    std::lock_guard lock{state.push_mutex};
     const u64 fence{++state.last_fence};
     state.queue.Push(CommandDataContainer(std::move(command_data), fence));
     return fence;
@@ -97,8 +97,12 @@ struct SynchState final {
 
     using CommandQueue = Common::MPSCQueue<CommandDataContainer>;
     CommandQueue queue;
+    // Keeps fences in queue order when several CPU core threads push commands at once.
+    std::mutex push_mutex;
     u64 last_fence{};
     std::atomic<u64> signaled_fence{};
+    /// Number of SwapBuffers commands pushed that the GPU thread has not presented yet
+    std::atomic<u32> queued_frames{};
 };
 
 /// Class used to manage the GPU thread
@@ -129,6 +133,11 @@ public:
     // Wait until the gpu thread is idle.
     void WaitIdle() const;
 
+    /// Returns the number of swapped frames the GPU thread has not presented yet.
+    u32 QueuedFrames() const {
+        return state.queued_frames.load(std::memory_order_relaxed);
+    }
+
     void OnCommandListEnd();
 
 private:
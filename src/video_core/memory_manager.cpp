@@ -16,8 +16,8 @@
 namespace Tegra {
 
 MemoryManager::MemoryManager(Core::System& system, VideoCore::RasterizerInterface& rasterizer)
-    : rasterizer{rasterizer}, system{system} {
-    page_table.Resize(address_space_width, page_bits, false);
+    : page_table{address_space_width, page_bits, page_table_second_level_bits},
+      rasterizer{rasterizer}, system{system} {
 
     // Initialize the map with a single free region covering the entire managed space.
     VirtualMemoryArea initial_vma;
@@ -107,7 +107,7 @@ GPUVAddr MemoryManager::FindFreeRegion(GPUVAddr region_start, u64 size) const {
 }
 
 bool MemoryManager::IsAddressValid(GPUVAddr addr) const {
-    return (addr >> page_bits) < page_table.pointers.size();
+    return (addr >> page_bits) < page_table.GetNumPages();
 }
 
 std::optional<VAddr> MemoryManager::GpuToCpuAddress(GPUVAddr addr) const {
@@ -115,7 +115,7 @@ std::optional<VAddr> MemoryManager::GpuToCpuAddress(GPUVAddr addr) const {
         return {};
     }
 
-    const VAddr cpu_addr{page_table.backing_addr[addr >> page_bits]};
+    const VAddr cpu_addr{page_table.Get(addr >> page_bits)};
     if (cpu_addr) {
         return cpu_addr + (addr & page_mask);
     }
@@ -174,7 +174,7 @@ u8* MemoryManager::GetPointer(GPUVAddr addr) {
 
     auto& memory = system.Memory();
 
-    const VAddr page_addr{page_table.backing_addr[addr >> page_bits]};
+    const VAddr page_addr{page_table.Get(addr >> page_bits)};
 
     if (page_addr != 0) {
         return memory.GetPointer(page_addr + (addr & page_mask));
@@ -191,7 +191,7 @@ const u8* MemoryManager::GetPointer(GPUVAddr addr) const {
 
     const auto& memory = system.Memory();
 
-    const VAddr page_addr{page_table.backing_addr[addr >> page_bits]};
+    const VAddr page_addr{page_table.Get(addr >> page_bits)};
 
     if (page_addr != 0) {
         return memory.GetPointer(page_addr + (addr & page_mask));
@@ -221,7 +221,7 @@ void MemoryManager::ReadBlock(GPUVAddr src_addr, void* dest_buffer, const std::s
         const std::size_t copy_amount{
             std::min(static_cast<std::size_t>(page_size) - page_offset, remaining_size)};
 
-        const VAddr src_addr{page_table.backing_addr[page_index] + page_offset};
+        const VAddr src_addr{page_table.Get(page_index) + page_offset};
         // Flush must happen on the rasterizer interface, such that memory is always synchronous
         // when it is read (even when in asynchronous GPU mode). Fixes Dead Cells title menu.
         rasterizer.FlushRegion(src_addr, copy_amount);
@@ -245,9 +245,9 @@ void MemoryManager::ReadBlockUnsafe(GPUVAddr src_addr, void* dest_buffer,
     while (remaining_size > 0) {
         const std::size_t copy_amount{
             std::min(static_cast<std::size_t>(page_size) - page_offset, remaining_size)};
-        const u8* page_pointer = page_table.pointers[page_index];
-        if (page_pointer) {
-            const VAddr src_addr{page_table.backing_addr[page_index] + page_offset};
+        const VAddr page_addr{page_table.Get(page_index)};
+        if (page_addr != 0) {
+            const VAddr src_addr{page_addr + page_offset};
             memory.ReadBlockUnsafe(src_addr, dest_buffer, copy_amount);
         } else {
             std::memset(dest_buffer, 0, copy_amount);
@@ -270,7 +270,7 @@ void MemoryManager::WriteBlock(GPUVAddr dest_addr, const void* src_buffer, const
         const std::size_t copy_amount{
             std::min(static_cast<std::size_t>(page_size) - page_offset, remaining_size)};
 
-        const VAddr dest_addr{page_table.backing_addr[page_index] + page_offset};
+        const VAddr dest_addr{page_table.Get(page_index) + page_offset};
         // Invalidate must happen on the rasterizer interface, such that memory is always
         // synchronous when it is written (even when in asynchronous GPU mode).
         rasterizer.InvalidateRegion(dest_addr, copy_amount);
@@ -294,9 +294,9 @@ void MemoryManager::WriteBlockUnsafe(GPUVAddr dest_addr, const void* src_buffer,
     while (remaining_size > 0) {
         const std::size_t copy_amount{
             std::min(static_cast<std::size_t>(page_size) - page_offset, remaining_size)};
-        u8* page_pointer = page_table.pointers[page_index];
-        if (page_pointer) {
-            const VAddr dest_addr{page_table.backing_addr[page_index] + page_offset};
+        const VAddr page_addr{page_table.Get(page_index)};
+        if (page_addr != 0) {
+            const VAddr dest_addr{page_addr + page_offset};
             memory.WriteBlockUnsafe(dest_addr, src_buffer, copy_amount);
         }
         page_index++;
@@ -319,49 +319,35 @@ void MemoryManager::CopyBlockUnsafe(GPUVAddr dest_addr, GPUVAddr src_addr, const
 }
 
 bool MemoryManager::IsGranularRange(GPUVAddr gpu_addr, std::size_t size) {
-    const VAddr addr = page_table.backing_addr[gpu_addr >> page_bits];
+    const VAddr addr = page_table.Get(gpu_addr >> page_bits);
     const std::size_t page = (addr & Core::Memory::PAGE_MASK) + size;
     return page <= Core::Memory::PAGE_SIZE;
 }
 
-void MemoryManager::MapPages(GPUVAddr base, u64 size, u8* memory, Common::PageType type,
-                             VAddr backing_addr) {
-    LOG_DEBUG(HW_GPU, "Mapping {} onto {:016X}-{:016X}", fmt::ptr(memory), base * page_size,
+void MemoryManager::MapPages(GPUVAddr base, u64 size, VAddr backing_addr) {
+    LOG_DEBUG(HW_GPU, "Mapping {:016X} onto {:016X}-{:016X}", backing_addr, base * page_size,
               (base + size) * page_size);
 
-    const VAddr end{base + size};
-    ASSERT_MSG(end <= page_table.pointers.size(), "out of range mapping at {:016X}",
-               base + page_table.pointers.size());
+    ASSERT_MSG(base + size <= page_table.GetNumPages(), "out of range mapping at {:016X}",
+               base * page_size);
 
-    if (memory == nullptr) {
-        while (base != end) {
-            page_table.pointers[base] = nullptr;
-            page_table.backing_addr[base] = 0;
-
-            base += 1;
-        }
+    if (backing_addr == 0) {
+        page_table.Unmap(base, size);
     } else {
-        while (base != end) {
-            page_table.pointers[base] = memory;
-            page_table.backing_addr[base] = backing_addr;
-
-            base += 1;
-            memory += page_size;
-            backing_addr += page_size;
-        }
+        page_table.Map(base, size, backing_addr);
     }
 }
 
-void MemoryManager::MapMemoryRegion(GPUVAddr base, u64 size, u8* target, VAddr backing_addr) {
+void MemoryManager::MapMemoryRegion(GPUVAddr base, u64 size, VAddr backing_addr) {
     ASSERT_MSG((size & page_mask) == 0, "non-page aligned size: {:016X}", size);
     ASSERT_MSG((base & page_mask) == 0, "non-page aligned base: {:016X}", base);
-    MapPages(base / page_size, size / page_size, target, Common::PageType::Memory, backing_addr);
+    MapPages(base / page_size, size / page_size, backing_addr);
 }
 
 void MemoryManager::UnmapRegion(GPUVAddr base, u64 size) {
     ASSERT_MSG((size & page_mask) == 0, "non-page aligned size: {:016X}", size);
     ASSERT_MSG((base & page_mask) == 0, "non-page aligned base: {:016X}", base);
-    MapPages(base / page_size, size / page_size, nullptr, Common::PageType::Unmapped);
+    MapPages(base / page_size, size / page_size, 0);
 }
 
 bool VirtualMemoryArea::CanBeMergedWith(const VirtualMemoryArea& next) const {
@@ -565,10 +551,10 @@ void MemoryManager::UpdatePageTableForVMA(const VirtualMemoryArea& vma) {
         UnmapRegion(vma.base, vma.size);
         break;
     case VirtualMemoryArea::Type::Allocated:
-        MapMemoryRegion(vma.base, vma.size, nullptr, vma.backing_addr);
+        MapMemoryRegion(vma.base, vma.size, vma.backing_addr);
         break;
     case VirtualMemoryArea::Type::Mapped:
-        MapMemoryRegion(vma.base, vma.size, vma.backing_memory, vma.backing_addr);
+        MapMemoryRegion(vma.base, vma.size, vma.backing_addr);
         break;
     }
 }
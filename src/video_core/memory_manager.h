@@ -8,7 +8,7 @@
 #include <optional>
 
 #include "common/common_types.h"
-#include "common/page_table.h"
+#include "common/multi_level_page_table.h"
 
 namespace VideoCore {
 class RasterizerInterface;
@@ -108,9 +108,9 @@ private:
     using VMAIter = VMAMap::iterator;
 
     bool IsAddressValid(GPUVAddr addr) const;
-    void MapPages(GPUVAddr base, u64 size, u8* memory, Common::PageType type,
-                  VAddr backing_addr = 0);
-    void MapMemoryRegion(GPUVAddr base, u64 size, u8* target, VAddr backing_addr);
+    /// Maps a range of pages to the given CPU address, or unmaps them if it is zero.
+    void MapPages(GPUVAddr base, u64 size, VAddr backing_addr);
+    void MapMemoryRegion(GPUVAddr base, u64 size, VAddr backing_addr);
     void UnmapRegion(GPUVAddr base, u64 size);
 
     /// Finds the VMA in which the given address is included in, or `vma_map.end()`.
@@ -178,8 +178,11 @@ private:
     static constexpr GPUVAddr address_space_base{0x100000};
     /// End of address space, based on address space in bits.
     static constexpr GPUVAddr address_space_end{1ULL << address_space_width};
+    /// Each second level page table covers 64 MiB of the address space.
+    static constexpr u64 page_table_second_level_bits{10};
 
-    Common::PageTable page_table;
+    /// Translates GPU pages to CPU addresses, can be read while the CPU maps or unmaps buffers.
+    Common::MultiLevelPageTable page_table;
     VMAMap vma_map;
     VideoCore::RasterizerInterface& rasterizer;
 
@@ -16,6 +16,7 @@
 #include <vector>
 
 #include "common/assert.h"
+#include "common/logging/log.h"
 #include "core/core.h"
 #include "core/settings.h"
 #include "video_core/engines/maxwell_3d.h"
@@ -25,6 +26,14 @@
 
 namespace VideoCommon {
 
+/// Counts how query results have been written back to guest memory.
+struct QueryCacheStats {
+    u64 async_flushes = 0;    ///< Results written back after their fence passed.
+    u64 ready_flushes = 0;    ///< Results that were already available when read.
+    u64 blocking_flushes = 0; ///< Results read that had to wait on the host GPU.
+    u64 stalls_avoided = 0;   ///< Reads that kept the last known value instead of waiting.
+};
+
 template <class QueryCache, class HostCounter>
 class CounterStreamBase {
 public:
@@ -100,6 +109,14 @@ public:
                                                       static_cast<QueryCache&>(*this),
                                                       VideoCore::QueryType::SamplesPassed}}} {}
 
+    ~QueryCacheBase() {
+        LOG_DEBUG(HW_GPU,
+                  "Query results: {} written back asynchronously, {} ready, {} blocking, {} stalls "
+                  "avoided",
+                  stats.async_flushes, stats.ready_flushes, stats.blocking_flushes,
+                  stats.stalls_avoided);
+    }
+
     void InvalidateRegion(VAddr addr, std::size_t size) {
         std::unique_lock lock{mutex};
         FlushAndRemoveRegion(addr, size);
@@ -110,6 +127,13 @@ public:
         FlushAndRemoveRegion(addr, size);
     }
 
+    /// Flushes the queries in a memory range whose results the host GPU has already produced.
+    /// The remaining queries stay cached, leaving their last known value in guest memory.
+    void FlushReadyRegion(VAddr addr, std::size_t size) {
+        std::unique_lock lock{mutex};
+        FlushAndRemoveRegion(addr, size, FlushMode::ReadyOnly);
+    }
+
     /**
      * Records a query in GPU mapped memory, potentially marked with a timestamp.
      * @param gpu_addr  GPU address to flush to when the mapped memory is read.
@@ -117,31 +141,24 @@ public:
      * @param timestamp Timestamp, when empty the flushed query is assumed to be short.
      */
     void Query(GPUVAddr gpu_addr, VideoCore::QueryType type, std::optional<u64> timestamp) {
-        std::unique_lock lock{mutex};
         auto& memory_manager = system.GPU().MemoryManager();
         const std::optional<VAddr> cpu_addr_opt = memory_manager.GpuToCpuAddress(gpu_addr);
-        ASSERT(cpu_addr_opt);
-        VAddr cpu_addr = *cpu_addr_opt;
+        ASSERT_OR_EXECUTE(cpu_addr_opt, return;);
 
-        CachedQuery* query = TryGet(cpu_addr);
-        if (!query) {
-            ASSERT_OR_EXECUTE(cpu_addr_opt, return;);
-            const auto host_ptr = memory_manager.GetPointer(gpu_addr);
-
-            query = Register(type, cpu_addr, host_ptr, timestamp.has_value());
-        }
-
-        query->BindCounter(Stream(type).Current(), timestamp);
-        if (Settings::values.use_asynchronous_gpu_emulation) {
-            AsyncFlushQuery(cpu_addr);
-        }
+        RecordQuery(*cpu_addr_opt, memory_manager.GetPointer(gpu_addr), type, timestamp);
     }
 
     /// Updates counters from GPU state. Expected to be called once per draw, clear or dispatch.
     void UpdateCounters() {
-        std::unique_lock lock{mutex};
         const auto& regs = system.GPU().Maxwell3D().regs;
-        Stream(VideoCore::QueryType::SamplesPassed).Update(regs.samplecnt_enable);
+        auto& stream = Stream(VideoCore::QueryType::SamplesPassed);
+        // Streams are only modified from the GPU thread, so most draws, which leave the stream as
+        // it is, can skip the lock.
+        if (stream.IsEnabled() == (regs.samplecnt_enable != 0)) {
+            return;
+        }
+        std::unique_lock lock{mutex};
+        stream.Update(regs.samplecnt_enable);
     }
 
     /// Resets a counter to zero. It doesn't disable the query after resetting.
@@ -200,18 +217,52 @@ public:
             committed_flushes.pop_front();
             return;
         }
+        std::unique_lock lock{mutex};
         for (VAddr query_address : *flush_list) {
-            FlushAndRemoveRegion(query_address, 4);
+            FlushAndRemoveRegion(query_address, 4, FlushMode::Fence);
         }
         committed_flushes.pop_front();
     }
 
+    /// Returns how query results have been written back so far.
+    QueryCacheStats GetStats() const {
+        std::unique_lock lock{mutex};
+        return stats;
+    }
+
 protected:
+    /**
+     * Records a query at a guest address that has already been translated from GPU memory.
+     * @param cpu_addr  Guest CPU address to flush to when the mapped memory is read.
+     * @param host_ptr  Host pointer backing the guest address, used to write the result.
+     * @param type      Query type, e.g. SamplesPassed.
+     * @param timestamp Timestamp, when empty the flushed query is assumed to be short.
+     */
+    void RecordQuery(VAddr cpu_addr, u8* host_ptr, VideoCore::QueryType type,
+                     std::optional<u64> timestamp) {
+        std::unique_lock lock{mutex};
+        CachedQuery* query = TryGet(cpu_addr);
+        if (!query) {
+            query = Register(type, cpu_addr, host_ptr, timestamp.has_value());
+        }
+
+        query->BindCounter(Stream(type).Current(), timestamp);
+        if (Settings::values.use_asynchronous_gpu_emulation) {
+            AsyncFlushQuery(cpu_addr);
+        }
+    }
+
     std::array<QueryPool, VideoCore::NumQueryTypes> query_pools;
 
 private:
+    enum class FlushMode {
+        Blocking,  ///< Waits on the host GPU for results that are not available yet.
+        ReadyOnly, ///< Keeps queries without an available result cached.
+        Fence,     ///< Flushes queries whose fence has passed.
+    };
+
     /// Flushes a memory range to guest memory and removes it from the cache.
-    void FlushAndRemoveRegion(VAddr addr, std::size_t size) {
+    void FlushAndRemoveRegion(VAddr addr, std::size_t size, FlushMode mode = FlushMode::Blocking) {
         const u64 addr_begin = static_cast<u64>(addr);
         const u64 addr_end = addr_begin + static_cast<u64>(size);
         const auto in_range = [addr_begin, addr_end](CachedQuery& query) {
@@ -227,18 +278,33 @@ private:
                 continue;
             }
             auto& contents = it->second;
-            for (auto& query : contents) {
-                if (!in_range(query)) {
-                    continue;
-                }
-                rasterizer.UpdatePagesCachedCount(query.GetCpuAddr(), query.SizeInBytes(), -1);
-                query.Flush();
-            }
-            contents.erase(std::remove_if(std::begin(contents), std::end(contents), in_range),
+            const auto flush = [this, &in_range, mode](CachedQuery& query) {
+                return in_range(query) && FlushQuery(query, mode);
+            };
+            contents.erase(std::remove_if(std::begin(contents), std::end(contents), flush),
                            std::end(contents));
         }
     }
 
+    /// Flushes a query to guest memory, returns false when it was kept in the cache instead.
+    bool FlushQuery(CachedQuery& query, FlushMode mode) {
+        if (query.TryFlush()) {
+            if (mode == FlushMode::Fence) {
+                ++stats.async_flushes;
+            } else {
+                ++stats.ready_flushes;
+            }
+        } else if (mode == FlushMode::ReadyOnly) {
+            ++stats.stalls_avoided;
+            return false;
+        } else {
+            ++stats.blocking_flushes;
+            query.Flush();
+        }
+        rasterizer.UpdatePagesCachedCount(query.GetCpuAddr(), query.SizeInBytes(), -1);
+        return true;
+    }
+
     /// Registers the passed parameters as cached and returns a pointer to the stored cached query.
     CachedQuery* Register(VideoCore::QueryType type, VAddr cpu_addr, u8* host_ptr, bool timestamp) {
         rasterizer.UpdatePagesCachedCount(cpu_addr, CachedQuery::SizeInBytes(timestamp), 1);
@@ -273,7 +339,7 @@ private:
     Core::System& system;
     VideoCore::RasterizerInterface& rasterizer;
 
-    std::recursive_mutex mutex;
+    mutable std::recursive_mutex mutex;
 
     std::unordered_map<u64, std::vector<CachedQuery>> cached_queries;
 
@@ -281,6 +347,8 @@ private:
 
     std::shared_ptr<std::unordered_set<VAddr>> uncommitted_flushes{};
     std::list<std::shared_ptr<std::unordered_set<VAddr>>> committed_flushes;
+
+    QueryCacheStats stats;
 };
 
 template <class QueryCache, class HostCounter>
@@ -314,6 +382,28 @@ public:
         return *result;
     }
 
+    /// Returns the value of the query when the host GPU has already produced it, without blocking.
+    std::optional<u64> TryQuery() {
+        if (result) {
+            return *result;
+        }
+        const std::optional<u64> value = PollQuery();
+        if (!value) {
+            return std::nullopt;
+        }
+        u64 total = *value + base_result;
+        if (dependency) {
+            const std::optional<u64> dependency_value = dependency->TryQuery();
+            if (!dependency_value) {
+                return std::nullopt;
+            }
+            total += *dependency_value;
+            dependency = nullptr;
+        }
+        result = total;
+        return *result;
+    }
+
     /// Returns true when flushing this query will potentially wait.
     bool WaitPending() const noexcept {
         return result.has_value();
@@ -327,6 +417,9 @@ protected:
     /// Returns the value of query from the backend API blocking as needed.
     virtual u64 BlockingQuery() const = 0;
 
+    /// Returns the value of query from the backend API if it's available, without blocking.
+    virtual std::optional<u64> PollQuery() const = 0;
+
 private:
     std::shared_ptr<HostCounter> dependency; ///< Counter to add to this value.
     std::optional<u64> result;               ///< Filled with the already returned value.
@@ -351,12 +444,18 @@ public:
     virtual void Flush() {
         // When counter is nullptr it means that it's just been reseted. We are supposed to write a
         // zero in these cases.
-        const u64 value = counter ? counter->Query() : 0;
-        std::memcpy(host_ptr, &value, sizeof(u64));
+        Write(counter ? counter->Query() : 0);
+    }
 
-        if (timestamp) {
-            std::memcpy(host_ptr + TIMESTAMP_OFFSET, &*timestamp, sizeof(u64));
+    /// Flushes the query to guest memory if its result is available without blocking.
+    /// Returns false and leaves guest memory untouched otherwise.
+    bool TryFlush() {
+        const std::optional<u64> value = counter ? counter->TryQuery() : u64{0};
+        if (!value) {
+            return false;
         }
+        Write(*value);
+        return true;
     }
 
     /// Binds a counter to this query.
@@ -389,6 +488,15 @@ protected:
     }
 
 private:
+    /// Writes the result, and the timestamp if any, to guest memory.
+    void Write(u64 value) {
+        std::memcpy(host_ptr, &value, sizeof(u64));
+
+        if (timestamp) {
+            std::memcpy(host_ptr + TIMESTAMP_OFFSET, &*timestamp, sizeof(u64));
+        }
+    }
+
     static constexpr std::size_t SMALL_QUERY_SIZE = 8;   // Query size without timestamp.
     static constexpr std::size_t LARGE_QUERY_SIZE = 16;  // Query size with timestamp.
     static constexpr std::intptr_t TIMESTAMP_OFFSET = 8; // Timestamp offset in a large query.
@@ -64,6 +64,10 @@ public:
     /// Notify rasterizer that any caches of the specified region should be flushed to Switch memory
     virtual void FlushRegion(VAddr addr, u64 size) = 0;
 
+    /// Flush the queries of the specified region whose results are available without waiting on
+    /// the host GPU, the remaining ones keep their last known value in Switch memory
+    virtual void FlushReadyQueries(VAddr addr, u64 size) {}
+
     /// Check if the the specified memory area requires flushing to CPU Memory.
     virtual bool MustFlushRegion(VAddr addr, u64 size) = 0;
 
@@ -73,6 +77,12 @@ public:
     /// Notify rasterizer that any caches of the specified region are desync with guest
     virtual void OnCPUWrite(VAddr addr, u64 size) = 0;
 
+    /// Notify rasterizer that the GPU command stream wrote the given data to the specified region,
+    /// cached buffers may update the written bytes in place instead of being invalidated
+    virtual void UpdateRegion(VAddr addr, const u8* data, u64 size) {
+        InvalidateRegion(addr, size);
+    }
+
     /// Sync memory between guest and host.
     virtual void SyncGuestHost() = 0;
 
@@ -96,6 +106,12 @@ public:
         return false;
     }
 
+    /// Attempt to perform a linear buffer copy requested by the DMA engine without going through
+    /// guest memory
+    virtual bool AccelerateDMABufferCopy(GPUVAddr src_addr, GPUVAddr dst_addr, u64 size) {
+        return false;
+    }
+
     /// Attempt to use a faster method to display the framebuffer to screen
     virtual bool AccelerateDisplay(const Tegra::FramebufferConfig& config, VAddr framebuffer_addr,
                                    u32 pixel_stride) {
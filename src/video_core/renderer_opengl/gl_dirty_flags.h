@@ -0,0 +1,178 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <limits>
+
+#include "common/common_types.h"
+#include "video_core/dirty_flags.h"
+
+namespace OpenGL {
+
+namespace Dirty {
+
+enum : u8 {
+    First = VideoCommon::Dirty::LastCommonEntry,
+
+    VertexFormats,
+    VertexFormat0,
+    VertexFormat31 = VertexFormat0 + 31,
+
+    VertexBuffers,
+    VertexBuffer0,
+    VertexBuffer31 = VertexBuffer0 + 31,
+
+    VertexInstances,
+    VertexInstance0,
+    VertexInstance31 = VertexInstance0 + 31,
+
+    ViewportTransform,
+    Viewports,
+    Viewport0,
+    Viewport15 = Viewport0 + 15,
+
+    Scissors,
+    Scissor0,
+    Scissor15 = Scissor0 + 15,
+
+    ColorMaskCommon,
+    ColorMasks,
+    ColorMask0,
+    ColorMask7 = ColorMask0 + 7,
+
+    BlendColor,
+    BlendIndependentEnabled,
+    BlendStates,
+    BlendState0,
+    BlendState7 = BlendState0 + 7,
+
+    Shaders,
+    ClipDistances,
+
+    PolygonModes,
+    PolygonModeFront,
+    PolygonModeBack,
+
+    ColorMask,
+    FrontFace,
+    CullTest,
+    DepthMask,
+    DepthTest,
+    StencilTest,
+    AlphaTest,
+    PrimitiveRestart,
+    PolygonOffset,
+    MultisampleControl,
+    RasterizeEnable,
+    FramebufferSRGB,
+    LogicOp,
+    FragmentClampColor,
+    PointSize,
+    LineWidth,
+    ClipControl,
+    DepthClampEnabled,
+
+    Last
+};
+static_assert(Last <= std::numeric_limits<u8>::max());
+
+using VideoCommon::Dirty::Bind;
+using VideoCommon::Dirty::BindGroup;
+using VideoCommon::Dirty::BindIndexed;
+using VideoCommon::Dirty::Range;
+
+/// Maxwell3D register ranges that set each of the flags above, on top of the common ones.
+constexpr std::array Bindings{
+    Bind(Range::ColorMaskCommon, ColorMaskCommon),
+    BindIndexed(Range::ColorMask, ColorMask0, ColorMasks),
+
+    BindIndexed(Range::ViewportTransform, Viewport0, Viewports),
+    BindIndexed(Range::Viewport, Viewport0, Viewports),
+    Bind(Range::ViewportTransformEnabled, ViewportTransform, Viewports),
+    BindIndexed(Range::ScissorTest, Scissor0, Scissors),
+
+    BindIndexed(Range::VertexArray, VertexBuffer0, VertexBuffers),
+    BindIndexed(Range::VertexArrayLimit, VertexBuffer0, VertexBuffers),
+    BindIndexed(Range::VertexArrayDivisor, VertexInstance0, VertexInstances),
+    BindIndexed(Range::InstancedArray, VertexInstance0, VertexInstances),
+    BindIndexed(Range::VertexAttribFormat, VertexFormat0, VertexFormats),
+
+    Bind(Range::ShaderConfig, Shaders),
+
+    Bind(Range::PolygonModeFront, PolygonModeFront, PolygonModes),
+    Bind(Range::PolygonModeBack, PolygonModeBack, PolygonModes),
+    Bind(Range::FillRectangle, PolygonModes),
+
+    Bind(Range::DepthTestEnable, DepthTest),
+    Bind(Range::DepthWriteEnabled, DepthMask),
+    Bind(Range::DepthTestFunc, DepthTest),
+
+    Bind(Range::StencilEnable, StencilTest),
+    Bind(Range::StencilFrontFuncFunc, StencilTest),
+    Bind(Range::StencilFrontFuncRef, StencilTest),
+    Bind(Range::StencilFrontFuncMask, StencilTest),
+    Bind(Range::StencilFrontOpFail, StencilTest),
+    Bind(Range::StencilFrontOpZFail, StencilTest),
+    Bind(Range::StencilFrontOpZPass, StencilTest),
+    Bind(Range::StencilFrontMask, StencilTest),
+    Bind(Range::StencilTwoSideEnable, StencilTest),
+    Bind(Range::StencilBackFuncFunc, StencilTest),
+    Bind(Range::StencilBackFuncRef, StencilTest),
+    Bind(Range::StencilBackFuncMask, StencilTest),
+    Bind(Range::StencilBackOpFail, StencilTest),
+    Bind(Range::StencilBackOpZFail, StencilTest),
+    Bind(Range::StencilBackOpZPass, StencilTest),
+    Bind(Range::StencilBackMask, StencilTest),
+
+    Bind(Range::AlphaTestRef, AlphaTest),
+    Bind(Range::AlphaTestFunc, AlphaTest),
+    Bind(Range::AlphaTestEnabled, AlphaTest),
+
+    Bind(Range::BlendColor, BlendColor),
+    Bind(Range::IndependentBlendEnable, BlendIndependentEnabled),
+    BindIndexed(Range::IndependentBlend, BlendState0, BlendStates),
+    BindGroup(Range::Blend, BlendStates),
+    BindIndexed(Range::BlendEnable, BlendState0),
+
+    Bind(Range::PrimitiveRestart, PrimitiveRestart),
+
+    Bind(Range::PolygonOffsetFillEnable, PolygonOffset),
+    Bind(Range::PolygonOffsetLineEnable, PolygonOffset),
+    Bind(Range::PolygonOffsetPointEnable, PolygonOffset),
+    Bind(Range::PolygonOffsetFactor, PolygonOffset),
+    Bind(Range::PolygonOffsetUnits, PolygonOffset),
+    Bind(Range::PolygonOffsetClamp, PolygonOffset),
+
+    Bind(Range::MultisampleControl, MultisampleControl),
+    Bind(Range::RasterizeEnable, RasterizeEnable),
+    Bind(Range::FramebufferSRGB, FramebufferSRGB),
+    Bind(Range::LogicOp, LogicOp),
+    Bind(Range::FragColorClamp, FragmentClampColor),
+
+    Bind(Range::VpPointSize, PointSize),
+    Bind(Range::PointSize, PointSize),
+    Bind(Range::PointSpriteEnable, PointSize),
+
+    Bind(Range::LineWidthSmooth, LineWidth),
+    Bind(Range::LineWidthAliased, LineWidth),
+    Bind(Range::LineSmoothEnable, LineWidth),
+
+    Bind(Range::ScreenYControl, ClipControl),
+    Bind(Range::DepthMode, ClipControl),
+    Bind(Range::ViewVolumeClipControl, DepthClampEnabled),
+
+    Bind(Range::ClipDistanceEnabled, ClipDistances),
+    Bind(Range::FrontFace, FrontFace),
+    Bind(Range::CullTestEnabled, CullTest),
+    Bind(Range::CullFace, CullTest),
+};
+
+/// Gets the compile time generated table mapping Maxwell3D registers to the flags above.
+const VideoCommon::Dirty::Table& GetTable();
+
+} // namespace Dirty
+
+} // namespace OpenGL
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -87,6 +88,15 @@ u64 HostCounter::BlockingQuery() const {
     return static_cast<u64>(value);
 }
 
+std::optional<u64> HostCounter::PollQuery() const {
+    GLint available;
+    glGetQueryObjectiv(query.handle, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == GL_FALSE) {
+        return std::nullopt;
+    }
+    return BlockingQuery();
+}
+
 CachedQuery::CachedQuery(QueryCache& cache, VideoCore::QueryType type, VAddr cpu_addr, u8* host_ptr)
     : VideoCommon::CachedQueryBase<HostCounter>{cpu_addr, host_ptr}, cache{&cache}, type{type} {}
 
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <memory>
+#include <optional>
 #include <vector>
 
 #include "common/common_types.h"
@@ -53,6 +54,8 @@ public:
 private:
     u64 BlockingQuery() const override;
 
+    std::optional<u64> PollQuery() const override;
+
     QueryCache& cache;
     const VideoCore::QueryType type;
     OGLQuery query;
@@ -736,6 +736,14 @@ void RasterizerOpenGL::FlushRegion(VAddr addr, u64 size) {
     query_cache.FlushRegion(addr, size);
 }
 
+void RasterizerOpenGL::FlushReadyQueries(VAddr addr, u64 size) {
+    MICROPROFILE_SCOPE(OpenGL_CacheManagement);
+    if (addr == 0 || size == 0) {
+        return;
+    }
+    query_cache.FlushReadyRegion(addr, size);
+}
+
 bool RasterizerOpenGL::MustFlushRegion(VAddr addr, u64 size) {
     if (!Settings::IsGPULevelHigh()) {
         return buffer_cache.MustFlushRegion(addr, size);
@@ -754,6 +762,17 @@ void RasterizerOpenGL::InvalidateRegion(VAddr addr, u64 size) {
     query_cache.InvalidateRegion(addr, size);
 }
 
+void RasterizerOpenGL::UpdateRegion(VAddr addr, const u8* data, u64 size) {
+    MICROPROFILE_SCOPE(OpenGL_CacheManagement);
+    if (addr == 0 || size == 0) {
+        return;
+    }
+    texture_cache.InvalidateRegion(addr, size);
+    shader_cache.InvalidateRegion(addr, size);
+    buffer_cache.UpdateRegion(addr, data, size);
+    query_cache.InvalidateRegion(addr, size);
+}
+
 void RasterizerOpenGL::OnCPUWrite(VAddr addr, u64 size) {
     MICROPROFILE_SCOPE(OpenGL_CacheManagement);
     if (addr == 0 || size == 0) {
@@ -840,6 +859,20 @@ bool RasterizerOpenGL::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Regs
     return true;
 }
 
+bool RasterizerOpenGL::AccelerateDMABufferCopy(GPUVAddr src_addr, GPUVAddr dst_addr, u64 size) {
+    MICROPROFILE_SCOPE(OpenGL_Blits);
+    if (!buffer_cache.DMACopy(src_addr, dst_addr, size)) {
+        return false;
+    }
+    // Only the buffer cache holds the new contents, the other caches have to reload them
+    if (const auto dst_cpu_addr = system.GPU().MemoryManager().GpuToCpuAddress(dst_addr)) {
+        texture_cache.InvalidateRegion(*dst_cpu_addr, size);
+        shader_cache.InvalidateRegion(*dst_cpu_addr, size);
+        query_cache.InvalidateRegion(*dst_cpu_addr, size);
+    }
+    return true;
+}
+
 bool RasterizerOpenGL::AccelerateDisplay(const Tegra::FramebufferConfig& config,
                                          VAddr framebuffer_addr, u32 pixel_stride) {
     if (!framebuffer_addr) {
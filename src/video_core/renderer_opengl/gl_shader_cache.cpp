@@ -4,6 +4,7 @@
 
 #include <atomic>
 #include <functional>
+#include <future>
 #include <mutex>
 #include <optional>
 #include <string>
@@ -14,11 +15,13 @@
 #include "common/assert.h"
 #include "common/logging/log.h"
 #include "common/scope_exit.h"
+#include "common/thread_pool.h"
 #include "core/core.h"
 #include "core/frontend/emu_window.h"
 #include "video_core/engines/kepler_compute.h"
 #include "video_core/engines/maxwell_3d.h"
 #include "video_core/engines/shader_type.h"
+#include "video_core/gpu.h"
 #include "video_core/memory_manager.h"
 #include "video_core/renderer_opengl/gl_rasterizer.h"
 #include "video_core/renderer_opengl/gl_shader_cache.h"
@@ -316,11 +319,12 @@ void ShaderCacheOpenGL::LoadDiskCache(const std::atomic_bool& stop_loading,
                             [id](const auto& entry) { return entry.unique_identifier == id; });
     };
 
-    const auto worker = [&](Core::Frontend::GraphicsContext* context, std::size_t begin,
-                            std::size_t end) {
+    std::atomic_size_t next_entry = 0;
+    const auto worker = [&](Core::Frontend::GraphicsContext* context) {
         const auto scope = context->Acquire();
 
-        for (std::size_t i = begin; i < end; ++i) {
+        // Entries are taken one at a time, so expensive shaders don't stall a whole bucket
+        for (std::size_t i = next_entry++; i < transferable->size(); i = next_entry++) {
             if (stop_loading) {
                 return;
             }
@@ -361,21 +365,20 @@ void ShaderCacheOpenGL::LoadDiskCache(const std::atomic_bool& stop_loading,
         }
     };
 
-    const auto num_workers{static_cast<std::size_t>(std::thread::hardware_concurrency() + 1ULL)};
-    const std::size_t bucket_size{transferable->size() / num_workers};
-    std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> contexts(num_workers);
-    std::vector<std::thread> threads(num_workers);
-    for (std::size_t i = 0; i < num_workers; ++i) {
-        const bool is_last_worker = i + 1 == num_workers;
-        const std::size_t start{bucket_size * i};
-        const std::size_t end{is_last_worker ? transferable->size() : start + bucket_size};
-
+    // The emulated CPU and the GPU thread don't run yet while the disk cache is loaded, so use
+    // every host thread instead of the shared worker pool, which leaves threads to them.
+    Common::ThreadPool worker_pool{"ShaderLoader", std::thread::hardware_concurrency()};
+    const std::size_t num_tasks{std::min(worker_pool.NumWorkers(), transferable->size())};
+    std::vector<std::unique_ptr<Core::Frontend::GraphicsContext>> contexts(num_tasks);
+    std::vector<std::future<void>> tasks(num_tasks);
+    for (std::size_t i = 0; i < num_tasks; ++i) {
         // On some platforms the shared context has to be created from the GUI thread
         contexts[i] = emu_window.CreateSharedContext();
-        threads[i] = std::thread(worker, contexts[i].get(), start, end);
+        tasks[i] = worker_pool.Async([&worker, context = contexts[i].get()] { worker(context); },
+                                     Common::TaskPriority::High);
     }
-    for (auto& thread : threads) {
-        thread.join();
+    for (auto& task : tasks) {
+        task.wait();
     }
 
     if (gl_cache_failed) {
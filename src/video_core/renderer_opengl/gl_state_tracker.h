@@ -4,14 +4,13 @@
 
 #pragma once
 
-#include <limits>
-
 #include <glad/glad.h>
 
 #include "common/common_types.h"
 #include "core/core.h"
 #include "video_core/dirty_flags.h"
 #include "video_core/engines/maxwell_3d.h"
+#include "video_core/renderer_opengl/gl_dirty_flags.h"
 
 namespace Core {
 class System;
@@ -19,75 +18,6 @@ class System;
 
 namespace OpenGL {
 
-namespace Dirty {
-
-enum : u8 {
-    First = VideoCommon::Dirty::LastCommonEntry,
-
-    VertexFormats,
-    VertexFormat0,
-    VertexFormat31 = VertexFormat0 + 31,
-
-    VertexBuffers,
-    VertexBuffer0,
-    VertexBuffer31 = VertexBuffer0 + 31,
-
-    VertexInstances,
-    VertexInstance0,
-    VertexInstance31 = VertexInstance0 + 31,
-
-    ViewportTransform,
-    Viewports,
-    Viewport0,
-    Viewport15 = Viewport0 + 15,
-
-    Scissors,
-    Scissor0,
-    Scissor15 = Scissor0 + 15,
-
-    ColorMaskCommon,
-    ColorMasks,
-    ColorMask0,
-    ColorMask7 = ColorMask0 + 7,
-
-    BlendColor,
-    BlendIndependentEnabled,
-    BlendStates,
-    BlendState0,
-    BlendState7 = BlendState0 + 7,
-
-    Shaders,
-    ClipDistances,
-
-    PolygonModes,
-    PolygonModeFront,
-    PolygonModeBack,
-
-    ColorMask,
-    FrontFace,
-    CullTest,
-    DepthMask,
-    DepthTest,
-    StencilTest,
-    AlphaTest,
-    PrimitiveRestart,
-    PolygonOffset,
-    MultisampleControl,
-    RasterizeEnable,
-    FramebufferSRGB,
-    LogicOp,
-    FragmentClampColor,
-    PointSize,
-    LineWidth,
-    ClipControl,
-    DepthClampEnabled,
-
-    Last
-};
-static_assert(Last <= std::numeric_limits<u8>::max());
-
-} // namespace Dirty
-
 class StateTracker {
 public:
     explicit StateTracker(Core::System& system);
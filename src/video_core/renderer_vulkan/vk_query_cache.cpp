@@ -4,6 +4,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <optional>
 #include <utility>
 #include <vector>
 
@@ -127,4 +128,25 @@ u64 HostCounter::BlockingQuery() const {
     }
 }
 
+std::optional<u64> HostCounter::PollQuery() const {
+    if (ticks >= cache.Scheduler().Ticks()) {
+        // The query hasn't been submitted yet, it can't be available.
+        return std::nullopt;
+    }
+    u64 data;
+    const VkResult result = cache.Device().GetLogical().GetQueryResults(
+        query.first, query.second, 1, sizeof(data), &data, sizeof(data), VK_QUERY_RESULT_64_BIT);
+    switch (result) {
+    case VK_SUCCESS:
+        return data;
+    case VK_NOT_READY:
+        return std::nullopt;
+    case VK_ERROR_DEVICE_LOST:
+        cache.Device().ReportLoss();
+        [[fallthrough]];
+    default:
+        throw vk::Exception(result);
+    }
+}
+
 } // namespace Vulkan
@@ -511,6 +511,13 @@ void RasterizerVulkan::FlushRegion(VAddr addr, u64 size) {
     query_cache.FlushRegion(addr, size);
 }
 
+void RasterizerVulkan::FlushReadyQueries(VAddr addr, u64 size) {
+    if (addr == 0 || size == 0) {
+        return;
+    }
+    query_cache.FlushReadyRegion(addr, size);
+}
+
 bool RasterizerVulkan::MustFlushRegion(VAddr addr, u64 size) {
     if (!Settings::IsGPULevelHigh()) {
         return buffer_cache.MustFlushRegion(addr, size);
@@ -528,6 +535,16 @@ void RasterizerVulkan::InvalidateRegion(VAddr addr, u64 size) {
     query_cache.InvalidateRegion(addr, size);
 }
 
+void RasterizerVulkan::UpdateRegion(VAddr addr, const u8* data, u64 size) {
+    if (addr == 0 || size == 0) {
+        return;
+    }
+    texture_cache.InvalidateRegion(addr, size);
+    pipeline_cache.InvalidateRegion(addr, size);
+    buffer_cache.UpdateRegion(addr, data, size);
+    query_cache.InvalidateRegion(addr, size);
+}
+
 void RasterizerVulkan::OnCPUWrite(VAddr addr, u64 size) {
     if (addr == 0 || size == 0) {
         return;
@@ -617,6 +634,19 @@ bool RasterizerVulkan::AccelerateSurfaceCopy(const Tegra::Engines::Fermi2D::Regs
     return true;
 }
 
+bool RasterizerVulkan::AccelerateDMABufferCopy(GPUVAddr src_addr, GPUVAddr dst_addr, u64 size) {
+    if (!buffer_cache.DMACopy(src_addr, dst_addr, size)) {
+        return false;
+    }
+    // Only the buffer cache holds the new contents, the other caches have to reload them
+    if (const auto dst_cpu_addr = system.GPU().MemoryManager().GpuToCpuAddress(dst_addr)) {
+        texture_cache.InvalidateRegion(*dst_cpu_addr, size);
+        pipeline_cache.InvalidateRegion(*dst_cpu_addr, size);
+        query_cache.InvalidateRegion(*dst_cpu_addr, size);
+    }
+    return true;
+}
+
 bool RasterizerVulkan::AccelerateDisplay(const Tegra::FramebufferConfig& config,
                                          VAddr framebuffer_addr, u32 pixel_stride) {
     if (!framebuffer_addr) {
@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <limits>
 
@@ -30,6 +31,35 @@ enum : u8 {
 };
 static_assert(Last <= std::numeric_limits<u8>::max());
 
+using VideoCommon::Dirty::Bind;
+using VideoCommon::Dirty::Range;
+
+/// Maxwell3D register ranges that set each of the flags above, on top of the common ones.
+constexpr std::array Bindings{
+    Bind(Range::ViewportTransform, Viewports),
+    Bind(Range::Viewport, Viewports),
+    Bind(Range::ViewportTransformEnabled, Viewports),
+    Bind(Range::ScissorTest, Scissors),
+
+    Bind(Range::PolygonOffsetUnits, DepthBias),
+    Bind(Range::PolygonOffsetClamp, DepthBias),
+    Bind(Range::PolygonOffsetFactor, DepthBias),
+
+    Bind(Range::BlendColor, BlendConstants),
+    Bind(Range::DepthBounds, DepthBounds),
+
+    Bind(Range::StencilTwoSideEnable, StencilProperties),
+    Bind(Range::StencilFrontFuncRef, StencilProperties),
+    Bind(Range::StencilFrontMask, StencilProperties),
+    Bind(Range::StencilFrontFuncMask, StencilProperties),
+    Bind(Range::StencilBackFuncRef, StencilProperties),
+    Bind(Range::StencilBackMask, StencilProperties),
+    Bind(Range::StencilBackFuncMask, StencilProperties),
+};
+
+/// Gets the compile time generated table mapping Maxwell3D registers to the flags above.
+const VideoCommon::Dirty::Table& GetTable();
+
 } // namespace Dirty
 
 class StateTracker {
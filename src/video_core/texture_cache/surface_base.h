@@ -60,7 +60,8 @@ private:
 
 class SurfaceBaseImpl {
 public:
-    void LoadBuffer(Tegra::MemoryManager& memory_manager, StagingCache& staging_cache);
+    void LoadBuffer(Tegra::MemoryManager& memory_manager, StagingCache& staging_cache,
+                    Common::ThreadPool& worker_pool);
 
     void FlushBuffer(Tegra::MemoryManager& memory_manager, StagingCache& staging_cache);
 
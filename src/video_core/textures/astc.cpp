@@ -23,6 +23,7 @@
 #include <boost/container/static_vector.hpp>
 
 #include "common/common_types.h"
+#include "common/thread_pool.h"
 
 #include "video_core/textures/astc.h"
 
@@ -1673,16 +1674,27 @@ static void DecompressBlock(const u8 inBuf[16], const u32 blockWidth, const u32
 namespace Tegra::Texture::ASTC {
 
 std::vector<u8> Decompress(const u8* data, u32 width, u32 height, u32 depth, u32 block_width,
-                           u32 block_height) {
-    u32 blockIdx = 0;
-    std::size_t depth_offset = 0;
-    std::vector<u8> outData(height * width * depth * 4);
-    for (u32 k = 0; k < depth; k++) {
-        for (u32 j = 0; j < height; j += block_height) {
-            for (u32 i = 0; i < width; i += block_width) {
-
-                const u8* blockPtr = data + blockIdx * 16;
+                           u32 block_height, Common::ThreadPool& worker_pool) {
+    // Rows of blocks decode independently, each task takes enough of them to amortize its cost
+    constexpr std::size_t MinBlocksPerTask = 256;
+
+    const std::size_t layer_size = std::size_t{width} * height * 4;
+    std::vector<u8> outData(layer_size * depth);
+    if (outData.empty()) {
+        return outData;
+    }
+    const u32 blocksPerRow = (width + block_width - 1) / block_width;
+    const u32 blockRowsPerLayer = (height + block_height - 1) / block_height;
+    const std::size_t rowsPerTask = std::max<std::size_t>(1, MinBlocksPerTask / blocksPerRow);
+
+    const auto decompress_rows = [&](std::size_t begin, std::size_t end) {
+        for (std::size_t row = begin; row < end; ++row) {
+            const std::size_t k = row / blockRowsPerLayer;
+            const u32 j = static_cast<u32>(row % blockRowsPerLayer) * block_height;
+            const u8* blockPtr = data + row * blocksPerRow * 16;
+            u8* const layerData = outData.data() + k * layer_size;
 
+            for (u32 i = 0; i < width; i += block_width) {
                 // Blocks can be at most 12x12
                 u32 uncompData[144];
                 ASTCC::DecompressBlock(blockPtr, block_width, block_height, uncompData);
@@ -1690,16 +1702,16 @@ std::vector<u8> Decompress(const u8* data, u32 width, u32 height, u32 depth, u32
                 u32 decompWidth = std::min(block_width, width - i);
                 u32 decompHeight = std::min(block_height, height - j);
 
-                u8* outRow = depth_offset + outData.data() + (j * width + i) * 4;
+                u8* outRow = layerData + (j * width + i) * 4;
                 for (u32 jj = 0; jj < decompHeight; jj++) {
                     memcpy(outRow + jj * width * 4, uncompData + jj * block_width, decompWidth * 4);
                 }
 
-                blockIdx++;
+                blockPtr += 16;
             }
         }
-        depth_offset += height * width * 4;
-    }
+    };
+    worker_pool.ParallelFor(std::size_t{blockRowsPerLayer} * depth, rowsPerTask, decompress_rows);
 
     return outData;
 }
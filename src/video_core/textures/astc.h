@@ -7,9 +7,15 @@
 #include <cstdint>
 #include <vector>
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace Tegra::Texture::ASTC {
 
+/// Decompresses an ASTC texture to RGBA8, splitting the blocks across the given worker pool.
 std::vector<uint8_t> Decompress(const uint8_t* data, uint32_t width, uint32_t height,
-                                uint32_t depth, uint32_t block_width, uint32_t block_height);
+                                uint32_t depth, uint32_t block_width, uint32_t block_height,
+                                Common::ThreadPool& worker_pool);
 
 } // namespace Tegra::Texture::ASTC
@@ -6,6 +6,10 @@
 
 #include "common/common_types.h"
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace VideoCore::Surface {
 enum class PixelFormat;
 }
@@ -14,7 +18,7 @@ namespace Tegra::Texture {
 
 void ConvertFromGuestToHost(u8* in_data, u8* out_data, VideoCore::Surface::PixelFormat pixel_format,
                             u32 width, u32 height, u32 depth, bool convert_astc,
-                            bool convert_s8z24);
+                            bool convert_s8z24, Common::ThreadPool& worker_pool);
 
 void ConvertFromHostToGuest(u8* data, VideoCore::Surface::PixelFormat pixel_format, u32 width,
                             u32 height, u32 depth, bool convert_astc, bool convert_s8z24);
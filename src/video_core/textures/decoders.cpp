@@ -264,21 +264,30 @@ void SwizzleSubrect(u32 subrect_width, u32 subrect_height, u32 source_pitch, u32
     const u32 block_height = 1U << block_height_bit;
     const u32 image_width_in_gobs{(swizzled_width * bytes_per_pixel + (gob_size_x - 1)) /
                                   gob_size_x};
+    const u32 line_size = subrect_width * bytes_per_pixel;
+    const u32 offset_xb = offset_x * bytes_per_pixel;
+    // Like the fast swizzler, copy in aligned chunks of 16 bytes when possible, as those are
+    // contiguous in both layouts.
+    const bool fast = offset_xb % fast_swizzle_align == 0 && line_size % fast_swizzle_align == 0;
+    const u32 copy_size = fast ? fast_swizzle_align : bytes_per_pixel;
     for (u32 line = 0; line < subrect_height; ++line) {
         const u32 dst_y = line + offset_y;
         const u32 gob_address_y =
             (dst_y / (gob_size_y * block_height)) * gob_size * block_height * image_width_in_gobs +
             ((dst_y % (gob_size_y * block_height)) / gob_size_y) * gob_size;
         const auto& table = legacy_swizzle_table[dst_y % gob_size_y];
-        for (u32 x = 0; x < subrect_width; ++x) {
-            const u32 dst_x = x + offset_x;
-            const u32 gob_address =
-                gob_address_y + (dst_x * bytes_per_pixel / gob_size_x) * gob_size * block_height;
-            const u32 swizzled_offset = gob_address + table[(dst_x * bytes_per_pixel) % gob_size_x];
-            u8* source_line = unswizzled_data + line * source_pitch + x * bytes_per_pixel;
+        for (u32 xb = 0; xb < line_size; xb += copy_size) {
+            const u32 dst_xb = offset_xb + xb;
+            const u32 gob_address = gob_address_y + (dst_xb / gob_size_x) * gob_size * block_height;
+            const u32 swizzled_offset = gob_address + table[dst_xb % gob_size_x];
+            u8* source_line = unswizzled_data + line * source_pitch + xb;
             u8* dest_addr = swizzled_data + swizzled_offset;
 
-            std::memcpy(dest_addr, source_line, bytes_per_pixel);
+            if (fast) {
+                std::memcpy(dest_addr, source_line, fast_swizzle_align);
+            } else {
+                std::memcpy(dest_addr, source_line, bytes_per_pixel);
+            }
         }
     }
 }
@@ -287,19 +296,27 @@ void UnswizzleSubrect(u32 subrect_width, u32 subrect_height, u32 dest_pitch, u32
                       u32 bytes_per_pixel, u8* swizzled_data, u8* unswizzled_data,
                       u32 block_height_bit, u32 offset_x, u32 offset_y) {
     const u32 block_height = 1U << block_height_bit;
+    const u32 line_size = subrect_width * bytes_per_pixel;
+    const u32 offset_xb = offset_x * bytes_per_pixel;
+    const bool fast = offset_xb % fast_swizzle_align == 0 && line_size % fast_swizzle_align == 0;
+    const u32 copy_size = fast ? fast_swizzle_align : bytes_per_pixel;
     for (u32 line = 0; line < subrect_height; ++line) {
         const u32 y2 = line + offset_y;
         const u32 gob_address_y = (y2 / (gob_size_y * block_height)) * gob_size * block_height +
                                   ((y2 % (gob_size_y * block_height)) / gob_size_y) * gob_size;
         const auto& table = legacy_swizzle_table[y2 % gob_size_y];
-        for (u32 x = 0; x < subrect_width; ++x) {
-            const u32 x2 = (x + offset_x) * bytes_per_pixel;
+        for (u32 xb = 0; xb < line_size; xb += copy_size) {
+            const u32 x2 = offset_xb + xb;
             const u32 gob_address = gob_address_y + (x2 / gob_size_x) * gob_size * block_height;
             const u32 swizzled_offset = gob_address + table[x2 % gob_size_x];
-            u8* dest_line = unswizzled_data + line * dest_pitch + x * bytes_per_pixel;
+            u8* dest_line = unswizzled_data + line * dest_pitch + xb;
             u8* source_addr = swizzled_data + swizzled_offset;
 
-            std::memcpy(dest_line, source_addr, bytes_per_pixel);
+            if (fast) {
+                std::memcpy(dest_line, source_addr, fast_swizzle_align);
+            } else {
+                std::memcpy(dest_line, source_addr, bytes_per_pixel);
+            }
         }
     }
 }
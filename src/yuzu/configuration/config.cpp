@@ -649,6 +649,10 @@ void Config::ReadRendererValues() {
         ReadSetting(QStringLiteral("use_assembly_shaders"), false).toBool();
     Settings::values.use_fast_gpu_time =
         ReadSetting(QStringLiteral("use_fast_gpu_time"), true).toBool();
+    Settings::values.use_fast_conditional_rendering =
+        ReadSetting(QStringLiteral("use_fast_conditional_rendering"), false).toBool();
+    Settings::values.video_worker_threads =
+        ReadSetting(QStringLiteral("video_worker_threads"), 0).toInt();
     Settings::values.force_30fps_mode =
         ReadSetting(QStringLiteral("force_30fps_mode"), false).toBool();
 
@@ -1098,6 +1102,10 @@ void Config::SaveRendererValues() {
     WriteSetting(QStringLiteral("use_assembly_shaders"), Settings::values.use_assembly_shaders,
                  false);
     WriteSetting(QStringLiteral("use_fast_gpu_time"), Settings::values.use_fast_gpu_time, true);
+    WriteSetting(QStringLiteral("use_fast_conditional_rendering"),
+                 Settings::values.use_fast_conditional_rendering, false);
+    WriteSetting(QStringLiteral("video_worker_threads"), Settings::values.video_worker_threads,
+                 0);
     WriteSetting(QStringLiteral("force_30fps_mode"), Settings::values.force_30fps_mode, false);
 
     // Cast to double because Qt's written float values are not human-readable
@@ -28,6 +28,8 @@ void ConfigureGraphicsAdvanced::SetConfiguration() {
     ui->use_assembly_shaders->setEnabled(runtime_lock);
     ui->use_assembly_shaders->setChecked(Settings::values.use_assembly_shaders);
     ui->use_fast_gpu_time->setChecked(Settings::values.use_fast_gpu_time);
+    ui->use_fast_conditional_rendering->setChecked(
+        Settings::values.use_fast_conditional_rendering);
     ui->force_30fps_mode->setEnabled(runtime_lock);
     ui->force_30fps_mode->setChecked(Settings::values.force_30fps_mode);
     ui->anisotropic_filtering_combobox->setEnabled(runtime_lock);
@@ -40,6 +42,8 @@ void ConfigureGraphicsAdvanced::ApplyConfiguration() {
     Settings::values.use_vsync = ui->use_vsync->isChecked();
     Settings::values.use_assembly_shaders = ui->use_assembly_shaders->isChecked();
     Settings::values.use_fast_gpu_time = ui->use_fast_gpu_time->isChecked();
+    Settings::values.use_fast_conditional_rendering =
+        ui->use_fast_conditional_rendering->isChecked();
     Settings::values.force_30fps_mode = ui->force_30fps_mode->isChecked();
     Settings::values.max_anisotropy = ui->anisotropic_filtering_combobox->currentIndex();
 }
@@ -0,0 +1,159 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <chrono>
+
+#include <QFileDialog>
+#include <QHBoxLayout>
+#include <QHeaderView>
+#include <QMessageBox>
+#include <QPushButton>
+#include <QTreeWidget>
+#include <QVBoxLayout>
+
+#include "common/file_util.h"
+#include "common/latency_histogram.h"
+#include "core/core.h"
+#include "core/hle_profiler.h"
+#include "yuzu/debugger/hle_profiler.h"
+
+namespace {
+enum Column {
+    COLUMN_NAME,
+    COLUMN_CALLS,
+    COLUMN_TOTAL,
+    COLUMN_MEAN,
+    COLUMN_P50,
+    COLUMN_P99,
+    COLUMN_MAX,
+    COLUMN_COUNT,
+};
+
+constexpr int UpdateIntervalMs = 1000;
+
+QString FormatMicroseconds(std::chrono::nanoseconds time) {
+    return QString::number(static_cast<double>(time.count()) / 1000.0, 'f', 1);
+}
+
+void FillItem(QTreeWidgetItem* item, const QString& name, const Common::LatencySnapshot& latency) {
+    item->setText(COLUMN_NAME, name);
+    item->setText(COLUMN_CALLS, QString::number(latency.count));
+    item->setText(COLUMN_TOTAL, FormatMicroseconds(latency.TotalTime()));
+    item->setText(COLUMN_MEAN, FormatMicroseconds(latency.MeanTime()));
+    item->setText(COLUMN_P50, FormatMicroseconds(latency.Percentile(50.0)));
+    item->setText(COLUMN_P99, FormatMicroseconds(latency.Percentile(99.0)));
+    item->setText(COLUMN_MAX, FormatMicroseconds(latency.MaxTime()));
+    for (int column = COLUMN_CALLS; column < COLUMN_COUNT; ++column) {
+        item->setTextAlignment(column, Qt::AlignRight);
+    }
+}
+} // Anonymous namespace
+
+HLEProfilerWidget::HLEProfilerWidget(QWidget* parent)
+    : QDockWidget(tr("HLE Profiler"), parent) {
+    setObjectName(QStringLiteral("HLEProfilerWidget"));
+
+    tree = new QTreeWidget;
+    tree->setColumnCount(COLUMN_COUNT);
+    tree->setHeaderLabels({tr("Name"), tr("Calls"), tr("Total (us)"), tr("Mean (us)"),
+                           tr("p50 (us)"), tr("p99 (us)"), tr("Max (us)")});
+    tree->header()->setSectionResizeMode(COLUMN_NAME, QHeaderView::Stretch);
+    tree->header()->setStretchLastSection(false);
+
+    svc_root = new QTreeWidgetItem(tree, {tr("SVCs")});
+    command_root = new QTreeWidgetItem(tree, {tr("Service commands")});
+    svc_root->setExpanded(true);
+    command_root->setExpanded(true);
+
+    auto* reset_button = new QPushButton(tr("Reset"));
+    auto* save_button = new QPushButton(tr("Save JSON..."));
+    connect(reset_button, &QPushButton::clicked, this, &HLEProfilerWidget::Reset);
+    connect(save_button, &QPushButton::clicked, this, &HLEProfilerWidget::SaveJson);
+
+    auto* button_layout = new QHBoxLayout;
+    button_layout->addStretch();
+    button_layout->addWidget(reset_button);
+    button_layout->addWidget(save_button);
+
+    auto* layout = new QVBoxLayout;
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->addWidget(tree);
+    layout->addLayout(button_layout);
+
+    auto* contents = new QWidget;
+    contents->setLayout(layout);
+    setWidget(contents);
+
+    connect(&update_timer, &QTimer::timeout, this, &HLEProfilerWidget::Refresh);
+}
+
+HLEProfilerWidget::~HLEProfilerWidget() = default;
+
+void HLEProfilerWidget::showEvent(QShowEvent* ev) {
+    Refresh();
+    update_timer.start(UpdateIntervalMs);
+    QDockWidget::showEvent(ev);
+}
+
+void HLEProfilerWidget::hideEvent(QHideEvent* ev) {
+    update_timer.stop();
+    QDockWidget::hideEvent(ev);
+}
+
+void HLEProfilerWidget::Refresh() {
+    const auto& profiler = Core::System::GetInstance().GetHLEProfiler();
+
+    // The profiles are already sorted by total time, so items are reused in place.
+    const auto svcs = profiler.GetSvcProfiles();
+    while (svc_root->childCount() > static_cast<int>(svcs.size())) {
+        delete svc_root->takeChild(svc_root->childCount() - 1);
+    }
+    for (std::size_t i = 0; i < svcs.size(); ++i) {
+        const int index = static_cast<int>(i);
+        auto* item = index < svc_root->childCount() ? svc_root->child(index)
+                                                    : new QTreeWidgetItem(svc_root);
+        const auto& svc = svcs[i];
+        FillItem(item,
+                 QStringLiteral("0x%1 %2")
+                     .arg(svc.number, 2, 16, QLatin1Char('0'))
+                     .arg(QString::fromStdString(svc.name)),
+                 svc.latency);
+    }
+
+    const auto commands = profiler.GetServiceCommandProfiles();
+    while (command_root->childCount() > static_cast<int>(commands.size())) {
+        delete command_root->takeChild(command_root->childCount() - 1);
+    }
+    for (std::size_t i = 0; i < commands.size(); ++i) {
+        const int index = static_cast<int>(i);
+        auto* item = index < command_root->childCount() ? command_root->child(index)
+                                                        : new QTreeWidgetItem(command_root);
+        const auto& command = commands[i];
+        FillItem(item,
+                 QStringLiteral("%1 [%2] %3")
+                     .arg(QString::fromStdString(command.service_name))
+                     .arg(command.command_id)
+                     .arg(QString::fromStdString(command.command_name)),
+                 command.latency);
+    }
+}
+
+void HLEProfilerWidget::Reset() {
+    Core::System::GetInstance().GetHLEProfiler().Reset();
+    Refresh();
+}
+
+void HLEProfilerWidget::SaveJson() {
+    const QString path = QFileDialog::getSaveFileName(this, tr("Save HLE Profile"), {},
+                                                      tr("JSON Files (*.json)"));
+    if (path.isEmpty()) {
+        return;
+    }
+
+    const std::string json = Core::System::GetInstance().GetHLEProfiler().DumpJson();
+    if (FileUtil::WriteStringToFile(true, path.toStdString(), json) != json.size()) {
+        QMessageBox::warning(this, tr("Save HLE Profile"),
+                             tr("Failed to write the profile to %1.").arg(path));
+    }
+}
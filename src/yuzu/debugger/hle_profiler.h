@@ -0,0 +1,39 @@
+// Copyright 2020 yuzu Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <QDockWidget>
+#include <QTimer>
+
+class QHideEvent;
+class QShowEvent;
+class QTreeWidget;
+class QTreeWidgetItem;
+
+/// Lists the call counts and host latencies of every SVC and HLE service command.
+class HLEProfilerWidget : public QDockWidget {
+    Q_OBJECT
+
+public:
+    explicit HLEProfilerWidget(QWidget* parent = nullptr);
+    ~HLEProfilerWidget() override;
+
+protected:
+    void showEvent(QShowEvent* ev) override;
+    void hideEvent(QHideEvent* ev) override;
+
+private:
+    void Refresh();
+    void Reset();
+    void SaveJson();
+
+    QTreeWidget* tree;
+    QTreeWidgetItem* svc_root;
+    QTreeWidgetItem* command_root;
+
+    /// Refreshes the lists periodically. To save resources, it only runs while the widget is
+    /// visible.
+    QTimer update_timer;
+};
@@ -2,11 +2,14 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <QDataStream>
+#include <QDateTime>
 #include <QDir>
 #include <QFile>
 #include <QFileInfo>
@@ -33,6 +36,14 @@
 
 namespace {
 
+constexpr quint32 FILE_CACHE_MAGIC = 0x4C434659; // "YFCL"
+constexpr quint32 FILE_CACHE_VERSION = 2;
+
+QString GetFileCachePath() {
+    return QString::fromStdString(FileUtil::GetUserPath(FileUtil::UserPath::CacheDir) +
+                                  "game_list" DIR_SEP "file_cache.bin");
+}
+
 QString GetGameListCachedObject(const std::string& filename, const std::string& ext,
                                 const std::function<QString()>& generator) {
     if (!UISettings::values.cache_game_list || filename == "0000000000000000") {
@@ -189,9 +200,9 @@ QString FormatPatchNameVersions(const FileSys::PatchManager& patch_manager,
 }
 
 QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::string& name,
-                                        const std::vector<u8>& icon, Loader::AppLoader& loader,
+                                        const std::vector<u8>& icon, Loader::FileType file_type,
                                         u64 program_id, const CompatibilityList& compatibility_list,
-                                        const FileSys::PatchManager& patch) {
+                                        const QString& patch_versions) {
     const auto it = FindMatchingCompatibilityEntry(compatibility_list, program_id);
 
     // The game list uses this as compatibility number for untested games
@@ -200,7 +211,6 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
         compatibility = it->second.first;
     }
 
-    const auto file_type = loader.GetFileType();
     const auto file_type_string = QString::fromStdString(Loader::GetFileTypeString(file_type));
 
     QList<QStandardItem*> list{
@@ -212,17 +222,59 @@ QList<QStandardItem*> MakeGameListEntry(const std::string& path, const std::stri
     };
 
     if (UISettings::values.show_add_ons) {
-        const auto patch_versions = GetGameListCachedObject(
-            fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &loader] {
-                return FormatPatchNameVersions(patch, loader, loader.IsRomFSUpdatable());
-            });
         list.insert(2, new GameListItem(patch_versions));
     }
 
     return list;
 }
+
+QString GetPatchVersions(const FileSys::PatchManager& patch, Loader::AppLoader& loader) {
+    if (!UISettings::values.show_add_ons) {
+        return {};
+    }
+
+    return GetGameListCachedObject(
+        fmt::format("{:016X}", patch.GetTitleID()), "pv.txt", [&patch, &loader] {
+            return FormatPatchNameVersions(patch, loader, loader.IsRomFSUpdatable());
+        });
+}
+
 } // Anonymous namespace
 
+QDataStream& operator<<(QDataStream& stream, const GameListContentEntry& entry) {
+    return stream << quint8{entry.title_type} << quint8{entry.record_type}
+                  << quint64{entry.title_id};
+}
+
+QDataStream& operator>>(QDataStream& stream, GameListContentEntry& entry) {
+    quint8 title_type{};
+    quint8 record_type{};
+    quint64 title_id{};
+    stream >> title_type >> record_type >> title_id;
+    entry.title_type = title_type;
+    entry.record_type = record_type;
+    entry.title_id = title_id;
+    return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const GameListFileCacheEntry& entry) {
+    return stream << entry.size << entry.last_modified << entry.has_metadata
+                  << quint64{entry.program_id} << quint32{entry.file_type} << entry.name
+                  << entry.icon << entry.has_add_ons << entry.add_ons << entry.has_contents
+                  << entry.contents;
+}
+
+QDataStream& operator>>(QDataStream& stream, GameListFileCacheEntry& entry) {
+    quint64 program_id{};
+    quint32 file_type{};
+    stream >> entry.size >> entry.last_modified >> entry.has_metadata >> program_id >>
+        file_type >> entry.name >> entry.icon >> entry.has_add_ons >> entry.add_ons >>
+        entry.has_contents >> entry.contents;
+    entry.program_id = program_id;
+    entry.file_type = file_type;
+    return stream;
+}
+
 GameListWorker::GameListWorker(FileSys::VirtualFilesystem vfs,
                                FileSys::ManualContentProvider* provider,
                                QVector<UISettings::GameDir>& game_dirs,
@@ -272,17 +324,19 @@ void GameListWorker::AddTitlesToGameList(GameListDir* parent_dir) {
         if (control != nullptr)
             GetMetadataFromControlNCA(patch, *control, icon, name);
 
-        emit EntryReady(MakeGameListEntry(file->GetFullPath(), name, icon, *loader, program_id,
-                                          compatibility_list, patch),
+        emit EntryReady(MakeGameListEntry(file->GetFullPath(), name, icon, loader->GetFileType(),
+                                          program_id, compatibility_list,
+                                          GetPatchVersions(patch, *loader)),
                         parent_dir);
     }
 }
 
 void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_path,
-                                    unsigned int recursion, GameListDir* parent_dir) {
-    const auto callback = [this, target, recursion,
-                           parent_dir](u64* num_entries_out, const std::string& directory,
-                                       const std::string& virtual_name) -> bool {
+                                    unsigned int recursion, GameListDir* parent_dir,
+                                    std::vector<std::string>& game_files) {
+    const auto callback = [this, target, recursion, parent_dir,
+                           &game_files](u64* num_entries_out, const std::string& directory,
+                                        const std::string& virtual_name) -> bool {
         if (stop_processing) {
             // Breaks the callback loop.
             return false;
@@ -292,64 +346,259 @@ void GameListWorker::ScanFileSystem(ScanTarget target, const std::string& dir_pa
         const bool is_dir = FileUtil::IsDirectory(physical_name);
         if (!is_dir &&
             (HasSupportedFileExtension(physical_name) || IsExtractedNCAMain(physical_name))) {
-            const auto file = vfs->OpenFile(physical_name, FileSys::Mode::Read);
-            auto loader = Loader::GetLoader(file);
-            if (!loader) {
-                return true;
+            if (target == ScanTarget::PopulateGameList) {
+                // Files are probed afterwards, see PopulateGameList.
+                game_files.push_back(physical_name);
+            } else {
+                FillManualContentProvider(physical_name);
             }
+        } else if (is_dir && recursion > 0) {
+            watch_list.append(QString::fromStdString(physical_name));
+            ScanFileSystem(target, physical_name, recursion - 1, parent_dir, game_files);
+        }
 
-            const auto file_type = loader->GetFileType();
-            if (file_type == Loader::FileType::Unknown || file_type == Loader::FileType::Error) {
-                return true;
-            }
+        return true;
+    };
 
-            u64 program_id = 0;
-            const auto res2 = loader->ReadProgramId(program_id);
-
-            if (target == ScanTarget::FillManualContentProvider) {
-                if (res2 == Loader::ResultStatus::Success && file_type == Loader::FileType::NCA) {
-                    provider->AddEntry(FileSys::TitleType::Application,
-                                       FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()),
-                                       program_id, file);
-                } else if (res2 == Loader::ResultStatus::Success &&
-                           (file_type == Loader::FileType::XCI ||
-                            file_type == Loader::FileType::NSP)) {
-                    const auto nsp = file_type == Loader::FileType::NSP
-                                         ? std::make_shared<FileSys::NSP>(file)
-                                         : FileSys::XCI{file}.GetSecurePartitionNSP();
-                    for (const auto& title : nsp->GetNCAs()) {
-                        for (const auto& entry : title.second) {
-                            provider->AddEntry(entry.first.first, entry.first.second, title.first,
-                                               entry.second->GetBaseFile());
-                        }
-                    }
-                }
-            } else {
-                std::vector<u8> icon;
-                [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
+    FileUtil::ForeachDirectoryEntry(nullptr, dir_path, callback);
+}
 
-                std::string name = " ";
-                [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
+void GameListWorker::FillManualContentProvider(const std::string& path) {
+    const QString qpath = QString::fromStdString(path);
+    GameListFileCacheEntry& cache_entry = GetFileCacheEntry(qpath, QFileInfo{qpath});
 
-                const FileSys::PatchManager patch{program_id};
+    // The provider keeps its entries between scans, unchanged files don't have to be parsed again.
+    const auto to_key = [](const GameListContentEntry& content) {
+        return ContentKey{static_cast<FileSys::TitleType>(content.title_type),
+                          static_cast<FileSys::ContentRecordType>(content.record_type),
+                          content.title_id};
+    };
+    if (cache_entry.has_contents &&
+        std::all_of(cache_entry.contents.cbegin(), cache_entry.contents.cend(),
+                    [this](const GameListContentEntry& content) {
+                        return provider->HasEntry(
+                            content.title_id,
+                            static_cast<FileSys::ContentRecordType>(content.record_type));
+                    })) {
+        for (const auto& content : cache_entry.contents) {
+            current_contents.insert(to_key(content));
+        }
+        return;
+    }
+
+    cache_entry.has_contents = true;
+    cache_entry.contents.clear();
+    file_cache_dirty = true;
+
+    const auto add_entry = [&](FileSys::TitleType title_type,
+                               FileSys::ContentRecordType record_type, u64 title_id,
+                               FileSys::VirtualFile file) {
+        provider->AddEntry(title_type, record_type, title_id, std::move(file));
+        const GameListContentEntry content{static_cast<u8>(title_type),
+                                           static_cast<u8>(record_type), title_id};
+        cache_entry.contents.push_back(content);
+        current_contents.insert(to_key(content));
+    };
 
-                emit EntryReady(MakeGameListEntry(physical_name, name, icon, *loader, program_id,
-                                                  compatibility_list, patch),
-                                parent_dir);
+    const auto file = vfs->OpenFile(path, FileSys::Mode::Read);
+    auto loader = Loader::GetLoader(file);
+    if (!loader) {
+        return;
+    }
+
+    const auto file_type = loader->GetFileType();
+    if (file_type == Loader::FileType::Unknown || file_type == Loader::FileType::Error) {
+        return;
+    }
+
+    u64 program_id = 0;
+    const auto res2 = loader->ReadProgramId(program_id);
+
+    if (res2 == Loader::ResultStatus::Success && file_type == Loader::FileType::NCA) {
+        add_entry(FileSys::TitleType::Application,
+                  FileSys::GetCRTypeFromNCAType(FileSys::NCA{file}.GetType()), program_id, file);
+    } else if (res2 == Loader::ResultStatus::Success &&
+               (file_type == Loader::FileType::XCI || file_type == Loader::FileType::NSP)) {
+        const auto nsp = file_type == Loader::FileType::NSP
+                             ? std::make_shared<FileSys::NSP>(file)
+                             : FileSys::XCI{file}.GetSecurePartitionNSP();
+        for (const auto& title : nsp->GetNCAs()) {
+            for (const auto& entry : title.second) {
+                add_entry(entry.first.first, entry.first.second, title.first,
+                          entry.second->GetBaseFile());
             }
-        } else if (is_dir && recursion > 0) {
-            watch_list.append(QString::fromStdString(physical_name));
-            ScanFileSystem(target, physical_name, recursion - 1, parent_dir);
         }
+    }
+}
 
-        return true;
+GameListFileCacheEntry& GameListWorker::GetFileCacheEntry(const QString& path,
+                                                          const QFileInfo& info) {
+    visited_files.insert(path);
+
+    GameListFileCacheEntry& entry = file_cache[path];
+    const qint64 last_modified = info.lastModified().toMSecsSinceEpoch();
+    if (entry.size != info.size() || entry.last_modified != last_modified) {
+        entry = GameListFileCacheEntry{};
+        entry.size = info.size();
+        entry.last_modified = last_modified;
+        file_cache_dirty = true;
+    }
+    return entry;
+}
+
+void GameListWorker::RemoveStaleContents() {
+    // Files can add the same entry, it is only removed once no file adds it anymore.
+    for (const auto& key : previous_contents) {
+        if (current_contents.count(key) == 0) {
+            provider->RemoveEntry(std::get<0>(key), std::get<1>(key), std::get<2>(key));
+        }
+    }
+}
+
+void GameListWorker::PopulateGameList(const std::vector<std::string>& game_files,
+                                      GameListDir* parent_dir) {
+    const auto emit_entry = [this, parent_dir](const std::string& path,
+                                               const GameListFileCacheEntry& entry) {
+        const std::vector<u8> icon(entry.icon.cbegin(), entry.icon.cend());
+        emit EntryReady(MakeGameListEntry(path, entry.name.toStdString(), icon,
+                                          static_cast<Loader::FileType>(entry.file_type),
+                                          entry.program_id, compatibility_list, entry.add_ons),
+                        parent_dir);
     };
 
-    FileUtil::ForeachDirectoryEntry(nullptr, dir_path, callback);
+    for (const auto& path : game_files) {
+        if (stop_processing) {
+            return;
+        }
+
+        const QString qpath = QString::fromStdString(path);
+        GameListFileCacheEntry& entry = GetFileCacheEntry(qpath, QFileInfo{qpath});
+
+        // Files that have not changed since the last scan don't have to be parsed again.
+        if (entry.has_metadata && (entry.has_add_ons || !UISettings::values.show_add_ons)) {
+            if (entry.file_type != static_cast<u32>(Loader::FileType::Error)) {
+                emit_entry(path, entry);
+            }
+            continue;
+        }
+
+        // Files that turn out not to be games are remembered as such until they change.
+        entry.has_metadata = true;
+        entry.file_type = static_cast<u32>(Loader::FileType::Error);
+        entry.has_add_ons = true;
+        file_cache_dirty = true;
+
+        // Loaders of packed titles look up their patches through the global content providers
+        // while they are constructed, so files are probed on this thread only.
+        const auto file = vfs->OpenFile(path, FileSys::Mode::Read);
+        const auto loader = Loader::GetLoader(file);
+        if (!loader) {
+            continue;
+        }
+
+        const auto file_type = loader->GetFileType();
+        if (file_type == Loader::FileType::Unknown || file_type == Loader::FileType::Error) {
+            continue;
+        }
+
+        u64 program_id = 0;
+        std::vector<u8> icon;
+        std::string name = " ";
+        loader->ReadProgramId(program_id);
+        [[maybe_unused]] const auto res1 = loader->ReadIcon(icon);
+        [[maybe_unused]] const auto res3 = loader->ReadTitle(name);
+
+        const FileSys::PatchManager patch{program_id};
+
+        entry.program_id = program_id;
+        entry.file_type = static_cast<u32>(file_type);
+        entry.name = QString::fromStdString(name);
+        entry.icon =
+            QByteArray(reinterpret_cast<const char*>(icon.data()), static_cast<int>(icon.size()));
+        entry.has_add_ons = UISettings::values.show_add_ons;
+        entry.add_ons = GetPatchVersions(patch, *loader);
+
+        emit_entry(path, entry);
+    }
+}
+
+bool GameListWorker::LoadFileCache() {
+    file_cache.clear();
+    visited_files.clear();
+    file_cache_dirty = false;
+    previous_contents.clear();
+    current_contents.clear();
+
+    if (!UISettings::values.cache_game_list) {
+        return false;
+    }
+
+    QFile file{GetFileCachePath()};
+    if (!file.open(QFile::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream stream{&file};
+    quint32 magic{};
+    quint32 version{};
+    stream >> magic >> version;
+    if (magic != FILE_CACHE_MAGIC || version != FILE_CACHE_VERSION) {
+        return false;
+    }
+
+    stream >> file_cache;
+    if (stream.status() != QDataStream::Ok) {
+        LOG_WARNING(Frontend, "Game list file cache is corrupted, discarding it.");
+        file_cache.clear();
+        return false;
+    }
+
+    for (const auto& entry : file_cache) {
+        for (const auto& content : entry.contents) {
+            previous_contents.emplace(static_cast<FileSys::TitleType>(content.title_type),
+                                      static_cast<FileSys::ContentRecordType>(content.record_type),
+                                      content.title_id);
+        }
+    }
+    return true;
+}
+
+void GameListWorker::SaveFileCache() const {
+    if (!UISettings::values.cache_game_list) {
+        return;
+    }
+
+    // Drop files that were not encountered anymore.
+    QHash<QString, GameListFileCacheEntry> new_cache;
+    for (auto it = file_cache.cbegin(); it != file_cache.cend(); ++it) {
+        if (visited_files.contains(it.key())) {
+            new_cache.insert(it.key(), it.value());
+        }
+    }
+
+    if (!file_cache_dirty && new_cache.size() == file_cache.size()) {
+        return;
+    }
+
+    const auto path = GetFileCachePath();
+    FileUtil::CreateFullPath(path.toStdString());
+
+    QFile file{path};
+    if (!file.open(QFile::WriteOnly)) {
+        LOG_ERROR(Frontend, "Failed to open game list file cache for writing.");
+        return;
+    }
+
+    QDataStream stream{&file};
+    stream << FILE_CACHE_MAGIC << FILE_CACHE_VERSION << new_cache;
 }
 
 void GameListWorker::run() {
     stop_processing = false;
+    if (!LoadFileCache()) {
+        // Without the file cache there is no telling which file added which provider entry.
+        provider->ClearAllEntries();
+    }
 
     for (UISettings::GameDir& game_dir : game_dirs) {
         if (game_dir.path == QStringLiteral("SDMC")) {
@@ -368,14 +617,20 @@ void GameListWorker::run() {
             watch_list.append(game_dir.path);
             auto* const game_list_dir = new GameListDir(game_dir);
             emit DirEntryReady(game_list_dir);
-            provider->ClearAllEntries();
+            std::vector<std::string> game_files;
             ScanFileSystem(ScanTarget::FillManualContentProvider, game_dir.path.toStdString(), 2,
-                           game_list_dir);
+                           game_list_dir, game_files);
             ScanFileSystem(ScanTarget::PopulateGameList, game_dir.path.toStdString(),
-                           game_dir.deep_scan ? 256 : 0, game_list_dir);
+                           game_dir.deep_scan ? 256 : 0, game_list_dir, game_files);
+            PopulateGameList(game_files, game_list_dir);
         }
     };
 
+    if (!stop_processing) {
+        RemoveStaleContents();
+        SaveFileCache();
+    }
+
     emit Finished(watch_list);
 }
 
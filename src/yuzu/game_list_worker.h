@@ -7,25 +7,67 @@
 #include <atomic>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <tuple>
 #include <unordered_map>
+#include <vector>
 
+#include <QByteArray>
+#include <QHash>
 #include <QList>
 #include <QObject>
 #include <QRunnable>
+#include <QSet>
 #include <QString>
 #include <QVector>
 
 #include "common/common_types.h"
 #include "yuzu/compatibility_list.h"
 
+class QDataStream;
+class QFileInfo;
 class QStandardItem;
 
 namespace FileSys {
 class NCA;
 class VfsFilesystem;
+enum class ContentRecordType : u8;
+enum class TitleType : u8;
 } // namespace FileSys
 
+/// Entry a game file added to the manual content provider.
+struct GameListContentEntry {
+    u8 title_type = 0;
+    u8 record_type = 0;
+    u64 title_id = 0;
+};
+
+/// Metadata of a game file, cached so that unchanged files do not have to be reopened.
+struct GameListFileCacheEntry {
+    qint64 size = 0;
+    qint64 last_modified = 0;
+
+    /// Whether the game list metadata below has been read from the file.
+    bool has_metadata = false;
+    u64 program_id = 0;
+    u32 file_type = 0;
+    QString name;
+    QByteArray icon;
+    bool has_add_ons = false;
+    QString add_ons;
+
+    /// Whether the file has been scanned for content provider entries.
+    bool has_contents = false;
+    QVector<GameListContentEntry> contents;
+};
+
+QDataStream& operator<<(QDataStream& stream, const GameListContentEntry& entry);
+QDataStream& operator>>(QDataStream& stream, GameListContentEntry& entry);
+
+QDataStream& operator<<(QDataStream& stream, const GameListFileCacheEntry& entry);
+QDataStream& operator>>(QDataStream& stream, GameListFileCacheEntry& entry);
+
 /**
  * Asynchronous worker object for populating the game list.
  * Communicates with other threads through Qt's signal/slot system.
@@ -71,7 +113,24 @@ private:
     };
 
     void ScanFileSystem(ScanTarget target, const std::string& dir_path, unsigned int recursion,
-                        GameListDir* parent_dir);
+                        GameListDir* parent_dir, std::vector<std::string>& game_files);
+
+    /// Adds the contents of the given game file to the manual content provider, unless the file
+    /// cache shows they are there already.
+    void FillManualContentProvider(const std::string& path);
+
+    /// Returns the file cache entry of the given file, emptied if the file changed since.
+    GameListFileCacheEntry& GetFileCacheEntry(const QString& path, const QFileInfo& info);
+
+    /// Removes the content provider entries of files that changed or are gone.
+    void RemoveStaleContents();
+
+    /// Emits entries for the given game files, probing the ones missing from the file cache.
+    void PopulateGameList(const std::vector<std::string>& game_files, GameListDir* parent_dir);
+
+    /// Loads the file cache from disk, returns false if there was no usable one.
+    bool LoadFileCache();
+    void SaveFileCache() const;
 
     std::shared_ptr<FileSys::VfsFilesystem> vfs;
     FileSys::ManualContentProvider* provider;
@@ -80,4 +139,14 @@ private:
 
     QStringList watch_list;
     std::atomic_bool stop_processing;
+
+    QHash<QString, GameListFileCacheEntry> file_cache;
+    QSet<QString> visited_files;
+    bool file_cache_dirty = false;
+
+    using ContentKey = std::tuple<FileSys::TitleType, FileSys::ContentRecordType, u64>;
+    /// Content provider entries of the files in the file cache when it was loaded.
+    std::set<ContentKey> previous_contents;
+    /// Content provider entries of the files found by this scan.
+    std::set<ContentKey> current_contents;
 };
@@ -100,6 +100,7 @@ static FileSys::VirtualFile VfsDirectoryCreateFileWrapper(const FileSys::Virtual
 #include "yuzu/configuration/config.h"
 #include "yuzu/configuration/configure_dialog.h"
 #include "yuzu/debugger/console.h"
+#include "yuzu/debugger/hle_profiler.h"
 #include "yuzu/debugger/profiler.h"
 #include "yuzu/debugger/wait_tree.h"
 #include "yuzu/discord.h"
@@ -583,6 +584,11 @@ void GMainWindow::InitializeDebugWidgets() {
             &WaitTreeWidget::OnEmulationStarting);
     connect(this, &GMainWindow::EmulationStopping, waitTreeWidget,
             &WaitTreeWidget::OnEmulationStopping);
+
+    hleProfilerWidget = new HLEProfilerWidget(this);
+    addDockWidget(Qt::LeftDockWidgetArea, hleProfilerWidget);
+    hleProfilerWidget->hide();
+    debug_menu->addAction(hleProfilerWidget->toggleViewAction());
 }
 
 void GMainWindow::InitializeRecentFileMenuActions() {
@@ -1610,19 +1616,41 @@ void GMainWindow::OnMenuInstallToNAND() {
             failed();
             return;
         }
-        const auto res = Core::System::GetInstance()
-                             .GetFileSystemController()
-                             .GetUserNANDContents()
-                             ->InstallEntry(*nsp, false, qt_raw_copy);
+
+        const auto install_nsp = [this, &nsp, &filename](bool overwrite_if_exists) {
+            constexpr int progress_maximum = 1000;
+            const QString file_name = QFileInfo(filename).fileName();
+            QProgressDialog progress(tr("Installing file \"%1\"...").arg(file_name),
+                                     tr("Cancel"), 0, progress_maximum, this);
+            progress.setWindowModality(Qt::WindowModal);
+
+            FileSys::InstallOptions options;
+            options.overwrite_if_exists = overwrite_if_exists;
+            options.progress = [this, &progress,
+                                &file_name](const FileSys::InstallProgress& status) {
+                if (status.total_bytes != 0) {
+                    progress.setValue(static_cast<int>(status.bytes_installed * progress_maximum /
+                                                       status.total_bytes));
+                }
+                progress.setLabelText(tr("Installing file \"%1\"... (%2 MB/s)")
+                                          .arg(file_name)
+                                          .arg(status.bytes_per_second / 0x100000, 0, 'f', 1));
+                return !progress.wasCanceled();
+            };
+
+            return Core::System::GetInstance()
+                .GetFileSystemController()
+                .GetUserNANDContents()
+                ->InstallEntry(*nsp, options);
+        };
+
+        const auto res = install_nsp(false);
         if (res == FileSys::InstallResult::Success) {
             success();
         } else {
             if (res == FileSys::InstallResult::ErrorAlreadyExists) {
                 if (overwrite()) {
-                    const auto res2 = Core::System::GetInstance()
-                                          .GetFileSystemController()
-                                          .GetUserNANDContents()
-                                          ->InstallEntry(*nsp, true, qt_raw_copy);
+                    const auto res2 = install_nsp(true);
                     if (res2 == FileSys::InstallResult::Success) {
                         success();
                     } else {
@@ -23,6 +23,7 @@ class EmuThread;
 class GameList;
 class GImageInfo;
 class GRenderWindow;
+class HLEProfilerWidget;
 class LoadingScreen;
 class MicroProfileDialog;
 class ProfilerWidget;
@@ -257,6 +258,7 @@ private:
     ProfilerWidget* profilerWidget;
     MicroProfileDialog* microProfileDialog;
     WaitTreeWidget* waitTreeWidget;
+    HLEProfilerWidget* hleProfilerWidget;
 
     QAction* actions_recent_files[max_recent_files_item];
 
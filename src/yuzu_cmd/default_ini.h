@@ -93,7 +93,8 @@ udp_input_port=
 udp_pad_index=
 
 [Core]
-# Whether to use multi-core for CPU emulation
+# Whether to use multi-core for CPU emulation, running each emulated core on its own host thread.
+# Requires asynchronous GPU emulation and is disabled while the GDB stub is in use.
 # 0 (default): Disabled, 1: Enabled
 use_multi_core=
 
@@ -138,6 +139,14 @@ use_vsync =
 # 0 (default): Off, 1: On
 use_assembly_shaders =
 
+# Whether conditional rendering uses the last known query results instead of waiting for the GPU.
+# 0 (default): Off, 1: On
+use_fast_conditional_rendering =
+
+# Number of threads used for parallel video work, like decoding ASTC textures.
+# 0 (default): Use the host threads left over by the emulated CPU and the GPU thread
+video_worker_threads =
+
 # Turns on the frame limiter, which will limit frames output to the target game speed
 # 0: Off, 1: On (default)
 use_frame_limit =
@@ -3,9 +3,11 @@
 // Refer to the license.txt file included.
 
 #include <SDL.h>
+#include "common/file_util.h"
 #include "common/logging/log.h"
 #include "common/scm_rev.h"
 #include "core/core.h"
+#include "core/hle_profiler.h"
 #include "core/perf_stats.h"
 #include "input_common/keyboard.h"
 #include "input_common/main.h"
@@ -78,6 +80,13 @@ void EmuWindow_SDL2::OnFingerUp() {
 }
 
 void EmuWindow_SDL2::OnKeyEvent(int key, u8 state) {
+    if (key == SDL_SCANCODE_F9 && !hle_profile_path.empty()) {
+        if (state == SDL_PRESSED) {
+            SaveHLEProfile();
+        }
+        return;
+    }
+
     if (state == SDL_PRESSED) {
         InputCommon::GetKeyboard()->PressKey(key);
     } else if (state == SDL_RELEASED) {
@@ -85,6 +94,23 @@ void EmuWindow_SDL2::OnKeyEvent(int key, u8 state) {
     }
 }
 
+void EmuWindow_SDL2::SetHLEProfilePath(std::string path) {
+    hle_profile_path = std::move(path);
+}
+
+void EmuWindow_SDL2::SaveHLEProfile() const {
+    if (hle_profile_path.empty()) {
+        return;
+    }
+
+    const std::string json = system.GetHLEProfiler().DumpJson();
+    if (FileUtil::WriteStringToFile(true, hle_profile_path, json) != json.size()) {
+        LOG_ERROR(Frontend, "Failed to write the HLE profile to {}", hle_profile_path);
+        return;
+    }
+    LOG_INFO(Frontend, "Wrote the HLE profile to {}", hle_profile_path);
+}
+
 bool EmuWindow_SDL2::IsOpen() const {
     return is_open;
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <string>
 #include <utility>
 #include "core/frontend/emu_window.h"
 
@@ -31,6 +32,12 @@ public:
     /// Presents the next frame
     virtual void Present() = 0;
 
+    /// Sets the file the SVC and service command profile is written to when F9 is pressed
+    void SetHLEProfilePath(std::string path);
+
+    /// Writes the SVC and service command profile to the configured file, if there is one
+    void SaveHLEProfile() const;
+
 protected:
     /// Called by PollEvents when a key is pressed or released.
     void OnKeyEvent(int key, u8 state);
@@ -76,4 +83,7 @@ protected:
 
     /// Keeps track of how often to update the title bar during gameplay
     u32 last_time = 0;
+
+    /// File the HLE profile is dumped to, empty if dumping is disabled
+    std::string hle_profile_path;
 };
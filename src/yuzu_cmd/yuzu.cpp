@@ -67,7 +67,9 @@ static void PrintHelp(const char* argv0) {
                  "-f, --fullscreen      Start in fullscreen mode\n"
                  "-h, --help            Display this help and exit\n"
                  "-v, --version         Output version information and exit\n"
-                 "-p, --program         Pass following string as arguments to executable\n";
+                 "-p, --program         Pass following string as arguments to executable\n"
+                 "-P, --hle-profile=FILE  Write SVC and service command latencies to FILE as\n"
+                 "                        JSON when F9 is pressed and on exit\n";
 }
 
 static void PrintVersion() {
@@ -113,15 +115,17 @@ int main(int argc, char** argv) {
     std::string filepath;
 
     bool fullscreen = false;
+    std::string hle_profile_path;
 
     static struct option long_options[] = {
         {"gdbport", required_argument, 0, 'g'}, {"fullscreen", no_argument, 0, 'f'},
         {"help", no_argument, 0, 'h'},          {"version", no_argument, 0, 'v'},
-        {"program", optional_argument, 0, 'p'}, {0, 0, 0, 0},
+        {"program", optional_argument, 0, 'p'}, {"hle-profile", required_argument, 0, 'P'},
+        {0, 0, 0, 0},
     };
 
     while (optind < argc) {
-        int arg = getopt_long(argc, argv, "g:fhvp::", long_options, &option_index);
+        int arg = getopt_long(argc, argv, "g:fhvp::P:", long_options, &option_index);
         if (arg != -1) {
             switch (static_cast<char>(arg)) {
             case 'g':
@@ -149,6 +153,9 @@ int main(int argc, char** argv) {
                 Settings::values.program_args = argv[optind];
                 ++optind;
                 break;
+            case 'P':
+                hle_profile_path = optarg;
+                break;
             }
         } else {
 #ifdef _WIN32
@@ -194,6 +201,8 @@ int main(int argc, char** argv) {
 #endif
     }
 
+    emu_window->SetHLEProfilePath(hle_profile_path);
+
     system.SetContentProvider(std::make_unique<FileSys::ContentProviderUnion>());
     system.SetFilesystem(std::make_shared<FileSys::RealVfsFilesystem>());
     system.GetFileSystemController().CreateFactories(*system.GetFilesystem());
@@ -241,6 +250,7 @@ int main(int argc, char** argv) {
     }
     render_thread.join();
 
+    emu_window->SaveHLEProfile();
     system.Shutdown();
 
     detached_tasks.WaitForAllTasks();
@@ -132,6 +132,10 @@ void Config::ReadValues() {
         sdl2_config->GetBoolean("Renderer", "use_asynchronous_gpu_emulation", false);
     Settings::values.use_fast_gpu_time =
         sdl2_config->GetBoolean("Renderer", "use_fast_gpu_time", true);
+    Settings::values.use_fast_conditional_rendering =
+        sdl2_config->GetBoolean("Renderer", "use_fast_conditional_rendering", false);
+    Settings::values.video_worker_threads =
+        static_cast<u16>(sdl2_config->GetInteger("Renderer", "video_worker_threads", 0));
 
     Settings::values.bg_red = static_cast<float>(sdl2_config->GetReal("Renderer", "bg_red", 0.0));
     Settings::values.bg_green =